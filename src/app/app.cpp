@@ -21,37 +21,60 @@
 
 #include "app/app.h"
 
+#include "app/artifact_cache.h"
+
 #include "automata/ta.h"
 #include "automata/ta.pb.h"
+#include "automata/ta_minimization.h"
 #include "automata/ta_product.h"
 #include "automata/ta_proto.h"
 #include "automata/ta_regions.h"
+#include "automata/ta_slicing.h"
+#include "controller_synthesis/cpp_export.h"
+#include "controller_synthesis/decision_table.h"
 #include "mtl/MTLFormula.h"
 #include "mtl/mtl.pb.h"
 #include "mtl/mtl_proto.h"
+#include "mtl_ata_translation/monitor.h"
 #include "mtl_ata_translation/translator.h"
+#include "search/constant_normalization.h"
+#include "search/controller_stream.h"
 #include "search/create_controller.h"
+#include "search/digital_search.h"
 #include "search/heuristics.h"
+#include "search/monitor_search.h"
+#include "search/partition_analysis.h"
 #include "search/search.h"
 #include "search/search_tree.h"
+#include "search/tree_export.h"
+#include "search/verify_controller.h"
+#include "visualization/dot_writer.h"
 #include "visualization/ta_to_graphviz.h"
 #include "visualization/tree_to_graphviz.h"
 
+#include <google/protobuf/arena.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <google/protobuf/text_format.h>
 #include <spdlog/common.h>
 #include <spdlog/logger.h>
 #include <spdlog/spdlog.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include <boost/program_options.hpp>
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/parsers.hpp>
 #include <boost/program_options/value_semantic.hpp>
 #include <boost/program_options/variables_map.hpp>
+#include <chrono>
 #include <fcntl.h>
 #include <fstream>
 #include <iterator>
+#include <limits>
+#include <optional>
+#include <sstream>
 #include <stdexcept>
 #include <vector>
 
@@ -74,9 +97,81 @@ create_heuristic(const std::string &name)
 	throw std::invalid_argument("Unknown heuristic: " + name);
 }
 
+/** Split a comma-separated list of actions into a set of actions. */
+std::set<std::string>
+parse_action_list(const std::string &list)
+{
+	std::set<std::string> res;
+	std::size_t           start = 0;
+	while (start <= list.size()) {
+		const auto end    = std::min(list.find(',', start), list.size());
+		const auto action = list.substr(start, end - start);
+		if (!action.empty()) {
+			res.insert(action);
+		}
+		start = end + 1;
+	}
+	return res;
+}
+
+/** Build the search tree once and check which controller action sets are controllable.
+ * @param plant The plant to be controlled
+ * @param ata The specification of undesired behaviors
+ * @param K The maximal constant occurring in a clock constraint
+ * @param controllable_partitions The controller actions of each partition to check
+ * @param required_actions If set, search for a minimal controller action set including these
+ * @param heuristic The heuristic to use during tree expansion
+ * @param multi_threaded If true, build and label the tree multi-threaded
+ */
+void
+analyze_partitions(
+  const automata::ta::TimedAutomaton<std::vector<std::string>, std::string> &plant,
+  automata::ata::AlternatingTimedAutomaton<logic::MTLFormula<std::string>,
+                                           logic::AtomicProposition<std::string>> *ata,
+  search::RegionIndex                                                             K,
+  const std::vector<std::set<std::string>> &  controllable_partitions,
+  const std::optional<std::set<std::string>> &required_actions,
+  const std::string &                         heuristic,
+  bool                                        multi_threaded)
+{
+	// Without incremental labeling, the tree does not depend on the controller actions.
+	search::TreeSearch<std::vector<std::string>, std::string> search{&plant,
+	                                                                 ata,
+	                                                                 {},
+	                                                                 plant.get_alphabet(),
+	                                                                 K,
+	                                                                 false,
+	                                                                 false,
+	                                                                 create_heuristic(heuristic)};
+	SPDLOG_INFO("Building the search tree for all partitions {}",
+	            multi_threaded ? "multi-threaded" : "single-threaded");
+	search.build_tree(multi_threaded);
+	SPDLOG_INFO("Search tree with {} nodes complete", search.get_size());
+	const auto &actions      = plant.get_alphabet();
+	const auto  controllable = search::get_controllable_partitions(*search.get_root(),
+	                                                               actions,
+	                                                               controllable_partitions,
+	                                                               multi_threaded);
+	for (std::size_t i = 0; i < controllable_partitions.size(); ++i) {
+		SPDLOG_INFO("Controller actions {{{}}}: {}",
+		            fmt::join(controllable_partitions[i], ", "),
+		            controllable[i] ? "controllable" : "not controllable");
+	}
+	if (required_actions) {
+		const auto minimal =
+		  search::find_minimal_controller_actions(*search.get_root(), actions, *required_actions);
+		if (minimal) {
+			SPDLOG_INFO("Minimal controller actions: {{{}}}", fmt::join(*minimal, ", "));
+		} else {
+			SPDLOG_INFO("The plant is not controllable, even if the controller controls all actions");
+		}
+	}
+}
+
 } // namespace
 
-Launcher::Launcher(int argc, const char *const argv[])
+Launcher::Launcher(int argc, const char *const argv[], MemoryCache *memory_cache)
+: memory_cache(memory_cache)
 {
 	GOOGLE_PROTOBUF_VERIFY_VERSION;
 	spdlog::set_pattern("%v");
@@ -94,17 +189,56 @@ Launcher::parse_command_line(int argc, const char *const argv[])
 	// clang-format off
 	options.add_options()
     ("help,h", "Print help message")
+    ("server", bool_switch()->default_value(false),
+     "Serve requests read line by line from stdin, each with the arguments of one run")
     ("plant,p", value(&plant_path)->required(), "The path to the plant proto")
     ("specification,s", value(&specification_path)->required(), "The path to the specification proto")
     ("controller-action,c", value<std::vector<std::string>>(), "The actions controlled by the controller")
     ("single-threaded", bool_switch()->default_value(false), "run single-threaded")
     ("visualize-plant", value(&plant_dot_graph), "Generate a dot graph of the input plant")
     ("visualize-search-tree", value(&tree_dot_graph), "Generate a dot graph of the search tree")
+    ("export-tree", value(&tree_export_path),
+     "Stream the search tree in a compact binary format to the given file")
     ("visualize-controller", value(&controller_dot_path), "Generate a dot graph of the resulting controller")
+    ("dot-max-depth", value(&dot_max_depth)->default_value(0),
+     "Collapse search tree nodes below this depth in .dot visualizations (0 for unlimited)")
+    ("dot-max-children", value(&dot_max_children)->default_value(0),
+     "Only show a sample of this many children per search tree node in .dot visualizations")
+    ("dot-max-label-length", value(&dot_max_label_length)->default_value(0),
+     "Truncate labels in .dot visualizations to this many characters (0 for unlimited)")
     ("hide-controller-labels", bool_switch()->default_value(false),
      "Generate a compact controller dot graph without node labels")
-    ("output,o", value(&controller_proto_path), "Save the resulting controller as pbtxt")
+    ("output,o", value(&controller_proto_path), "Save the resulting controller as proto")
+    ("proto-format", value<std::string>()->default_value("auto"),
+     "The format of all proto files (one of 'auto', 'text', 'binary'), 'auto' uses the extension")
+    ("controller-locations", value(&controller_locations_path),
+     "Save the canonical words of each controller location to the given file")
     ("heuristic", value(&heuristic)->default_value("time"), "The heuristic to use (one of 'time', 'bfs', 'dfs')")
+    ("monitor", bool_switch()->default_value(false),
+     "Use a deterministic monitor instead of the ATA if the specification allows it")
+    ("stream-controller", bool_switch()->default_value(false),
+     "Create the controller during the search and free the emitted parts of the search tree")
+    ("digital-clocks", bool_switch()->default_value(false),
+     "Use integer clock values if all constraints of the plant and the specification are closed")
+    ("verify", bool_switch()->default_value(false),
+     "Verify the controller in closed loop with the plant and the specification")
+    ("minimize-controller", bool_switch()->default_value(false),
+     "Merge bisimilar controller locations and adjacent guards")
+    ("minimize-plant", bool_switch()->default_value(false),
+     "Remove unreachable locations and merge bisimilar locations of each plant component")
+    ("slice-plant", bool_switch()->default_value(false),
+     "Remove plant components, clocks, and actions that cannot influence the plant's behavior")
+    ("normalize-constants", bool_switch()->default_value(false),
+     "Rescale all constants of the plant and the specification to the smallest equivalent integers")
+    ("cache-dir", value(&cache_dir),
+     "Cache the plant product and the translated specification in the given directory")
+    ("controllable-partition", value<std::vector<std::string>>(),
+     "Only check if the controller wins with the given comma-separated actions, may be repeated")
+    ("find-minimal-controller-actions", bool_switch()->default_value(false),
+     "Only search for a minimal set of controller actions that includes the actions given with -c")
+    ("output-cpp", value(&controller_cpp_path), "Save the resulting controller as C++ header")
+    ("ticks-per-time-unit", value(&ticks_per_time_unit)->default_value(2),
+     "The clock resolution of the generated C++ controller")
     ;
 	// clang-format on
 
@@ -112,61 +246,446 @@ Launcher::parse_command_line(int argc, const char *const argv[])
 	boost::program_options::store(boost::program_options::parse_command_line(argc, argv, options),
 	                              variables);
 	if (variables.count("help")) {
-		SPDLOG_INFO(options);
-		show_help = true;
+		std::stringstream help_stream;
+		help_stream << options;
+		help = help_stream.str();
+		return;
+	}
+	serve_requests = variables["server"].as<bool>();
+	if (serve_requests) {
+		// The server reads the plant and the specification from each request.
 		return;
 	}
 	boost::program_options::notify(variables);
 	multi_threaded         = !variables["single-threaded"].as<bool>();
 	hide_controller_labels = variables["hide-controller-labels"].as<bool>();
+	use_monitor            = variables["monitor"].as<bool>();
+	minimize_controller    = variables["minimize-controller"].as<bool>();
+	minimize_plant         = variables["minimize-plant"].as<bool>();
+	slice_plant            = variables["slice-plant"].as<bool>();
+	normalize_constants    = variables["normalize-constants"].as<bool>();
+	stream_controller      = variables["stream-controller"].as<bool>();
+	verify                 = variables["verify"].as<bool>();
+	digital_clocks         = variables["digital-clocks"].as<bool>();
+	if (stream_controller && !tree_export_path.empty()) {
+		// The export identifies nodes by their address, which is not stable if nodes are freed.
+		throw std::invalid_argument("Cannot export the search tree with --stream-controller");
+	}
 	// Convert the vector of actions into a set of actions.
 	if (variables.count("controller-action")) {
 		std::copy(std::begin(variables["controller-action"].as<std::vector<std::string>>()),
 		          std::end(variables["controller-action"].as<std::vector<std::string>>()),
 		          std::inserter(controller_actions, std::end(controller_actions)));
 	}
+	find_minimal_controller_actions = variables["find-minimal-controller-actions"].as<bool>();
+	const auto &format              = variables["proto-format"].as<std::string>();
+	if (format == "auto") {
+		proto_format = ProtoFormat::AUTO;
+	} else if (format == "text") {
+		proto_format = ProtoFormat::TEXT;
+	} else if (format == "binary") {
+		proto_format = ProtoFormat::BINARY;
+	} else {
+		throw std::invalid_argument("Unknown proto format: " + format);
+	}
+	if (variables.count("controllable-partition")) {
+		const auto &partitions = variables["controllable-partition"].as<std::vector<std::string>>();
+		for (const auto &partition : partitions) {
+			controllable_partitions.push_back(parse_action_list(partition));
+		}
+	}
 }
 
 void
-read_proto_from_file(const std::filesystem::path &path, google::protobuf::Message *output)
+read_proto_from_file(const std::filesystem::path &path,
+                     google::protobuf::Message *  output,
+                     ProtoFormat                  format)
 {
 	int fd = open(path.c_str(), O_RDONLY);
 	if (fd < 0) {
 		throw std::invalid_argument(
-		  fmt::format("Could not open plant file '{}' (errno: {})", path.c_str(), errno));
+		  fmt::format("Could not open proto file '{}' (errno: {})", path.c_str(), errno));
+	}
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0) {
+		close(fd);
+		throw std::invalid_argument(
+		  fmt::format("Could not read proto file '{}' (errno: {})", path.c_str(), errno));
+	}
+	const auto size = static_cast<std::size_t>(file_stat.st_size);
+	// The input streams of protobuf count bytes with an int.
+	if (size > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+		close(fd);
+		throw std::invalid_argument(fmt::format(
+		  "Could not read proto file '{}', it exceeds the size limit of 2 GiB", path.c_str()));
+	}
+	// An empty file cannot be mapped, but it is a valid (empty) message in both formats.
+	void *data = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+	close(fd);
+	if (data == MAP_FAILED) {
+		throw std::invalid_argument(
+		  fmt::format("Could not map proto file '{}' (errno: {})", path.c_str(), errno));
 	}
-	google::protobuf::io::FileInputStream stream(fd);
-	stream.SetCloseOnDelete(true);
-	if (!google::protobuf::TextFormat::Parse(&stream, output)) {
-		throw std::invalid_argument(fmt::format("Failed to read proto from file '{}", path.c_str()));
+	google::protobuf::io::ArrayInputStream stream(data, static_cast<int>(size));
+	const bool success = get_proto_format(path, format) == ProtoFormat::BINARY
+	                       ? output->ParseFromZeroCopyStream(&stream)
+	                       : google::protobuf::TextFormat::Parse(&stream, output);
+	if (data != nullptr) {
+		munmap(data, size);
+	}
+	if (!success) {
+		throw std::invalid_argument(fmt::format("Failed to read proto from file '{}'", path.c_str()));
 	}
 }
 
+void
+write_proto_to_file(const std::filesystem::path &  path,
+                    const google::protobuf::Message &message,
+                    ProtoFormat                      format)
+{
+	std::ofstream fs(path, std::ios::binary);
+	bool          success = false;
+	if (get_proto_format(path, format) == ProtoFormat::BINARY) {
+		success = message.SerializeToOstream(&fs);
+	} else {
+		std::string text;
+		success = google::protobuf::TextFormat::PrintToString(message, &text) && (fs << text).good();
+	}
+	if (!success) {
+		throw std::invalid_argument(fmt::format("Failed to write proto to file '{}'", path.c_str()));
+	}
+}
+
+/** The result of a synthesis with one engine. */
+struct Launcher::Synthesis
+{
+	/** The search, which owns the monitored plant if the monitor engine is used. */
+	std::unique_ptr<search::TreeSearch<std::vector<std::string>, std::string>> search;
+	/** The plant to verify the controller with. */
+	const ProductAutomaton *verification_plant;
+	/** The engine that synthesized the controller. */
+	Engine engine;
+	/** The canonical words of each controller location if requested. */
+	std::map<controller_synthesis::ControllerLocation,
+	         std::set<search::CanonicalABWord<std::vector<std::string>, std::string>>>
+	  controller_location_words;
+	/** The synthesized controller. */
+	automata::ta::TimedAutomaton<controller_synthesis::ControllerLocation, std::string> controller;
+};
+
+Launcher::Synthesis
+Launcher::synthesize(const ProductAutomaton &                              plant,
+                     const logic::MTLFormula<std::string> &                spec,
+                     SpecificationATA &                                    ata,
+                     const std::set<logic::AtomicProposition<std::string>> &aps,
+                     const std::set<std::string> &                         environment_actions,
+                     automata::Time                                        K,
+                     bool                                                  allow_digital_clocks)
+{
+	std::unique_ptr<search::TreeSearch<std::vector<std::string>, std::string>> search;
+	const ProductAutomaton *verification_plant = &plant;
+	Engine                  engine             = Engine::REGIONS;
+	if (use_monitor && mtl_ata_translation::is_monitorable(spec)) {
+		SPDLOG_INFO("Compiling the specification into a deterministic monitor");
+		if (allow_digital_clocks) {
+			SPDLOG_INFO("Digital clocks are not supported with a monitor, using regions");
+		}
+		const auto monitor = mtl_ata_translation::translate_to_monitor(spec, aps);
+		SPDLOG_DEBUG("Monitor:\n{}", monitor);
+		auto monitor_search = std::make_unique<search::MonitorTreeSearch<std::string, std::string>>(
+		  plant,
+		  monitor,
+		  controller_actions,
+		  environment_actions,
+		  K,
+		  true,
+		  true,
+		  create_heuristic(heuristic));
+		// The controller also observes the monitor clock, so verify it with the monitored plant.
+		verification_plant = &monitor_search->get_monitored_plant();
+		search             = std::move(monitor_search);
+		engine             = Engine::MONITOR;
+	} else {
+		if (use_monitor) {
+			SPDLOG_INFO("The specification cannot be monitored deterministically, using the ATA");
+		}
+		if (allow_digital_clocks && search::digital_clocks_are_sound(plant, spec)) {
+			SPDLOG_INFO("Using the digital clock engine");
+			engine = Engine::DIGITAL_CLOCKS;
+			search = std::make_unique<search::DigitalTreeSearch<std::vector<std::string>, std::string>>(
+			  &plant,
+			  &ata,
+			  controller_actions,
+			  environment_actions,
+			  K,
+			  true,
+			  true,
+			  create_heuristic(heuristic));
+		} else {
+			if (allow_digital_clocks) {
+				SPDLOG_INFO("Digital clocks are not sound for strict constraints, using regions");
+			}
+			SPDLOG_INFO("Using the region engine");
+			search = std::make_unique<search::TreeSearch<std::vector<std::string>, std::string>>(
+			  &plant,
+			  &ata,
+			  controller_actions,
+			  environment_actions,
+			  K,
+			  true,
+			  true,
+			  create_heuristic(heuristic));
+		}
+	}
+	std::map<controller_synthesis::ControllerLocation,
+	         std::set<search::CanonicalABWord<std::vector<std::string>, std::string>>>
+	  controller_location_words;
+	std::unique_ptr<controller_synthesis::ControllerStream<std::vector<std::string>, std::string>>
+	  controller_stream;
+	if (stream_controller) {
+		// Freeing parts of the tree is only safe if no other thread expands nodes concurrently.
+		const bool free_words = !multi_threaded && tree_dot_graph.empty();
+		SPDLOG_INFO("Creating the controller during the search{}",
+		            free_words ? ", freeing emitted nodes" : "");
+		controller_stream = std::make_unique<
+		  controller_synthesis::ControllerStream<std::vector<std::string>, std::string>>(
+		  search->get_root(),
+		  K,
+		  free_words,
+		  controller_locations_path.empty() ? nullptr : &controller_location_words);
+		search->set_expansion_callback(
+		  [&controller_stream](auto *node) { controller_stream->update(node); });
+	}
+	std::ofstream tree_export_stream;
+	std::unique_ptr<search::TreeExportWriter<std::vector<std::string>, std::string>> tree_writer;
+	if (!tree_export_path.empty()) {
+		SPDLOG_INFO("Exporting the search tree to '{}'", tree_export_path.c_str());
+		tree_export_stream.open(tree_export_path, std::ios::binary);
+		tree_writer = std::make_unique<
+		  search::TreeExportWriter<std::vector<std::string>, std::string>>(tree_export_stream);
+		search->set_timed_expansion_callback([&tree_writer](const auto *node, auto expansion_time) {
+			tree_writer->write_node(*node, expansion_time);
+		});
+	}
+	SPDLOG_INFO("Running search {}", multi_threaded ? "multi-threaded" : "single-threaded");
+	search->build_tree(multi_threaded);
+	SPDLOG_INFO("Search complete!");
+	if (tree_writer) {
+		// The labels may have changed after the nodes were written.
+		std::size_t num_labels = 0;
+		for (const auto &node : *search->get_root()) {
+			num_labels += tree_writer->write_label(node);
+		}
+		SPDLOG_INFO("Exported {} nodes and {} label updates", tree_writer->get_num_nodes(), num_labels);
+	}
+	SPDLOG_TRACE("Search tree:\n{}", search::node_to_string(*search->get_root(), true));
+	SPDLOG_INFO("Creating controller");
+	const auto compact_controller = [&]() {
+		if (controller_stream) {
+			auto res = controller_stream->finish();
+			SPDLOG_INFO("Emitted {} nodes, freed the words of {} nodes, destroyed {} nodes",
+			            controller_stream->get_num_emitted_nodes(),
+			            controller_stream->get_num_freed_nodes(),
+			            controller_stream->get_num_destroyed_nodes());
+			return res;
+		}
+		return controller_synthesis::create_compact_controller(
+		  search->get_root(),
+		  K,
+		  controller_locations_path.empty() ? nullptr : &controller_location_words);
+	}();
+	auto controller =
+	  minimize_controller ? automata::ta::minimize(compact_controller) : compact_controller;
+	if (minimize_controller) {
+		SPDLOG_INFO("Minimized controller from {} to {} locations and from {} to {} transitions",
+		            compact_controller.get_locations().size(),
+		            controller.get_locations().size(),
+		            compact_controller.get_transitions().size(),
+		            controller.get_transitions().size());
+	}
+	// The callbacks refer to the stream and the writer, which only live during this call.
+	search->set_expansion_callback(nullptr);
+	search->set_timed_expansion_callback(nullptr);
+	return Synthesis{std::move(search),
+	                 verification_plant,
+	                 engine,
+	                 std::move(controller_location_words),
+	                 std::move(controller)};
+}
+
 void
 Launcher::run()
 {
-	if (show_help) {
+	if (is_help_requested()) {
+		SPDLOG_INFO(help);
 		return;
 	}
-	automata::ta::proto::ProductAutomaton ta_proto;
-	SPDLOG_INFO("Reading plant TA from '{}'", plant_path.c_str());
-	read_proto_from_file(plant_path, &ta_proto);
-	auto plant = automata::ta::parse_product_proto(ta_proto);
-	SPDLOG_DEBUG("TA:\n{}", plant);
+	if (is_server_requested()) {
+		throw std::invalid_argument("Cannot run the launcher with --server, use app::Server instead");
+	}
+	// Allocate the input protos on an arena, which avoids many small allocations for large inputs.
+	google::protobuf::Arena arena;
+	auto &ta_proto =
+	  *google::protobuf::Arena::CreateMessage<automata::ta::proto::ProductAutomaton>(&arena);
+	// The cache inputs cover everything that determines the plant product and the ATA.
+	std::string inputs;
+	if (!cache_dir.empty() || memory_cache != nullptr) {
+		const auto options = fmt::format("{}{}{}", minimize_plant, slice_plant, normalize_constants);
+		inputs             = get_cache_inputs(plant_path, specification_path, options);
+	}
+	CachedArtifacts artifacts;
+	if (memory_cache != nullptr) {
+		if (const auto cached = memory_cache->find(inputs); cached != std::end(*memory_cache)) {
+			SPDLOG_INFO("Using plant and specification from memory");
+			artifacts = cached->second;
+		}
+	}
+	std::optional<ArtifactCache> cache;
+	std::ifstream                cache_stream;
+	if (!cache_dir.empty() && !artifacts.plant) {
+		cache.emplace(cache_dir, inputs);
+		if (cache->open(cache_stream)) {
+			SPDLOG_INFO("Reading plant and specification from cache '{}'", cache->get_path().c_str());
+		}
+	}
+	const auto build_plant = [this, &ta_proto, &cache_stream]() {
+		if (cache_stream.is_open()) {
+			try {
+				return read_product_automaton(cache_stream);
+			} catch (const std::invalid_argument &e) {
+				SPDLOG_WARN("Ignoring invalid cache entry: {}", e.what());
+				cache_stream.close();
+			}
+		}
+		SPDLOG_INFO("Reading plant TA from '{}'", plant_path.c_str());
+		read_proto_from_file(plant_path, &ta_proto, proto_format);
+		if (!minimize_plant && !slice_plant) {
+			return automata::ta::parse_product_proto(ta_proto);
+		}
+		// Reduce each component before the product multiplies its locations.
+		std::vector<automata::ta::TimedAutomaton<std::string, std::string>> components;
+		for (const auto &component_proto : ta_proto.automata()) {
+			const auto component = automata::ta::parse_proto(component_proto);
+			if (slice_plant && automata::ta::is_inert(component)) {
+				SPDLOG_INFO("Removing plant component with initial location '{}', it cannot do anything",
+				            component.get_initial_location().get());
+				continue;
+			}
+			if (!minimize_plant) {
+				components.push_back(component);
+				continue;
+			}
+			auto minimized =
+			  automata::ta::minimize(automata::ta::remove_unreachable_locations(component));
+			SPDLOG_INFO("Minimized plant component from {} to {} locations and from {} to {} transitions",
+			            component.get_locations().size(),
+			            minimized.get_locations().size(),
+			            component.get_transitions().size(),
+			            minimized.get_transitions().size());
+			components.push_back(std::move(minimized));
+		}
+		if (components.empty()) {
+			// All components are inert, keep one of them so the product is well-defined.
+			components.push_back(automata::ta::parse_proto(*std::begin(ta_proto.automata())));
+		}
+		auto product = automata::ta::get_product(components);
+		if (!slice_plant) {
+			SPDLOG_INFO("The plant has {} locations and {} transitions",
+			            product.get_locations().size(),
+			            product.get_transitions().size());
+			return product;
+		}
+		auto                  sliced = automata::ta::slice(product);
+		std::set<std::string> removed_clocks;
+		std::set_difference(std::begin(product.get_clocks()),
+		                    std::end(product.get_clocks()),
+		                    std::begin(sliced.get_clocks()),
+		                    std::end(sliced.get_clocks()),
+		                    std::inserter(removed_clocks, std::end(removed_clocks)));
+		std::set<std::string> removed_actions;
+		std::set_difference(std::begin(product.get_alphabet()),
+		                    std::end(product.get_alphabet()),
+		                    std::begin(sliced.get_alphabet()),
+		                    std::end(sliced.get_alphabet()),
+		                    std::inserter(removed_actions, std::end(removed_actions)));
+		SPDLOG_INFO("Sliced the plant: removed clocks {{{}}} and actions {{{}}}",
+		            fmt::join(removed_clocks, ", "),
+		            fmt::join(removed_actions, ", "));
+		SPDLOG_INFO("The plant has {} locations and {} transitions",
+		            sliced.get_locations().size(),
+		            sliced.get_transitions().size());
+		return sliced;
+	};
+	if (!artifacts.plant) {
+		artifacts.plant = std::make_shared<const ProductAutomaton>(build_plant());
+	}
+	const auto &input_plant = *artifacts.plant;
+	SPDLOG_DEBUG("TA:\n{}", input_plant);
+	// Dot files are streamed directly, all other formats are rendered with graphviz.
+	const visualization::DotOptions dot_options{dot_max_depth,
+	                                            dot_max_children,
+	                                            dot_max_label_length,
+	                                            true};
 	if (!plant_dot_graph.empty()) {
-		visualization::ta_to_graphviz(plant).render_to_file(plant_dot_graph);
+		if (plant_dot_graph.extension() == ".dot") {
+			std::ofstream fs(plant_dot_graph);
+			visualization::write_ta_dot(fs, input_plant, true, dot_options);
+		} else {
+			visualization::ta_to_graphviz(input_plant).render_to_file(plant_dot_graph);
+		}
 	}
 	SPDLOG_INFO("Reading MTL specification of undesired behaviors from '{}'",
 	            specification_path.c_str());
-	logic::proto::MTLFormula spec_proto;
-	read_proto_from_file(specification_path, &spec_proto);
-	auto                                            spec = logic::parse_proto(spec_proto);
+	auto &spec_proto = *google::protobuf::Arena::CreateMessage<logic::proto::MTLFormula>(&arena);
+	read_proto_from_file(specification_path, &spec_proto, proto_format);
+	const auto input_spec    = logic::parse_proto(spec_proto);
+	const auto normalization = normalize_constants
+	                             ? search::get_constant_normalization(input_plant, input_spec)
+	                             : search::ConstantNormalization{};
+	if (normalize_constants) {
+		// The controller's constants are integers in the normalized time unit, they must also be
+		// integers in the input time unit.
+		if (!search::has_integral_time_unit(normalization)) {
+			throw std::invalid_argument(
+			  fmt::format("Cannot normalize the constants, one time unit of the normalized problem is "
+			              "{}/{} time units of the input, so the controller could not be rescaled",
+			              normalization.divisor,
+			              normalization.multiplier));
+		}
+		SPDLOG_INFO("Normalizing constants by multiplying them with {} and dividing them by {}",
+		            normalization.multiplier,
+		            normalization.divisor);
+	}
+	const auto plant = search::normalize(input_plant, normalization);
+	const auto spec  = search::normalize(input_spec, normalization);
 	std::set<logic::AtomicProposition<std::string>> aps;
 	std::transform(std::begin(plant.get_alphabet()),
 	               std::end(plant.get_alphabet()),
 	               std::inserter(aps, std::end(aps)),
 	               [](const auto &symbol) { return logic::AtomicProposition<std::string>{symbol}; });
-	auto ata = mtl_ata_translation::translate(spec, aps);
+	const auto build_ata = [&spec, &aps, &cache_stream]() {
+		if (cache_stream.is_open()) {
+			try {
+				return read_specification_ata(cache_stream);
+			} catch (const std::invalid_argument &e) {
+				SPDLOG_WARN("Ignoring invalid cache entry: {}", e.what());
+				cache_stream.close();
+			}
+		}
+		return mtl_ata_translation::translate(spec, aps);
+	};
+	if (!artifacts.ata) {
+		// The ATA can neither be copied nor moved, so construct it in place.
+		artifacts.ata = std::shared_ptr<SpecificationATA>(new SpecificationATA(build_ata()));
+		if (cache && !cache_stream.is_open()) {
+			SPDLOG_INFO("Writing plant and specification to cache '{}'", cache->get_path().c_str());
+			cache->store(input_plant, *artifacts.ata);
+		}
+		if (memory_cache != nullptr) {
+			memory_cache->insert_or_assign(std::move(inputs), artifacts);
+		}
+	}
+	auto &ata = *artifacts.ata;
 	SPDLOG_DEBUG("Specification: {}", spec);
 	SPDLOG_DEBUG("ATA:\n{}", ata);
 	std::set<std::string> environment_actions;
@@ -179,33 +698,104 @@ Launcher::run()
 	SPDLOG_INFO("Environment actions: {}", fmt::join(environment_actions, ", "));
 	SPDLOG_INFO("Initializing search");
 	const auto K = std::max(plant.get_largest_constant(), spec.get_largest_constant());
-	search::TreeSearch search(&plant,
-	                                       &ata,
-	                                       controller_actions,
-	                                       environment_actions,
-	                                       K,
-	                                       true,
-	                                       true,
-	                                       create_heuristic(heuristic));
-	SPDLOG_INFO("Running search {}", multi_threaded ? "multi-threaded" : "single-threaded");
-	search.build_tree(multi_threaded);
-	SPDLOG_INFO("Search complete!");
-	SPDLOG_TRACE("Search tree:\n{}", search::node_to_string(*search.get_root(), true));
-	SPDLOG_INFO("Creating controller");
-	auto controller = controller_synthesis::create_controller(search.get_root(), K);
+	if (!controllable_partitions.empty() || find_minimal_controller_actions) {
+		analyze_partitions(plant,
+		                   &ata,
+		                   K,
+		                   controllable_partitions,
+		                   find_minimal_controller_actions
+		                     ? std::optional<std::set<std::string>>{controller_actions}
+		                     : std::nullopt,
+		                   heuristic,
+		                   multi_threaded);
+		return;
+	}
+	const auto verify_synthesis = [&](const Synthesis &synthesis) {
+		SPDLOG_INFO("Verifying controller");
+		const auto result = controller_synthesis::verify_controller(*synthesis.verification_plant,
+		                                                            ata,
+		                                                            synthesis.controller,
+		                                                            controller_actions,
+		                                                            environment_actions,
+		                                                            K,
+		                                                            multi_threaded);
+		SPDLOG_INFO("Verification {} after {:.3f}s: {} states, {} pruned, {} bad states, {} uncovered "
+		            "environment actions",
+		            result.verified ? "succeeded" : "failed",
+		            std::chrono::duration<double>(result.duration).count(),
+		            result.num_states,
+		            result.num_pruned_states,
+		            result.num_bad_states,
+		            result.num_uncovered_actions);
+		return result.verified;
+	};
+	std::optional<Synthesis> synthesis;
+	synthesis.emplace(synthesize(plant, spec, ata, aps, environment_actions, K, digital_clocks));
+	// A controller of the digital clock engine is always verified in dense time, even without
+	// --verify, and replaced by a controller of the region engine if it fails.
+	if (verify || synthesis->engine == Engine::DIGITAL_CLOCKS) {
+		bool verified = verify_synthesis(*synthesis);
+		if (!verified && synthesis->engine == Engine::DIGITAL_CLOCKS) {
+			SPDLOG_WARN("The controller of the digital clock engine does not satisfy the specification "
+			            "in dense time, falling back to the region engine");
+			// Free the first search tree before building the second one.
+			synthesis.reset();
+			synthesis.emplace(synthesize(plant, spec, ata, aps, environment_actions, K, false));
+			verified = !verify || verify_synthesis(*synthesis);
+		}
+		if (!verified) {
+			throw std::runtime_error("The controller does not satisfy the specification");
+		}
+	}
+	engine                                = synthesis->engine;
+	const auto &controller                = synthesis->controller;
+	const auto &search                    = synthesis->search;
+	const auto &controller_location_words = synthesis->controller_location_words;
+	// Rescale the controller to the time unit of the input.
+	const auto output_controller =
+	  normalize_constants ? search::denormalize(controller, normalization) : controller;
+	if (!controller_locations_path.empty()) {
+		SPDLOG_INFO("Writing controller locations to '{}'", controller_locations_path.c_str());
+		std::ofstream fs(controller_locations_path);
+		for (const auto &[location, words] : controller_location_words) {
+			fs << location << ": " << words << "\n";
+		}
+	}
 	if (!controller_dot_path.empty()) {
 		SPDLOG_INFO("Writing controller to '{}'", controller_dot_path.c_str());
-		visualization::ta_to_graphviz(controller, !hide_controller_labels)
-		  .render_to_file(controller_dot_path);
+		if (controller_dot_path.extension() == ".dot") {
+			std::ofstream fs(controller_dot_path);
+			visualization::write_ta_dot(fs, output_controller, !hide_controller_labels, dot_options);
+		} else {
+			visualization::ta_to_graphviz(output_controller, !hide_controller_labels)
+			  .render_to_file(controller_dot_path);
+		}
 	}
 	if (!tree_dot_graph.empty()) {
 		SPDLOG_INFO("Writing search tree to '{}'", tree_dot_graph.c_str());
-		visualization::search_tree_to_graphviz(*search.get_root(), true).render_to_file(tree_dot_graph);
+		if (tree_dot_graph.extension() == ".dot") {
+			std::ofstream     fs(tree_dot_graph);
+			const std::size_t num_nodes =
+			  visualization::write_search_tree_dot(fs, *search->get_root(), dot_options);
+			SPDLOG_INFO("Wrote {} of {} search tree nodes", num_nodes, search->get_size());
+		} else {
+			visualization::search_tree_to_graphviz(*search->get_root(), true)
+			  .render_to_file(tree_dot_graph);
+		}
 	}
 	if (!controller_proto_path.empty()) {
 		SPDLOG_INFO("Writing controller proto to '{}'", controller_proto_path.c_str());
-		std::ofstream fs(controller_proto_path);
-		fs << automata::ta::ta_to_proto(controller).SerializeAsString();
+		write_proto_to_file(controller_proto_path,
+		                    automata::ta::ta_to_proto(output_controller),
+		                    proto_format);
+	}
+	if (!controller_cpp_path.empty()) {
+		SPDLOG_INFO("Writing controller code to '{}'", controller_cpp_path.c_str());
+		std::ofstream fs(controller_cpp_path);
+		controller_synthesis::export_to_cpp(
+		  controller_synthesis::create_decision_table(
+		    output_controller, controller_actions, ticks_per_time_unit),
+		  fs);
 	}
 }
 
@@ -0,0 +1,634 @@
+/***************************************************************************
+ *  artifact_cache.cpp - Cache the product plant and the translated ATA on disk
+ *
+ *  Created:   Mon 19 Oct 03:27:51 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "app/artifact_cache.h"
+
+#include "automata/ata_formula.h"
+#include "automata/automata.h"
+
+#include "automata/ta_proto.h"
+#include "mtl_ata_translation/translator.h"
+
+#include <dlfcn.h>
+#include <fmt/format.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace app {
+
+namespace {
+
+using automata::ClockConstraint;
+using automata::ta::Location;
+using MTLFormula = logic::MTLFormula<std::string>;
+using AP         = logic::AtomicProposition<std::string>;
+using ATAFormula = automata::ata::Formula<MTLFormula>;
+
+/** The magic bytes at the beginning of each cache entry. */
+constexpr char cache_magic[] = "MTLSCACH";
+/** The version of the cache format, entries with a different version are ignored. */
+constexpr std::uint64_t cache_version = 2;
+
+/** The tags of the ATA formula types. */
+enum class FormulaTag { TRUE, FALSE, LOCATION, CLOCK_CONSTRAINT, CONJUNCTION, DISJUNCTION, RESET };
+
+void
+write_varint(std::ostream &os, std::uint64_t value)
+{
+	while (value >= 0x80) {
+		os.put(static_cast<char>((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	os.put(static_cast<char>(value));
+}
+
+std::uint64_t
+read_varint(std::istream &is)
+{
+	std::uint64_t value = 0;
+	for (unsigned int shift = 0; shift < 64; shift += 7) {
+		const auto byte = is.get();
+		if (byte == std::istream::traits_type::eof()) {
+			throw std::invalid_argument("Unexpected end of the cache entry");
+		}
+		value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0) {
+			return value;
+		}
+	}
+	throw std::invalid_argument("Invalid varint in the cache entry");
+}
+
+/** Get the number of bytes from the current position to the end of the stream.
+ * A count or length in an entry can never exceed this, as each element takes at least one byte.
+ */
+std::uint64_t
+get_remaining_bytes(std::istream &is)
+{
+	const auto position = is.tellg();
+	if (position == std::istream::pos_type(-1) || !is.seekg(0, std::ios::end)) {
+		throw std::invalid_argument("Cannot determine the size of the cache entry");
+	}
+	const auto end = is.tellg();
+	is.seekg(position);
+	return static_cast<std::uint64_t>(end - position);
+}
+
+/** Read a varint that counts the elements or bytes that follow.
+ * Checking the count against the remaining bytes rejects a corrupt count before it is used to
+ * allocate memory or to drive a loop.
+ */
+std::uint64_t
+read_size(std::istream &is, std::uint64_t remaining_bytes)
+{
+	const auto size = read_varint(is);
+	if (size > remaining_bytes) {
+		throw std::invalid_argument("Invalid size in the cache entry");
+	}
+	return size;
+}
+
+/** Read a varint that refers to an element of a table with the given size. */
+std::size_t
+read_index(std::istream &is, std::size_t size)
+{
+	const auto index = read_varint(is);
+	if (index >= size) {
+		throw std::invalid_argument("Invalid index in the cache entry");
+	}
+	return static_cast<std::size_t>(index);
+}
+
+void
+write_string(std::ostream &os, const std::string &value)
+{
+	write_varint(os, value.size());
+	os.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+std::string
+read_string(std::istream &is, std::uint64_t remaining_bytes)
+{
+	std::string value(read_size(is, remaining_bytes), '\0');
+	is.read(value.data(), static_cast<std::streamsize>(value.size()));
+	if (!is) {
+		throw std::invalid_argument("Unexpected end of the cache entry");
+	}
+	return value;
+}
+
+void
+write_double(std::ostream &os, double value)
+{
+	char bytes[sizeof(value)];
+	std::memcpy(bytes, &value, sizeof(value));
+	os.write(bytes, sizeof(bytes));
+}
+
+double
+read_double(std::istream &is)
+{
+	char bytes[sizeof(double)];
+	if (!is.read(bytes, sizeof(bytes))) {
+		throw std::invalid_argument("Unexpected end of the cache entry");
+	}
+	double value;
+	std::memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+void
+write_clock_constraint(std::ostream &os, const ClockConstraint &constraint)
+{
+	write_varint(os, constraint.index());
+	write_varint(os, std::visit([](const auto &c) { return c.get_comparand(); }, constraint));
+}
+
+ClockConstraint
+read_clock_constraint(std::istream &is)
+{
+	const auto index     = read_varint(is);
+	const auto comparand = static_cast<automata::Endpoint>(read_varint(is));
+	switch (index) {
+	case 0: return automata::AtomicClockConstraintT<std::less<automata::Time>>(comparand);
+	case 1: return automata::AtomicClockConstraintT<std::less_equal<automata::Time>>(comparand);
+	case 2: return automata::AtomicClockConstraintT<std::equal_to<automata::Time>>(comparand);
+	case 3: return automata::AtomicClockConstraintT<std::not_equal_to<automata::Time>>(comparand);
+	case 4: return automata::AtomicClockConstraintT<std::greater_equal<automata::Time>>(comparand);
+	case 5: return automata::AtomicClockConstraintT<std::greater<automata::Time>>(comparand);
+	default: throw std::invalid_argument("Invalid clock constraint in the cache entry");
+	}
+}
+
+/** Write a string table and return the index of each string. */
+template <typename Range>
+std::map<std::string, std::uint64_t>
+write_string_table(std::ostream &os, const Range &strings)
+{
+	std::map<std::string, std::uint64_t> indices;
+	write_varint(os, strings.size());
+	for (const auto &value : strings) {
+		indices.emplace(value, indices.size());
+		write_string(os, value);
+	}
+	return indices;
+}
+
+std::vector<std::string>
+read_string_table(std::istream &is, std::uint64_t remaining_bytes)
+{
+	std::vector<std::string> strings;
+	for (auto size = read_size(is, remaining_bytes); size > 0; --size) {
+		strings.push_back(read_string(is, remaining_bytes));
+	}
+	return strings;
+}
+
+void
+write_mtl_formula(std::ostream &os, const MTLFormula &formula)
+{
+	const auto op = formula.get_operator();
+	os.put(static_cast<char>(op));
+	switch (op) {
+	case logic::LOP::TRUE:
+	case logic::LOP::FALSE: return;
+	case logic::LOP::AP: write_string(os, formula.get_atomicProposition().ap_); return;
+	case logic::LOP::LUNTIL:
+	case logic::LOP::LDUNTIL: {
+		const auto interval = formula.get_interval();
+		write_double(os, interval.lower());
+		os.put(static_cast<char>(interval.lowerBoundType()));
+		write_double(os, interval.upper());
+		os.put(static_cast<char>(interval.upperBoundType()));
+		break;
+	}
+	default: break;
+	}
+	write_varint(os, formula.get_operands().size());
+	for (const auto &operand : formula.get_operands()) {
+		write_mtl_formula(os, operand);
+	}
+}
+
+utilities::arithmetic::BoundType
+read_bound_type(std::istream &is)
+{
+	const auto byte = is.get();
+	if (byte < 0 || byte > static_cast<int>(utilities::arithmetic::BoundType::INFTY)) {
+		throw std::invalid_argument("Invalid bound type in the cache entry");
+	}
+	return static_cast<utilities::arithmetic::BoundType>(byte);
+}
+
+MTLFormula
+read_mtl_formula(std::istream &is, std::uint64_t remaining_bytes)
+{
+	const auto byte = is.get();
+	if (byte < 0 || byte > static_cast<int>(logic::LOP::FALSE)) {
+		throw std::invalid_argument("Invalid MTL operator in the cache entry");
+	}
+	const auto op = static_cast<logic::LOP>(byte);
+	switch (op) {
+	case logic::LOP::TRUE: return MTLFormula::TRUE();
+	case logic::LOP::FALSE: return MTLFormula::FALSE();
+	case logic::LOP::AP: return MTLFormula{AP{read_string(is, remaining_bytes)}};
+	default: break;
+	}
+	std::optional<logic::TimeInterval> interval;
+	if (op == logic::LOP::LUNTIL || op == logic::LOP::LDUNTIL) {
+		const auto lower      = read_double(is);
+		const auto lower_type = read_bound_type(is);
+		const auto upper      = read_double(is);
+		const auto upper_type = read_bound_type(is);
+		interval              = logic::TimeInterval{lower, lower_type, upper, upper_type};
+	}
+	std::vector<MTLFormula> operands;
+	for (auto size = read_size(is, remaining_bytes); size > 0; --size) {
+		operands.push_back(read_mtl_formula(is, remaining_bytes));
+	}
+	const bool is_binary = op == logic::LOP::LUNTIL || op == logic::LOP::LDUNTIL;
+	if ((is_binary && operands.size() != 2) || (op == logic::LOP::LNEG && operands.size() != 1)) {
+		throw std::invalid_argument("Invalid number of MTL operands in the cache entry");
+	}
+	switch (op) {
+	case logic::LOP::LAND: return MTLFormula::create_conjunction(operands);
+	case logic::LOP::LOR: return MTLFormula::create_disjunction(operands);
+	case logic::LOP::LNEG: return !operands[0];
+	case logic::LOP::LUNTIL: return operands[0].until(operands[1], *interval);
+	default: return operands[0].dual_until(operands[1], *interval);
+	}
+}
+
+/** Collect all ATA locations that occur in a formula. */
+void
+collect_locations(const ATAFormula &formula, std::map<MTLFormula, std::uint64_t> &locations)
+{
+	using namespace automata::ata;
+	if (const auto *f = dynamic_cast<const LocationFormula<MTLFormula> *>(&formula)) {
+		locations.emplace(f->get_location(), locations.size());
+	} else if (const auto *f = dynamic_cast<const ConjunctionFormula<MTLFormula> *>(&formula)) {
+		collect_locations(f->get_conjunct1(), locations);
+		collect_locations(f->get_conjunct2(), locations);
+	} else if (const auto *f = dynamic_cast<const DisjunctionFormula<MTLFormula> *>(&formula)) {
+		collect_locations(f->get_disjunct1(), locations);
+		collect_locations(f->get_disjunct2(), locations);
+	} else if (const auto *f = dynamic_cast<const ResetClockFormula<MTLFormula> *>(&formula)) {
+		collect_locations(f->get_sub_formula(), locations);
+	}
+}
+
+void
+write_ata_formula(std::ostream &                              os,
+                  const ATAFormula &                          formula,
+                  const std::map<MTLFormula, std::uint64_t> &locations)
+{
+	using namespace automata::ata;
+	if (dynamic_cast<const TrueFormula<MTLFormula> *>(&formula)) {
+		os.put(static_cast<char>(FormulaTag::TRUE));
+	} else if (dynamic_cast<const FalseFormula<MTLFormula> *>(&formula)) {
+		os.put(static_cast<char>(FormulaTag::FALSE));
+	} else if (const auto *f = dynamic_cast<const LocationFormula<MTLFormula> *>(&formula)) {
+		os.put(static_cast<char>(FormulaTag::LOCATION));
+		write_varint(os, locations.at(f->get_location()));
+	} else if (const auto *f = dynamic_cast<const ClockConstraintFormula<MTLFormula> *>(&formula)) {
+		os.put(static_cast<char>(FormulaTag::CLOCK_CONSTRAINT));
+		write_clock_constraint(os, f->get_constraint());
+	} else if (const auto *f = dynamic_cast<const ConjunctionFormula<MTLFormula> *>(&formula)) {
+		os.put(static_cast<char>(FormulaTag::CONJUNCTION));
+		write_ata_formula(os, f->get_conjunct1(), locations);
+		write_ata_formula(os, f->get_conjunct2(), locations);
+	} else if (const auto *f = dynamic_cast<const DisjunctionFormula<MTLFormula> *>(&formula)) {
+		os.put(static_cast<char>(FormulaTag::DISJUNCTION));
+		write_ata_formula(os, f->get_disjunct1(), locations);
+		write_ata_formula(os, f->get_disjunct2(), locations);
+	} else if (const auto *f = dynamic_cast<const ResetClockFormula<MTLFormula> *>(&formula)) {
+		os.put(static_cast<char>(FormulaTag::RESET));
+		write_ata_formula(os, f->get_sub_formula(), locations);
+	} else {
+		throw std::invalid_argument("Cannot cache an ATA formula of unknown type");
+	}
+}
+
+std::unique_ptr<ATAFormula>
+read_ata_formula(std::istream &is, const std::vector<MTLFormula> &locations)
+{
+	using namespace automata::ata;
+	const auto byte = is.get();
+	if (byte < 0 || byte > static_cast<int>(FormulaTag::RESET)) {
+		throw std::invalid_argument("Invalid ATA formula in the cache entry");
+	}
+	switch (static_cast<FormulaTag>(byte)) {
+	case FormulaTag::TRUE: return std::make_unique<TrueFormula<MTLFormula>>();
+	case FormulaTag::FALSE: return std::make_unique<FalseFormula<MTLFormula>>();
+	case FormulaTag::LOCATION:
+		return std::make_unique<LocationFormula<MTLFormula>>(
+		  locations[read_index(is, locations.size())]);
+	case FormulaTag::CLOCK_CONSTRAINT:
+		return std::make_unique<ClockConstraintFormula<MTLFormula>>(read_clock_constraint(is));
+	case FormulaTag::CONJUNCTION: {
+		auto conjunct1 = read_ata_formula(is, locations);
+		auto conjunct2 = read_ata_formula(is, locations);
+		return std::make_unique<ConjunctionFormula<MTLFormula>>(std::move(conjunct1),
+		                                                        std::move(conjunct2));
+	}
+	case FormulaTag::DISJUNCTION: {
+		auto disjunct1 = read_ata_formula(is, locations);
+		auto disjunct2 = read_ata_formula(is, locations);
+		return std::make_unique<DisjunctionFormula<MTLFormula>>(std::move(disjunct1),
+		                                                        std::move(disjunct2));
+	}
+	case FormulaTag::RESET:
+		return std::make_unique<ResetClockFormula<MTLFormula>>(read_ata_formula(is, locations));
+	}
+	throw std::invalid_argument("Invalid ATA formula in the cache entry");
+}
+
+} // namespace
+
+std::string
+get_build_stamp()
+{
+	// The artifacts are computed by the code of these libraries, rebuilding any of them updates the
+	// modification time of its shared object.
+	const std::vector<const void *> functions{
+	  reinterpret_cast<const void *>(&write_product_automaton),
+	  reinterpret_cast<const void *>(&automata::ta::parse_product_proto),
+	  reinterpret_cast<const void *>(&mtl_ata_translation::translate)};
+	std::string stamp = fmt::format("{}", cache_version);
+	for (const auto function : functions) {
+		Dl_info info;
+		if (dladdr(function, &info) == 0 || info.dli_fname == nullptr) {
+			continue;
+		}
+		std::error_code             error;
+		const std::filesystem::path library{info.dli_fname};
+		const auto                  size          = std::filesystem::file_size(library, error);
+		const auto                  last_modified = std::filesystem::last_write_time(library, error);
+		if (error) {
+			continue;
+		}
+		stamp += fmt::format(
+		  ";{}:{}:{}", library.c_str(), size, last_modified.time_since_epoch().count());
+	}
+	return stamp;
+}
+
+std::string
+get_cache_inputs(const std::filesystem::path &plant_path,
+                 const std::filesystem::path &specification_path,
+                 const std::string &          options)
+{
+	std::stringstream inputs;
+	write_string(inputs, get_build_stamp());
+	write_string(inputs, options);
+	for (const auto &path : {plant_path, specification_path}) {
+		std::ifstream is(path, std::ios::binary);
+		if (!is) {
+			throw std::invalid_argument(fmt::format("Failed to open file '{}'", path.c_str()));
+		}
+		std::stringstream contents;
+		contents << is.rdbuf();
+		write_string(inputs, contents.str());
+	}
+	return inputs.str();
+}
+
+void
+write_product_automaton(std::ostream &os, const ProductAutomaton &ta)
+{
+	const auto symbols = write_string_table(os, ta.get_alphabet());
+	const auto clocks  = write_string_table(os, ta.get_clocks());
+	std::map<Location<std::vector<std::string>>, std::uint64_t> locations;
+	write_varint(os, ta.get_locations().size());
+	for (const auto &location : ta.get_locations()) {
+		locations.emplace(location, locations.size());
+		write_varint(os, location.get().size());
+		for (const auto &component : location.get()) {
+			write_string(os, component);
+		}
+	}
+	write_varint(os, locations.at(ta.get_initial_location()));
+	write_varint(os, ta.get_final_locations().size());
+	for (const auto &location : ta.get_final_locations()) {
+		write_varint(os, locations.at(location));
+	}
+	write_varint(os, ta.get_transitions().size());
+	for (const auto &[source, transition] : ta.get_transitions()) {
+		write_varint(os, locations.at(transition.source_));
+		write_varint(os, symbols.at(transition.symbol_));
+		write_varint(os, locations.at(transition.target_));
+		write_varint(os, transition.clock_constraints_.size());
+		for (const auto &[clock, constraint] : transition.clock_constraints_) {
+			write_varint(os, clocks.at(clock));
+			write_clock_constraint(os, constraint);
+		}
+		write_varint(os, transition.clock_resets_.size());
+		for (const auto &clock : transition.clock_resets_) {
+			write_varint(os, clocks.at(clock));
+		}
+	}
+}
+
+ProductAutomaton
+read_product_automaton(std::istream &is)
+{
+	const auto remaining_bytes = get_remaining_bytes(is);
+	const auto symbols         = read_string_table(is, remaining_bytes);
+	const auto clocks          = read_string_table(is, remaining_bytes);
+	std::vector<Location<std::vector<std::string>>> locations;
+	for (auto num_locations = read_size(is, remaining_bytes); num_locations > 0; --num_locations) {
+		std::vector<std::string> components;
+		for (auto num_components = read_size(is, remaining_bytes); num_components > 0;
+		     --num_components) {
+			components.push_back(read_string(is, remaining_bytes));
+		}
+		locations.emplace_back(std::move(components));
+	}
+	const auto initial_location = locations[read_index(is, locations.size())];
+
+	std::set<Location<std::vector<std::string>>> final_locations;
+	for (auto num_final_locations = read_size(is, remaining_bytes); num_final_locations > 0;
+	     --num_final_locations) {
+		final_locations.insert(locations[read_index(is, locations.size())]);
+	}
+	std::vector<automata::ta::Transition<std::vector<std::string>, std::string>> transitions;
+	for (auto num_transitions = read_size(is, remaining_bytes); num_transitions > 0;
+	     --num_transitions) {
+		const auto &source = locations[read_index(is, locations.size())];
+		const auto &symbol = symbols[read_index(is, symbols.size())];
+		const auto &target = locations[read_index(is, locations.size())];
+		std::multimap<std::string, ClockConstraint> constraints;
+		for (auto num_constraints = read_size(is, remaining_bytes); num_constraints > 0;
+		     --num_constraints) {
+			const auto &clock = clocks[read_index(is, clocks.size())];
+			constraints.emplace(clock, read_clock_constraint(is));
+		}
+		std::set<std::string> resets;
+		for (auto num_resets = read_size(is, remaining_bytes); num_resets > 0; --num_resets) {
+			resets.insert(clocks[read_index(is, clocks.size())]);
+		}
+		transitions.emplace_back(source, symbol, target, constraints, resets);
+	}
+	return ProductAutomaton{{std::begin(locations), std::end(locations)},
+	                        {std::begin(symbols), std::end(symbols)},
+	                        initial_location,
+	                        final_locations,
+	                        {std::begin(clocks), std::end(clocks)},
+	                        transitions};
+}
+
+void
+write_specification_ata(std::ostream &os, const SpecificationATA &ata)
+{
+	std::set<std::string> symbols;
+	for (const auto &symbol : ata.get_alphabet()) {
+		symbols.insert(symbol.ap_);
+	}
+	const auto symbol_indices = write_string_table(os, symbols);
+	std::map<MTLFormula, std::uint64_t> locations;
+	locations.emplace(ata.get_initial_location(), locations.size());
+	for (const auto &location : ata.get_final_locations()) {
+		locations.emplace(location, locations.size());
+	}
+	if (ata.get_sink_location()) {
+		locations.emplace(*ata.get_sink_location(), locations.size());
+	}
+	for (const auto &transition : ata.get_transitions()) {
+		locations.emplace(transition.source_, locations.size());
+		collect_locations(transition.get_formula(), locations);
+	}
+	// Write the locations ordered by their index, so the reader can refer to them by index.
+	std::vector<const MTLFormula *> ordered_locations(locations.size());
+	for (const auto &[location, index] : locations) {
+		ordered_locations[index] = &location;
+	}
+	write_varint(os, ordered_locations.size());
+	for (const auto *location : ordered_locations) {
+		write_mtl_formula(os, *location);
+	}
+	write_varint(os, locations.at(ata.get_initial_location()));
+	write_varint(os, ata.get_final_locations().size());
+	for (const auto &location : ata.get_final_locations()) {
+		write_varint(os, locations.at(location));
+	}
+	// Use 0 for no sink location, so shift the indices by one.
+	write_varint(os, ata.get_sink_location() ? locations.at(*ata.get_sink_location()) + 1 : 0);
+	write_varint(os, ata.get_transitions().size());
+	for (const auto &transition : ata.get_transitions()) {
+		write_varint(os, locations.at(transition.source_));
+		write_varint(os, symbol_indices.at(transition.symbol_.ap_));
+		write_ata_formula(os, transition.get_formula(), locations);
+	}
+}
+
+SpecificationATA
+read_specification_ata(std::istream &is)
+{
+	const auto   remaining_bytes = get_remaining_bytes(is);
+	std::set<AP> alphabet;
+	const auto   symbols         = read_string_table(is, remaining_bytes);
+	for (const auto &symbol : symbols) {
+		alphabet.insert(AP{symbol});
+	}
+	std::vector<MTLFormula> locations;
+	for (auto num_locations = read_size(is, remaining_bytes); num_locations > 0; --num_locations) {
+		locations.push_back(read_mtl_formula(is, remaining_bytes));
+	}
+	const auto           initial_location = locations[read_index(is, locations.size())];
+	std::set<MTLFormula> final_locations;
+	for (auto num_final_locations = read_size(is, remaining_bytes); num_final_locations > 0;
+	     --num_final_locations) {
+		final_locations.insert(locations[read_index(is, locations.size())]);
+	}
+	std::optional<MTLFormula> sink_location;
+	if (const auto sink = read_index(is, locations.size() + 1); sink > 0) {
+		sink_location = locations[sink - 1];
+	}
+	std::set<automata::ata::Transition<MTLFormula, AP>> transitions;
+	for (auto num_transitions = read_size(is, remaining_bytes); num_transitions > 0;
+	     --num_transitions) {
+		const auto &source  = locations[read_index(is, locations.size())];
+		const auto &symbol  = symbols[read_index(is, symbols.size())];
+		auto        formula = read_ata_formula(is, locations);
+		transitions.emplace(source, AP{symbol}, std::move(formula));
+	}
+	return SpecificationATA{
+	  alphabet, initial_location, final_locations, std::move(transitions), sink_location};
+}
+
+ArtifactCache::ArtifactCache(const std::filesystem::path &directory, std::string inputs)
+: directory_(directory),
+  path_(directory / fmt::format("{:016x}.mtlcache", fnv1a_hash(inputs))),
+  inputs_(std::move(inputs))
+{
+}
+
+bool
+ArtifactCache::open(std::ifstream &is) const
+{
+	is.open(path_, std::ios::binary);
+	if (!is) {
+		return false;
+	}
+	std::string magic(sizeof(cache_magic) - 1, '\0');
+	is.read(magic.data(), static_cast<std::streamsize>(magic.size()));
+	const auto version = is.get();
+	if (!is || magic != cache_magic || static_cast<std::uint64_t>(version) != cache_version) {
+		is.close();
+		return false;
+	}
+	// The file name is only a hash of the inputs, so check that the entry has the same inputs.
+	try {
+		if (read_string(is, get_remaining_bytes(is)) == inputs_) {
+			return true;
+		}
+	} catch (const std::exception &) {
+	}
+	is.close();
+	return false;
+}
+
+void
+ArtifactCache::store(const ProductAutomaton &plant, const SpecificationATA &ata) const
+{
+	std::filesystem::create_directories(directory_);
+	auto tmp_path = path_;
+	tmp_path += fmt::format(".{}.tmp", getpid());
+	{
+		std::ofstream os(tmp_path, std::ios::binary);
+		os.write(cache_magic, sizeof(cache_magic) - 1);
+		os.put(static_cast<char>(cache_version));
+		write_string(os, inputs_);
+		write_product_automaton(os, plant);
+		write_specification_ata(os, ata);
+		if (!os) {
+			throw std::invalid_argument(
+			  fmt::format("Failed to write the cache entry '{}'", tmp_path.c_str()));
+		}
+	}
+	std::filesystem::rename(tmp_path, path_);
+}
+
+} // namespace app
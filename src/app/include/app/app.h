@@ -17,43 +17,155 @@
  *  Read the full text in the LICENSE.md file.
  */
 
+#pragma once
+
+#include "app/artifact_cache.h"
+#include "utilities/proto_format.h"
+
 #include <google/protobuf/message.h>
 
+#include <cstdint>
 #include <filesystem>
+#include <vector>
 
 namespace app {
 
+using utilities::get_proto_format;
+using utilities::ProtoFormat;
+
 /** @brief Launcher for the main application.
  * The launcher runs the main application, reads the input from pbtxt files, runs the search, and
  * finally generates a controller.*/
 class Launcher
 {
 public:
+	/** The search engines that can synthesize a controller. */
+	enum class Engine {
+		/** The region abstraction of the ATA, which is always sound. */
+		REGIONS,
+		/** Digital clocks, which are only used for closed constraints. */
+		DIGITAL_CLOCKS,
+		/** A deterministic monitor of the specification instead of the ATA. */
+		MONITOR,
+	};
+
 	/** Initialize the launcher with the given command line arguments.
 	 * @param argc The number of arguments, as passed to main()
 	 * @param argv The arguments, as passed to main()
+	 * @param memory_cache If set, reuse the plant and the ATA of earlier runs with the same inputs
 	 */
-	Launcher(int argc, const char *const argv[]);
+	Launcher(int argc, const char *const argv[], MemoryCache *memory_cache = nullptr);
 
 	/** Run the launcher. */
 	void run();
 
+	/** Check whether the command line asks for the help message, which run() prints.
+	 * @return true if --help was given
+	 */
+	bool
+	is_help_requested() const
+	{
+		return !help.empty();
+	}
+
+	/** Check whether the command line asks to serve requests instead of a single run.
+	 * @see Server
+	 * @return true if --server was given
+	 */
+	bool
+	is_server_requested() const
+	{
+		return serve_requests;
+	}
+
+	/** Get the engine that synthesized the controller of the last run().
+	 * This is the region engine if the controller of the digital clock engine failed the
+	 * verification in dense time.
+	 * @return The engine of the written controller
+	 */
+	Engine
+	get_engine() const
+	{
+		return engine;
+	}
+
 private:
+	struct Synthesis;
+
 	void parse_command_line(int argc, const char *const argv[]);
 
+	/** Run the search with the engine selected by the options and create the controller.
+	 * @param plant The plant to control
+	 * @param spec The specification of undesired behaviors
+	 * @param ata The ATA of the specification
+	 * @param aps The atomic propositions of the specification
+	 * @param environment_actions The actions of the plant that are not controllable
+	 * @param K The largest constant of the plant and the specification
+	 * @param allow_digital_clocks Whether the digital clock engine may be used
+	 * @return The controller together with the search and the engine that created it
+	 */
+	Synthesis synthesize(const ProductAutomaton &                              plant,
+	                     const logic::MTLFormula<std::string> &                spec,
+	                     SpecificationATA &                                    ata,
+	                     const std::set<logic::AtomicProposition<std::string>> &aps,
+	                     const std::set<std::string> &                         environment_actions,
+	                     automata::Time                                        K,
+	                     bool                                                  allow_digital_clocks);
+
 	std::filesystem::path plant_path;
 	std::filesystem::path specification_path;
 	std::filesystem::path controller_dot_path;
 	std::filesystem::path controller_proto_path;
+	std::filesystem::path controller_locations_path;
+	std::filesystem::path controller_cpp_path;
 	std::filesystem::path plant_dot_graph;
 	std::filesystem::path tree_dot_graph;
-	bool                  show_help{false};
+	std::filesystem::path tree_export_path;
+	std::filesystem::path cache_dir;
+	std::string           help;
+	bool                  serve_requests{false};
 	bool                  multi_threaded{true};
 	bool                  hide_controller_labels{false};
+	bool                  use_monitor{false};
+	bool                  minimize_controller{false};
+	bool                  minimize_plant{false};
+	bool                  slice_plant{false};
+	bool                  normalize_constants{false};
+	bool                  stream_controller{false};
+	bool                  verify{false};
+	bool                  digital_clocks{false};
+	bool                  find_minimal_controller_actions{false};
 	std::set<std::string> controller_actions;
 	std::string           heuristic;
+	std::uint64_t         ticks_per_time_unit{2};
+	std::size_t           dot_max_depth{0};
+	std::size_t           dot_max_children{0};
+	std::size_t           dot_max_label_length{0};
+	ProtoFormat           proto_format{ProtoFormat::AUTO};
+	Engine                engine{Engine::REGIONS};
+
+	std::vector<std::set<std::string>> controllable_partitions;
+	MemoryCache *                      memory_cache{nullptr};
 };
 
-void read_proto_from_file(const std::filesystem::path &path, google::protobuf::Message *output);
+/** Read a proto from a file.
+ * The file is memory-mapped and parsed without copying it into an intermediate buffer. As protobuf
+ * cannot parse messages of 2 GiB or more, larger files are rejected.
+ * @param path The path of the file to read
+ * @param output The message to parse into
+ * @param format The format of the file, AUTO to determine it from the extension
+ */
+void read_proto_from_file(const std::filesystem::path &path,
+                          google::protobuf::Message *  output,
+                          ProtoFormat                  format = ProtoFormat::AUTO);
+
+/** Write a proto to a file.
+ * @param path The path of the file to write
+ * @param message The message to write
+ * @param format The format of the file, AUTO to determine it from the extension
+ */
+void write_proto_to_file(const std::filesystem::path &  path,
+                         const google::protobuf::Message &message,
+                         ProtoFormat                      format = ProtoFormat::AUTO);
 
 } // namespace app
@@ -0,0 +1,172 @@
+/***************************************************************************
+ *  artifact_cache.h - Cache the product plant and the translated ATA on disk
+ *
+ *  Created:   Mon 19 Oct 03:27:51 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "automata/ata.h"
+#include "automata/ta.h"
+#include "mtl/MTLFormula.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace app {
+
+/** The type of the plant, i.e., the product of the plant components. */
+using ProductAutomaton = automata::ta::TimedAutomaton<std::vector<std::string>, std::string>;
+
+/** The type of the ATA translated from the specification. */
+using SpecificationATA =
+  automata::ata::AlternatingTimedAutomaton<logic::MTLFormula<std::string>,
+                                           logic::AtomicProposition<std::string>>;
+
+/** The offset basis of the 64-bit FNV-1a hash. */
+constexpr std::uint64_t fnv1a_offset_basis = 14695981039346656037ULL;
+
+/** The prime of the 64-bit FNV-1a hash. */
+constexpr std::uint64_t fnv1a_prime = 1099511628211ULL;
+
+/** Compute the 64-bit FNV-1a hash of some data.
+ * @param data The data to hash
+ * @param hash The hash to continue, which allows to hash several pieces of data in sequence
+ * @return The hash of the data
+ */
+constexpr std::uint64_t
+fnv1a_hash(std::string_view data, std::uint64_t hash = fnv1a_offset_basis)
+{
+	for (const char c : data) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= fnv1a_prime;
+	}
+	return hash;
+}
+
+/** Get a stamp of the build that computes the cached artifacts.
+ * The stamp consists of the version of the cache format and the path, size, and modification time
+ * of each shared library that computes the artifacts, e.g., the MTL to ATA translation. Thus, a
+ * rebuild of these libraries invalidates all cache entries.
+ * @return The build stamp
+ */
+std::string get_build_stamp();
+
+/** Get the inputs that determine the plant product and the ATA.
+ * @param plant_path The path of the plant file
+ * @param specification_path The path of the specification file
+ * @param options The options that influence the artifacts
+ * @return An unambiguous encoding of the build stamp, the options, and the file contents
+ */
+std::string get_cache_inputs(const std::filesystem::path &plant_path,
+                             const std::filesystem::path &specification_path,
+                             const std::string &          options);
+
+/** Write a product automaton in the binary cache format.
+ * @param os The stream to write to
+ * @param ta The automaton to write
+ */
+void write_product_automaton(std::ostream &os, const ProductAutomaton &ta);
+
+/** Read a product automaton in the binary cache format.
+ * All counts and lengths are checked against the remaining size of the stream, which must be
+ * seekable, so a corrupt entry fails with std::invalid_argument instead of a huge allocation.
+ * @param is The stream to read from
+ * @return The read automaton
+ */
+ProductAutomaton read_product_automaton(std::istream &is);
+
+/** Write a specification ATA in the binary cache format.
+ * @param os The stream to write to
+ * @param ata The ATA to write
+ */
+void write_specification_ata(std::ostream &os, const SpecificationATA &ata);
+
+/** Read a specification ATA in the binary cache format.
+ * All counts and lengths are checked against the remaining size of the stream, which must be
+ * seekable, so a corrupt entry fails with std::invalid_argument instead of a huge allocation.
+ * @param is The stream to read from
+ * @return The read ATA
+ */
+SpecificationATA read_specification_ata(std::istream &is);
+
+/** @brief A content-addressed cache of the product plant and the specification ATA.
+ * Each entry is a single file in the cache directory, named by the FNV-1a hash of its inputs. The
+ * inputs must contain everything that determines the cached artifacts, see get_cache_inputs. An
+ * entry consists of a header, the inputs, the product automaton, and the ATA, all encoded with
+ * LEB128 varints. As the hash may collide, an entry is only used if its inputs are the same.
+ * Floating point values are stored in the native byte order, so the cache must not be shared
+ * between different architectures.
+ */
+class ArtifactCache
+{
+public:
+	/** Create a cache entry handle.
+	 * @param directory The directory that contains the cache entries
+	 * @param inputs The inputs that determine the artifacts of the entry
+	 */
+	ArtifactCache(const std::filesystem::path &directory, std::string inputs);
+
+	/** Get the path of the cache entry.
+	 * @return The path of the file that contains the entry
+	 */
+	const std::filesystem::path &
+	get_path() const
+	{
+		return path_;
+	}
+
+	/** Open the cache entry for reading.
+	 * @param is The stream to open, positioned after the header on success
+	 * @return true if the entry exists, has a valid header, and has the same inputs
+	 */
+	bool open(std::ifstream &is) const;
+
+	/** Store the artifacts in the cache entry.
+	 * The entry is first written to a temporary file and then renamed, so concurrent runs never
+	 * read a partially written entry.
+	 * @param plant The product plant to store
+	 * @param ata The specification ATA to store
+	 */
+	void store(const ProductAutomaton &plant, const SpecificationATA &ata) const;
+
+private:
+	std::filesystem::path directory_;
+	std::filesystem::path path_;
+	std::string           inputs_;
+};
+
+/** The product plant and the specification ATA of one set of inputs, shared between runs. */
+struct CachedArtifacts
+{
+	/** The product plant before the constants are normalized. */
+	std::shared_ptr<const ProductAutomaton> plant;
+	/** The ATA translated from the normalized specification. */
+	std::shared_ptr<SpecificationATA> ata;
+};
+
+/** An in-memory cache of artifacts by their inputs, e.g., to keep them warm in a server. */
+using MemoryCache = std::unordered_map<std::string, CachedArtifacts>;
+
+} // namespace app
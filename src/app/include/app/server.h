@@ -0,0 +1,77 @@
+/***************************************************************************
+ *  server.h - Serve synthesis requests from a long-running process
+ *
+ *  Created:   Mon 19 Oct 04:12:36 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "app/app.h"
+#include "app/artifact_cache.h"
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace app {
+
+/** @brief Serve synthesis requests with a line-based protocol.
+ * Each request is a single line with the command line arguments of an mtlsyn invocation, e.g.,
+ * `--plant plant.pbtxt --spec spec.pbtxt -c c --verify -o controller.pbtxt`. Arguments may be
+ * quoted as in a Unix shell. Thus, the server supports everything that a single run supports, e.g.,
+ * synthesis, verification, and monitors, except for `--help` and `--server`. The server keeps the
+ * plant product and the translated specification of each request in memory, so later requests with
+ * the same inputs skip directly to the search. For each request, the server writes one response
+ * line:
+ * - `ok <request> <latency>` if the request succeeded
+ * - `error <request> <latency> <message>` if the request failed
+ * The request number starts at 1 and the latency is given in milliseconds. Empty lines and lines
+ * starting with '#' are ignored. The server stops at the end of the input or at a line `quit`.
+ */
+class Server
+{
+public:
+	/** Create a server.
+	 * @param input The stream to read requests from
+	 * @param output The stream to write responses to
+	 */
+	Server(std::istream &input, std::ostream &output);
+
+	/** Serve requests until the input ends.
+	 * @return The number of served requests
+	 */
+	std::size_t run();
+
+	/** Get the artifacts that are kept in memory.
+	 * @return The in-memory cache of the server
+	 */
+	const MemoryCache &
+	get_memory_cache() const
+	{
+		return memory_cache_;
+	}
+
+private:
+	void handle_request(const std::string &request);
+
+	std::istream &input_;
+	std::ostream &output_;
+	MemoryCache   memory_cache_;
+	std::size_t   num_requests_{0};
+};
+
+} // namespace app
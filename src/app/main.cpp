@@ -18,9 +18,12 @@
  */
 
 #include "app/app.h"
+#include "app/server.h"
 
+#include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
+#include <iostream>
 #include <stdexcept>
 
 int
@@ -28,6 +31,13 @@ main(int argc, const char *const argv[])
 {
 	try {
 		app::Launcher launcher{argc, argv};
+		if (launcher.is_server_requested()) {
+			// Responses are written to stdout, so log to stderr.
+			spdlog::set_default_logger(spdlog::stderr_color_mt("mtlsyn"));
+			app::Server server{std::cin, std::cout};
+			server.run();
+			return 0;
+		}
 		launcher.run();
 		return 0;
 	} catch (const std::exception &e) {
@@ -0,0 +1,89 @@
+/***************************************************************************
+ *  server.cpp - Serve synthesis requests from a long-running process
+ *
+ *  Created:   Mon 19 Oct 04:12:36 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "app/server.h"
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <boost/program_options/parsers.hpp>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+namespace app {
+
+Server::Server(std::istream &input, std::ostream &output) : input_(input), output_(output)
+{
+}
+
+std::size_t
+Server::run()
+{
+	std::string line;
+	while (std::getline(input_, line)) {
+		const auto begin = line.find_first_not_of(" \t\r");
+		if (begin == std::string::npos || line[begin] == '#') {
+			continue;
+		}
+		const auto request = line.substr(begin, line.find_last_not_of(" \t\r") - begin + 1);
+		if (request == "quit") {
+			break;
+		}
+		handle_request(request);
+	}
+	return num_requests_;
+}
+
+void
+Server::handle_request(const std::string &request)
+{
+	const auto id             = ++num_requests_;
+	const auto start          = std::chrono::steady_clock::now();
+	const auto get_latency_ms = [&start]() {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+		  .count();
+	};
+	try {
+		auto arguments = boost::program_options::split_unix(request);
+		arguments.insert(std::begin(arguments), "mtlsyn");
+		std::vector<const char *> argv;
+		for (const auto &argument : arguments) {
+			argv.push_back(argument.c_str());
+		}
+		SPDLOG_INFO("Request {}: {}", id, request);
+		Launcher launcher{static_cast<int>(argv.size()), argv.data(), &memory_cache_};
+		// Both would write to the output stream and break the protocol.
+		if (launcher.is_help_requested()) {
+			throw std::invalid_argument("The help message is not available in requests");
+		}
+		if (launcher.is_server_requested()) {
+			throw std::invalid_argument("Cannot start a server within a request");
+		}
+		launcher.run();
+		output_ << fmt::format("ok {} {:.3f}", id, get_latency_ms()) << std::endl;
+	} catch (const std::exception &e) {
+		std::string message = e.what();
+		std::replace(std::begin(message), std::end(message), '\n', ' ');
+		output_ << fmt::format("error {} {:.3f} {}", id, get_latency_ms(), message) << std::endl;
+	}
+}
+
+} // namespace app
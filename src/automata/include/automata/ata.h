@@ -131,6 +131,13 @@ public:
 	           const SymbolT &                     symbol,
 	           std::unique_ptr<Formula<LocationT>> formula);
 
+	/** Get the formula that determines the configuration after this transition. */
+	[[nodiscard]] const Formula<LocationT> &
+	get_formula() const
+	{
+		return *formula_;
+	}
+
 public:
 	/// The source location of the transition
 	const LocationT source_;
@@ -173,6 +180,34 @@ public:
 		return alphabet_;
 	}
 
+	/** Get the initial location of the automaton. */
+	[[nodiscard]] const LocationT &
+	get_initial_location() const
+	{
+		return initial_location_;
+	}
+
+	/** Get the locations where the automaton is accepting. */
+	[[nodiscard]] const std::set<LocationT> &
+	get_final_locations() const
+	{
+		return final_locations_;
+	}
+
+	/** Get the transitions of the automaton. */
+	[[nodiscard]] const std::set<Transition<LocationT, SymbolT>> &
+	get_transitions() const
+	{
+		return transitions_;
+	}
+
+	/** Get the sink location, if the automaton has one. */
+	[[nodiscard]] const std::optional<LocationT> &
+	get_sink_location() const
+	{
+		return sink_location_;
+	}
+
 	/** Compute the resulting configurations after making a symbol step.
 	 * @param start_states The starting configuration
 	 * @param symbol The symbol to read
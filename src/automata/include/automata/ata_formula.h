@@ -188,6 +188,13 @@ public:
 	                                                  const ClockValuation &            v) const override;
 	std::set<std::set<State<LocationT>>> get_minimal_models(const ClockValuation &v) const override;
 
+	/** Get the location that must be in the configuration. */
+	const LocationT &
+	get_location() const
+	{
+		return location_;
+	}
+
 protected:
 	/** Print a LocationFormula to an ostream
 	 * @param os The ostream to print to
@@ -216,6 +223,13 @@ public:
 	bool is_satisfied(const std::set<State<LocationT>> &, const ClockValuation &v) const override;
 	std::set<std::set<State<LocationT>>> get_minimal_models(const ClockValuation &v) const override;
 
+	/** Get the clock constraint that must be satisfied. */
+	const ClockConstraint &
+	get_constraint() const
+	{
+		return constraint_;
+	}
+
 protected:
 	/** Print a ClockConstraintFormula to an ostream
 	 * @param os The ostream to print to
@@ -250,6 +264,20 @@ public:
 
 	std::set<std::set<State<LocationT>>> get_minimal_models(const ClockValuation &v) const override;
 
+	/** Get the first conjunct. */
+	const Formula<LocationT> &
+	get_conjunct1() const
+	{
+		return *conjunct1_;
+	}
+
+	/** Get the second conjunct. */
+	const Formula<LocationT> &
+	get_conjunct2() const
+	{
+		return *conjunct2_;
+	}
+
 protected:
 	/** Print a ConjunctionFormula to an ostream
 	 * @param os The ostream to print to
@@ -284,6 +312,20 @@ public:
 	                                                  const ClockValuation &            v) const override;
 	std::set<std::set<State<LocationT>>> get_minimal_models(const ClockValuation &v) const override;
 
+	/** Get the first disjunct. */
+	const Formula<LocationT> &
+	get_disjunct1() const
+	{
+		return *disjunct1_;
+	}
+
+	/** Get the second disjunct. */
+	const Formula<LocationT> &
+	get_disjunct2() const
+	{
+		return *disjunct2_;
+	}
+
 protected:
 	/** Print a DisjunctionFormula to an ostream
 	 * @param os The ostream to print to
@@ -315,6 +357,13 @@ public:
 	                                                  const ClockValuation &) const override;
 	std::set<std::set<State<LocationT>>> get_minimal_models(const ClockValuation &) const override;
 
+	/** Get the sub-formula that is evaluated with a reset clock. */
+	const Formula<LocationT> &
+	get_sub_formula() const
+	{
+		return *sub_formula_;
+	}
+
 protected:
 	/** Print a ResetClockFormula to an ostream
 	 * @param os The ostream to print to
@@ -0,0 +1,72 @@
+/***************************************************************************
+ *  ta_minimization.h - Minimize timed automata by bisimulation
+ *
+ *  Created:   Sun 18 Oct 14:05:12 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "ta.h"
+#include "ta_reachability.h"
+#include "ta_regions.h"
+
+#include <map>
+#include <optional>
+#include <string>
+
+namespace automata::ta {
+
+/** @brief Merge transitions whose guards can be combined into a single guard.
+ * Two transitions with the same source, symbol, target, and clock resets are merged if their guards
+ * only differ in the constraints on a single clock and the allowed intervals of that clock overlap
+ * or are adjacent, or if one guard subsumes the other. Transitions that can never be taken because
+ * their guard is unsatisfiable are removed. The resulting TA accepts the same timed language.
+ * @param ta The timed automaton to simplify
+ * @return A timed automaton with the same locations and the merged transitions
+ */
+template <typename LocationT, typename AP>
+TimedAutomaton<LocationT, AP> coalesce_guards(const TimedAutomaton<LocationT, AP> &ta);
+
+/** @brief Remove all locations that are not reachable from the initial location.
+ * Transitions with an unsatisfiable guard are removed as well, as they can never be taken. A
+ * location is reachable if it is the target of a path of the remaining transitions that starts
+ * in the initial location. All transitions from unreachable locations are removed. The resulting
+ * TA accepts the same timed language.
+ * @param ta The timed automaton to simplify
+ * @return A timed automaton with only the reachable locations and their satisfiable transitions
+ * @see get_reachable_locations
+ */
+template <typename LocationT, typename AP>
+TimedAutomaton<LocationT, AP>
+remove_unreachable_locations(const TimedAutomaton<LocationT, AP> &ta);
+
+/** @brief Minimize a timed automaton by merging bisimilar locations.
+ * Two locations are bisimilar if they are either both final or both non-final, and for each
+ * transition of one location, the other location has a transition with the same symbol, guard, and
+ * resets into a bisimilar location. The coarsest such partition is computed by partition
+ * refinement. Each class is replaced by its smallest location. Guards are coalesced with
+ * coalesce_guards before each refinement, which may uncover further bisimilar locations; both steps
+ * are repeated until the automaton does not change anymore.
+ * @param ta The timed automaton to minimize
+ * @return A timed automaton with the same timed language and at most as many locations and
+ * transitions as the input
+ */
+template <typename LocationT, typename AP>
+TimedAutomaton<LocationT, AP> minimize(const TimedAutomaton<LocationT, AP> &ta);
+
+} // namespace automata::ta
+
+#include "ta_minimization.hpp"
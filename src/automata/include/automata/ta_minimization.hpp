@@ -0,0 +1,274 @@
+/***************************************************************************
+ *  ta_minimization.hpp - Minimize timed automata by bisimulation
+ *
+ *  Created:   Sun 18 Oct 14:05:12 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "ta_minimization.h"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <tuple>
+#include <vector>
+
+namespace automata::ta {
+
+namespace details {
+
+/** Get the interval of a clock in a guard, clocks without constraints may have any value. */
+inline RegionInterval
+get_clock_interval(const std::map<std::string, RegionInterval> &intervals, const std::string &clock)
+{
+	if (auto it = intervals.find(clock); it != std::end(intervals)) {
+		return it->second;
+	}
+	return RegionInterval{};
+}
+
+/** Check whether the first interval is contained in the second interval. */
+inline bool
+is_subinterval(const RegionInterval &lhs, const RegionInterval &rhs)
+{
+	return lhs.lower >= rhs.lower && (!rhs.upper || (lhs.upper && *lhs.upper <= *rhs.upper));
+}
+
+/** Try to merge two guards, given as region intervals, into a single guard.
+ * @return The merged guard if the union of both guards can be expressed as a single guard
+ */
+inline std::optional<std::map<std::string, RegionInterval>>
+merge_guards(const std::map<std::string, RegionInterval> &lhs,
+             const std::map<std::string, RegionInterval> &rhs)
+{
+	std::set<std::string> clocks;
+	for (const auto &[clock, interval] : lhs) {
+		clocks.insert(clock);
+	}
+	for (const auto &[clock, interval] : rhs) {
+		clocks.insert(clock);
+	}
+	bool                     lhs_subsumed = true;
+	bool                     rhs_subsumed = true;
+	std::vector<std::string> differing_clocks;
+	for (const auto &clock : clocks) {
+		const auto lhs_interval = get_clock_interval(lhs, clock);
+		const auto rhs_interval = get_clock_interval(rhs, clock);
+		lhs_subsumed &= is_subinterval(lhs_interval, rhs_interval);
+		rhs_subsumed &= is_subinterval(rhs_interval, lhs_interval);
+		if (!(lhs_interval == rhs_interval)) {
+			differing_clocks.push_back(clock);
+		}
+	}
+	if (rhs_subsumed) {
+		return lhs;
+	}
+	if (lhs_subsumed) {
+		return rhs;
+	}
+	if (differing_clocks.size() != 1) {
+		return std::nullopt;
+	}
+	const auto &clock  = differing_clocks.front();
+	auto        first  = get_clock_interval(lhs, clock);
+	auto        second = get_clock_interval(rhs, clock);
+	if (second.lower < first.lower) {
+		std::swap(first, second);
+	}
+	if (first.upper && *first.upper + 1 < second.lower) {
+		// There is a gap between both intervals.
+		return std::nullopt;
+	}
+	RegionInterval merged{first.lower, std::nullopt};
+	if (first.upper && second.upper) {
+		merged.upper = std::max(*first.upper, *second.upper);
+	}
+	auto res = lhs;
+	if (merged == RegionInterval{}) {
+		res.erase(clock);
+	} else {
+		res[clock] = merged;
+	}
+	return res;
+}
+
+/** Compute the quotient of a TA with respect to its coarsest bisimulation.
+ * The guards of the TA must already be coalesced such that equal guards have equal constraints.
+ */
+template <typename LocationT, typename AP>
+TimedAutomaton<LocationT, AP>
+get_bisimulation_quotient(const TimedAutomaton<LocationT, AP> &ta)
+{
+	using Signature = std::set<
+	  std::tuple<AP, std::map<std::string, RegionInterval>, std::set<std::string>, std::size_t>>;
+	std::map<Location<LocationT>, std::size_t> partition;
+	for (const auto &location : ta.get_locations()) {
+		partition[location] = ta.get_final_locations().count(location) > 0 ? 1 : 0;
+	}
+	std::size_t num_classes = 0;
+	while (true) {
+		std::map<std::pair<std::size_t, Signature>, std::size_t> classes;
+		std::map<Location<LocationT>, std::size_t>               refined_partition;
+		for (const auto &location : ta.get_locations()) {
+			Signature signature;
+			for (auto [it, last] = ta.get_transitions().equal_range(location); it != last; ++it) {
+				const auto &transition = it->second;
+				signature.emplace(transition.symbol_,
+				                  get_region_intervals(transition.get_guards()),
+				                  transition.clock_resets_,
+				                  partition.at(transition.target_));
+			}
+			const auto [class_it, inserted] =
+			  classes.emplace(std::make_pair(partition.at(location), std::move(signature)),
+			                  classes.size());
+			refined_partition[location] = class_it->second;
+		}
+		partition = std::move(refined_partition);
+		// Each round only splits classes, so the partition is stable if no class has been split.
+		if (classes.size() == num_classes) {
+			break;
+		}
+		num_classes = classes.size();
+	}
+	// Locations are iterated in order, so the first location of each class is its smallest one.
+	std::map<std::size_t, Location<LocationT>> representatives;
+	for (const auto &location : ta.get_locations()) {
+		representatives.emplace(partition.at(location), location);
+	}
+	const auto get_representative = [&](const Location<LocationT> &location) {
+		return representatives.at(partition.at(location));
+	};
+	std::set<Location<LocationT>> locations;
+	std::set<Location<LocationT>> final_locations;
+	for (const auto &[partition_class, location] : representatives) {
+		locations.insert(location);
+		if (ta.get_final_locations().count(location) > 0) {
+			final_locations.insert(location);
+		}
+	}
+	// Bisimilar locations have the same transitions, so it suffices to copy those of the
+	// representatives.
+	std::set<Transition<LocationT, AP>> transitions;
+	for (const auto &location : locations) {
+		for (auto [it, last] = ta.get_transitions().equal_range(location); it != last; ++it) {
+			const auto &transition = it->second;
+			transitions.insert(Transition<LocationT, AP>{location,
+			                                             transition.symbol_,
+			                                             get_representative(transition.target_),
+			                                             transition.get_guards(),
+			                                             transition.clock_resets_});
+		}
+	}
+	return TimedAutomaton<LocationT, AP>{locations,
+	                                     ta.get_alphabet(),
+	                                     get_representative(ta.get_initial_location()),
+	                                     final_locations,
+	                                     ta.get_clocks(),
+	                                     {std::begin(transitions), std::end(transitions)}};
+}
+
+} // namespace details
+
+template <typename LocationT, typename AP>
+TimedAutomaton<LocationT, AP>
+coalesce_guards(const TimedAutomaton<LocationT, AP> &ta)
+{
+	using GuardIntervals = std::map<std::string, RegionInterval>;
+	std::map<std::tuple<Location<LocationT>, AP, Location<LocationT>, std::set<std::string>>,
+	         std::vector<GuardIntervals>>
+	  guards;
+	for (const auto &[source, transition] : ta.get_transitions()) {
+		auto intervals = get_region_intervals(transition.get_guards());
+		if (std::any_of(std::begin(intervals), std::end(intervals), [](const auto &interval) {
+			    return is_empty(interval.second);
+		    })) {
+			continue;
+		}
+		guards[std::make_tuple(
+		         transition.source_, transition.symbol_, transition.target_, transition.clock_resets_)]
+		  .push_back(std::move(intervals));
+	}
+	std::vector<Transition<LocationT, AP>> transitions;
+	for (auto &[key, group] : guards) {
+		// Merge pairs of guards until no more pairs can be merged.
+		bool changed = true;
+		while (changed) {
+			changed = false;
+			for (std::size_t i = 0; i < group.size() && !changed; ++i) {
+				for (std::size_t j = i + 1; j < group.size() && !changed; ++j) {
+					if (auto merged = details::merge_guards(group[i], group[j]); merged) {
+						group[i] = std::move(*merged);
+						group.erase(std::next(std::begin(group), j));
+						changed = true;
+					}
+				}
+			}
+		}
+		const auto &[source, symbol, target, resets] = key;
+		for (const auto &intervals : group) {
+			transitions.push_back(Transition<LocationT, AP>{
+			  source, symbol, target, get_guard_from_region_intervals(intervals), resets});
+		}
+	}
+	return TimedAutomaton<LocationT, AP>{ta.get_locations(),
+	                                     ta.get_alphabet(),
+	                                     ta.get_initial_location(),
+	                                     ta.get_final_locations(),
+	                                     ta.get_clocks(),
+	                                     transitions};
+}
+
+template <typename LocationT, typename AP>
+TimedAutomaton<LocationT, AP>
+remove_unreachable_locations(const TimedAutomaton<LocationT, AP> &ta)
+{
+	const auto                             reachable = get_reachable_locations(ta);
+	std::vector<Transition<LocationT, AP>> transitions;
+	for (const auto &[source, transition] : ta.get_transitions()) {
+		if (reachable.count(source) > 0 && has_satisfiable_guard(transition)) {
+			transitions.push_back(transition);
+		}
+	}
+	std::set<Location<LocationT>> final_locations;
+	std::set_intersection(std::begin(ta.get_final_locations()),
+	                      std::end(ta.get_final_locations()),
+	                      std::begin(reachable),
+	                      std::end(reachable),
+	                      std::inserter(final_locations, std::end(final_locations)));
+	return TimedAutomaton<LocationT, AP>{reachable,
+	                                     ta.get_alphabet(),
+	                                     ta.get_initial_location(),
+	                                     final_locations,
+	                                     ta.get_clocks(),
+	                                     transitions};
+}
+
+template <typename LocationT, typename AP>
+TimedAutomaton<LocationT, AP>
+minimize(const TimedAutomaton<LocationT, AP> &ta)
+{
+	const auto coalesced = coalesce_guards(ta);
+	const auto quotient  = coalesce_guards(details::get_bisimulation_quotient(coalesced));
+	if (quotient.get_locations().size() == coalesced.get_locations().size()
+	    && quotient.get_transitions().size() == coalesced.get_transitions().size()) {
+		return quotient;
+	}
+	// Merging locations may have made more guards adjacent, try again.
+	return minimize(quotient);
+}
+
+} // namespace automata::ta
@@ -88,6 +88,21 @@ TimedAutomaton<std::vector<LocationT>, ActionT>
 get_product(const std::vector<TimedAutomaton<LocationT, ActionT>> &automata,
             const std::set<ActionT> &                              synchronized_actions = {});
 
+/** Extend a product automaton by an observer that synchronizes on every action.
+ * Each transition of the product is combined with each transition of the observer that reads the
+ * same action. The resulting location is the product location extended by the observer location. A
+ * location is final iff both the product location and the observer location are final. Thus, if the
+ * observer is deterministic and complete, the result has the same behavior as the product, but it
+ * additionally tracks the observer's state.
+ * @param product The product automaton to extend
+ * @param observer The observer, which must use clocks disjoint from the product's clocks
+ * @return The extended product automaton
+ */
+template <typename LocationT, typename ActionT>
+TimedAutomaton<std::vector<LocationT>, ActionT>
+add_observer(const TimedAutomaton<std::vector<LocationT>, ActionT> &product,
+             const TimedAutomaton<LocationT, ActionT> &             observer);
+
 } // namespace automata::ta
 
 #include "ta_product.hpp"
@@ -239,4 +239,70 @@ get_product(const std::vector<TimedAutomaton<LocationT, ActionT>> &automata,
 	                                                       product_transitions};
 }
 
+template <typename LocationT, typename ActionT>
+TimedAutomaton<std::vector<LocationT>, ActionT>
+add_observer(const TimedAutomaton<std::vector<LocationT>, ActionT> &product,
+             const TimedAutomaton<LocationT, ActionT> &             observer)
+{
+	std::set<std::string> common_clocks;
+	std::set_intersection(begin(product.get_clocks()),
+	                      end(product.get_clocks()),
+	                      begin(observer.get_clocks()),
+	                      end(observer.get_clocks()),
+	                      std::inserter(common_clocks, end(common_clocks)));
+	if (!common_clocks.empty()) {
+		throw std::invalid_argument(
+		  fmt::format("Cannot add an observer with non-disjoint clocks, common clocks: {}",
+		              fmt::join(common_clocks, ", ")));
+	}
+	using ProductLocation = Location<std::vector<LocationT>>;
+	const auto extend     = [](const auto &product_location, const auto &observer_location) {
+		auto res = product_location.get();
+		res.push_back(observer_location.get());
+		return ProductLocation{res};
+	};
+	std::set<ProductLocation> locations;
+	std::set<ProductLocation> final_locations;
+	for (const auto &product_location : product.get_locations()) {
+		for (const auto &observer_location : observer.get_locations()) {
+			locations.insert(extend(product_location, observer_location));
+		}
+	}
+	for (const auto &product_location : product.get_final_locations()) {
+		for (const auto &observer_location : observer.get_final_locations()) {
+			final_locations.insert(extend(product_location, observer_location));
+		}
+	}
+	std::set<std::string> clocks = product.get_clocks();
+	clocks.insert(std::begin(observer.get_clocks()), std::end(observer.get_clocks()));
+	std::set<ActionT> alphabet = product.get_alphabet();
+	alphabet.insert(std::begin(observer.get_alphabet()), std::end(observer.get_alphabet()));
+	std::vector<Transition<std::vector<LocationT>, ActionT>> transitions;
+	for (const auto &[product_source, product_transition] : product.get_transitions()) {
+		for (const auto &[observer_source, observer_transition] : observer.get_transitions()) {
+			if (product_transition.symbol_ != observer_transition.symbol_) {
+				continue;
+			}
+			auto guards = product_transition.clock_constraints_;
+			guards.insert(std::begin(observer_transition.clock_constraints_),
+			              std::end(observer_transition.clock_constraints_));
+			auto resets = product_transition.clock_resets_;
+			resets.insert(std::begin(observer_transition.clock_resets_),
+			              std::end(observer_transition.clock_resets_));
+			transitions.emplace_back(extend(product_source, observer_source),
+			                         product_transition.symbol_,
+			                         extend(product_transition.target_, observer_transition.target_),
+			                         guards,
+			                         resets);
+		}
+	}
+	return TimedAutomaton<std::vector<LocationT>, ActionT>{
+	  locations,
+	  alphabet,
+	  extend(product.get_initial_location(), observer.get_initial_location()),
+	  final_locations,
+	  clocks,
+	  transitions};
+}
+
 } // namespace automata::ta
@@ -0,0 +1,66 @@
+/***************************************************************************
+ *  ta_reachability.h - Reachability analysis on the location graph of a TA
+ *
+ *  Created:   Sun 18 Oct 22:48:19 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "ta.h"
+#include "ta_regions.h"
+
+#include <set>
+
+namespace automata::ta {
+
+/** @brief Check whether a transition can be taken in some region.
+ * A transition can never be taken if the constraints of its guard on some clock contradict each
+ * other, e.g., x < 1 and x > 2.
+ * @param transition The transition to check
+ * @return true if some clock valuation satisfies the guard
+ */
+template <typename LocationT, typename AP>
+bool has_satisfiable_guard(const Transition<LocationT, AP> &transition);
+
+/** @brief Compute the locations that are reachable from the initial location.
+ * This only considers the location graph, i.e., it over-approximates the reachable locations of the
+ * TA. If check_guards is true, transitions with an unsatisfiable guard are ignored.
+ * @param ta The timed automaton
+ * @param check_guards If true, ignore transitions that can never be taken
+ * @return The set of reachable locations, including the initial location
+ */
+template <typename LocationT, typename AP>
+std::set<Location<LocationT>> get_reachable_locations(const TimedAutomaton<LocationT, AP> &ta,
+                                                      bool check_guards = true);
+
+/** @brief Compute the locations from which one of the given target locations is reachable.
+ * This is a backward reachability analysis on the location graph. As it over-approximates the
+ * reachable locations, no target is reachable from any location that is not in the result. If
+ * check_guards is true, transitions with an unsatisfiable guard are ignored.
+ * @param ta The timed automaton
+ * @param targets The target locations
+ * @param check_guards If true, ignore transitions that can never be taken
+ * @return The set of locations that may reach a target, including the targets themselves
+ */
+template <typename LocationT, typename AP>
+std::set<Location<LocationT>>
+get_coreachable_locations(const TimedAutomaton<LocationT, AP> &ta,
+                          const std::set<Location<LocationT>> &targets,
+                          bool                                 check_guards = true);
+
+} // namespace automata::ta
+
+#include "ta_reachability.hpp"
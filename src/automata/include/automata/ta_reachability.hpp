@@ -0,0 +1,91 @@
+/***************************************************************************
+ *  ta_reachability.hpp - Reachability analysis on the location graph of a TA
+ *
+ *  Created:   Sun 18 Oct 22:48:19 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "ta_reachability.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace automata::ta {
+
+template <typename LocationT, typename AP>
+bool
+has_satisfiable_guard(const Transition<LocationT, AP> &transition)
+{
+	const auto intervals = get_region_intervals(transition.get_guards());
+	return std::none_of(std::begin(intervals), std::end(intervals), [](const auto &interval) {
+		return is_empty(interval.second);
+	});
+}
+
+template <typename LocationT, typename AP>
+std::set<Location<LocationT>>
+get_reachable_locations(const TimedAutomaton<LocationT, AP> &ta, bool check_guards)
+{
+	std::set<Location<LocationT>>    reachable{ta.get_initial_location()};
+	std::vector<Location<LocationT>> queue{ta.get_initial_location()};
+	while (!queue.empty()) {
+		const auto location = queue.back();
+		queue.pop_back();
+		const auto [first, last] = ta.get_transitions().equal_range(location);
+		for (auto it = first; it != last; ++it) {
+			if (check_guards && !has_satisfiable_guard(it->second)) {
+				continue;
+			}
+			if (reachable.insert(it->second.target_).second) {
+				queue.push_back(it->second.target_);
+			}
+		}
+	}
+	return reachable;
+}
+
+template <typename LocationT, typename AP>
+std::set<Location<LocationT>>
+get_coreachable_locations(const TimedAutomaton<LocationT, AP> &ta,
+                          const std::set<Location<LocationT>> &targets,
+                          bool                                 check_guards)
+{
+	std::map<Location<LocationT>, std::vector<Location<LocationT>>> predecessors;
+	for (const auto &[source, transition] : ta.get_transitions()) {
+		if (check_guards && !has_satisfiable_guard(transition)) {
+			continue;
+		}
+		predecessors[transition.target_].push_back(source);
+	}
+	std::set<Location<LocationT>>    coreachable{targets};
+	std::vector<Location<LocationT>> queue{std::begin(targets), std::end(targets)};
+	while (!queue.empty()) {
+		const auto location = queue.back();
+		queue.pop_back();
+		if (const auto it = predecessors.find(location); it != std::end(predecessors)) {
+			for (const auto &predecessor : it->second) {
+				if (coreachable.insert(predecessor).second) {
+					queue.push_back(predecessor);
+				}
+			}
+		}
+	}
+	return coreachable;
+}
+
+} // namespace automata::ta
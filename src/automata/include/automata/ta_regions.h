@@ -25,6 +25,7 @@
 #include "utilities/numbers.h"
 
 #include <iostream>
+#include <optional>
 
 namespace automata::ta {
 
@@ -73,6 +74,47 @@ get_clock_constraints_from_region_index(ta::RegionIndex     region_index,
                                         ta::RegionIndex     max_region_index,
                                         ConstraintBoundType bound_type = ConstraintBoundType::BOTH);
 
+/** A contiguous set of region indexes of a single clock.
+ * The interval contains all region indexes i with lower <= i <= upper. If upper is not set, the
+ * interval is unbounded from above. If lower > upper, the interval is empty.
+ */
+struct RegionInterval
+{
+	RegionIndex                lower = 0; ///< the smallest region index in the interval
+	std::optional<RegionIndex> upper;     ///< the largest region index in the interval, if any
+};
+
+/** Compare two region intervals. */
+bool operator==(const RegionInterval &lhs, const RegionInterval &rhs);
+
+/** Compare two region intervals. */
+bool operator<(const RegionInterval &lhs, const RegionInterval &rhs);
+
+/** Check whether a region interval does not contain any region index.
+ * @param interval The interval to check
+ * @return true if the interval is empty
+ */
+bool is_empty(const RegionInterval &interval);
+
+/** @brief Compute the region indexes that satisfy a guard, separately for each clock.
+ * All constraints on the same clock are intersected. Clocks that are not constrained by the guard
+ * do not occur in the result.
+ * @param guard The clock constraints of a transition
+ * @return The interval of region indexes that each constrained clock may be in
+ * @throws std::invalid_argument if the guard contains an inequality constraint
+ */
+std::map<std::string, RegionInterval>
+get_region_intervals(const std::multimap<std::string, ClockConstraint> &guard);
+
+/** @brief Compute a guard that restricts each clock to the given region interval.
+ * This is the inverse of get_region_intervals, the resulting guard contains at most two
+ * constraints per clock.
+ * @param intervals The non-empty region interval of each constrained clock
+ * @return The clock constraints that describe the intervals
+ */
+std::multimap<std::string, ClockConstraint>
+get_guard_from_region_intervals(const std::map<std::string, RegionInterval> &intervals);
+
 } // namespace automata::ta
 
 #include "ta_regions.hpp"
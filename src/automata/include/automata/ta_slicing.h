@@ -0,0 +1,84 @@
+/***************************************************************************
+ *  ta_slicing.h - Remove the parts of a TA that cannot influence its behavior
+ *
+ *  Created:   Sun 18 Oct 23:41:05 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "ta.h"
+#include "ta_minimization.h"
+#include "ta_reachability.h"
+
+#include <set>
+#include <string>
+
+namespace automata::ta {
+
+/** @brief Get the clocks that occur in the guard of some transition.
+ * All other clocks are never compared, so their values do not influence the behavior of the TA.
+ * @param ta The timed automaton
+ * @return The clocks that occur in at least one guard
+ */
+template <typename LocationT, typename AP>
+std::set<std::string> get_constrained_clocks(const TimedAutomaton<LocationT, AP> &ta);
+
+/** @brief Get the actions that can occur in some run of the TA.
+ * An action can only occur if it is the symbol of a transition with a satisfiable guard that starts
+ * in a reachable location.
+ * @param ta The timed automaton
+ * @return The actions that may occur, a subset of the alphabet
+ * @see get_reachable_locations
+ */
+template <typename LocationT, typename AP>
+std::set<AP> get_enabled_actions(const TimedAutomaton<LocationT, AP> &ta);
+
+/** @brief Remove all clocks except the given ones, along with their guards and resets.
+ * If the given clocks are constrained clocks, the result accepts the same timed language. A TA
+ * needs at least one clock, so if none of the given clocks is a clock of the TA, one clock is kept
+ * without any guards and resets, i.e., it only measures the global time.
+ * @param ta The timed automaton
+ * @param clocks The clocks to keep
+ * @return The timed automaton with only the given clocks
+ */
+template <typename LocationT, typename AP>
+TimedAutomaton<LocationT, AP> restrict_clocks(const TimedAutomaton<LocationT, AP> &ta,
+                                              const std::set<std::string> &        clocks);
+
+/** @brief Check whether a TA never does anything and always accepts.
+ * An inert TA has no transition that can ever be taken and its initial location is final. In a
+ * product, such a component neither restricts the other components nor contributes any action, so
+ * it can be removed from the product.
+ * @param ta The timed automaton
+ * @return true if the TA is inert
+ */
+template <typename LocationT, typename AP>
+bool is_inert(const TimedAutomaton<LocationT, AP> &ta);
+
+/** @brief Compute the cone of influence of a TA.
+ * Remove all unreachable locations and all transitions that can never be taken, all clocks that
+ * do not occur in any guard, and all actions that can never occur. The result accepts the same
+ * timed language, but its canonical words contain fewer clocks and there are fewer actions to
+ * consider in each step.
+ * @param ta The timed automaton to slice
+ * @return The sliced timed automaton
+ */
+template <typename LocationT, typename AP>
+TimedAutomaton<LocationT, AP> slice(const TimedAutomaton<LocationT, AP> &ta);
+
+} // namespace automata::ta
+
+#include "ta_slicing.hpp"
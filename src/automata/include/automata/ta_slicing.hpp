@@ -0,0 +1,119 @@
+/***************************************************************************
+ *  ta_slicing.hpp - Remove the parts of a TA that cannot influence its behavior
+ *
+ *  Created:   Sun 18 Oct 23:41:05 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "ta_slicing.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <vector>
+
+namespace automata::ta {
+
+template <typename LocationT, typename AP>
+std::set<std::string>
+get_constrained_clocks(const TimedAutomaton<LocationT, AP> &ta)
+{
+	std::set<std::string> res;
+	for (const auto &[source, transition] : ta.get_transitions()) {
+		for (const auto &[clock, constraint] : transition.get_guards()) {
+			res.insert(clock);
+		}
+	}
+	return res;
+}
+
+template <typename LocationT, typename AP>
+std::set<AP>
+get_enabled_actions(const TimedAutomaton<LocationT, AP> &ta)
+{
+	std::set<AP> res;
+	const auto   reachable = remove_unreachable_locations(ta);
+	for (const auto &[source, transition] : reachable.get_transitions()) {
+		res.insert(transition.symbol_);
+	}
+	return res;
+}
+
+template <typename LocationT, typename AP>
+TimedAutomaton<LocationT, AP>
+restrict_clocks(const TimedAutomaton<LocationT, AP> &ta, const std::set<std::string> &clocks)
+{
+	std::vector<Transition<LocationT, AP>> transitions;
+	for (const auto &[source, transition] : ta.get_transitions()) {
+		std::multimap<std::string, ClockConstraint> guards;
+		std::copy_if(std::begin(transition.get_guards()),
+		             std::end(transition.get_guards()),
+		             std::inserter(guards, std::end(guards)),
+		             [&clocks](const auto &guard) { return clocks.count(guard.first) > 0; });
+		std::set<std::string> resets;
+		std::set_intersection(std::begin(transition.clock_resets_),
+		                      std::end(transition.clock_resets_),
+		                      std::begin(clocks),
+		                      std::end(clocks),
+		                      std::inserter(resets, std::end(resets)));
+		transitions.emplace_back(
+		  transition.source_, transition.symbol_, transition.target_, guards, resets);
+	}
+	std::set<std::string> kept_clocks;
+	std::set_intersection(std::begin(ta.get_clocks()),
+	                      std::end(ta.get_clocks()),
+	                      std::begin(clocks),
+	                      std::end(clocks),
+	                      std::inserter(kept_clocks, std::end(kept_clocks)));
+	if (kept_clocks.empty() && !ta.get_clocks().empty()) {
+		kept_clocks.insert(*std::begin(ta.get_clocks()));
+	}
+	return TimedAutomaton<LocationT, AP>{ta.get_locations(),
+	                                     ta.get_alphabet(),
+	                                     ta.get_initial_location(),
+	                                     ta.get_final_locations(),
+	                                     kept_clocks,
+	                                     transitions};
+}
+
+template <typename LocationT, typename AP>
+bool
+is_inert(const TimedAutomaton<LocationT, AP> &ta)
+{
+	return ta.get_final_locations().count(ta.get_initial_location()) > 0
+	       && remove_unreachable_locations(ta).get_transitions().empty();
+}
+
+template <typename LocationT, typename AP>
+TimedAutomaton<LocationT, AP>
+slice(const TimedAutomaton<LocationT, AP> &ta)
+{
+	const auto reachable = remove_unreachable_locations(ta);
+	const auto sliced    = restrict_clocks(reachable, get_constrained_clocks(reachable));
+	std::vector<Transition<LocationT, AP>> transitions;
+	for (const auto &[source, transition] : sliced.get_transitions()) {
+		transitions.push_back(transition);
+	}
+	return TimedAutomaton<LocationT, AP>{sliced.get_locations(),
+	                                     get_enabled_actions(sliced),
+	                                     sliced.get_initial_location(),
+	                                     sliced.get_final_locations(),
+	                                     sliced.get_clocks(),
+	                                     transitions};
+}
+
+} // namespace automata::ta
@@ -21,6 +21,10 @@
 
 #include "automata/automata.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
 namespace automata::ta {
 
 RegionIndex
@@ -74,4 +78,88 @@ get_clock_constraints_from_region_index(ta::RegionIndex     region_index,
 	}
 }
 
+bool
+operator==(const RegionInterval &lhs, const RegionInterval &rhs)
+{
+	return std::tie(lhs.lower, lhs.upper) == std::tie(rhs.lower, rhs.upper);
+}
+
+bool
+operator<(const RegionInterval &lhs, const RegionInterval &rhs)
+{
+	return std::tie(lhs.lower, lhs.upper) < std::tie(rhs.lower, rhs.upper);
+}
+
+bool
+is_empty(const RegionInterval &interval)
+{
+	return interval.upper && interval.lower > *interval.upper;
+}
+
+std::map<std::string, RegionInterval>
+get_region_intervals(const std::multimap<std::string, ClockConstraint> &guard)
+{
+	std::map<std::string, RegionInterval> res;
+	for (const auto &[clock, constraint] : guard) {
+		auto &     interval  = res[clock];
+		const auto comparand =
+		  std::visit([](const auto &atomic) { return atomic.get_comparand(); }, constraint);
+		const auto restrict_lower = [&interval](RegionIndex lower) {
+			interval.lower = std::max(interval.lower, lower);
+		};
+		const auto restrict_upper = [&interval](RegionIndex upper) {
+			interval.upper = interval.upper ? std::min(*interval.upper, upper) : upper;
+		};
+		if (std::holds_alternative<AtomicClockConstraintT<std::less<Time>>>(constraint)) {
+			if (comparand == 0) {
+				// x < 0 is unsatisfiable.
+				restrict_lower(1);
+				restrict_upper(0);
+			} else {
+				restrict_upper(2 * comparand - 1);
+			}
+		} else if (std::holds_alternative<AtomicClockConstraintT<std::less_equal<Time>>>(constraint)) {
+			restrict_upper(2 * comparand);
+		} else if (std::holds_alternative<AtomicClockConstraintT<std::equal_to<Time>>>(constraint)) {
+			restrict_lower(2 * comparand);
+			restrict_upper(2 * comparand);
+		} else if (std::holds_alternative<AtomicClockConstraintT<std::greater_equal<Time>>>(
+		             constraint)) {
+			restrict_lower(2 * comparand);
+		} else if (std::holds_alternative<AtomicClockConstraintT<std::greater<Time>>>(constraint)) {
+			restrict_lower(2 * comparand + 1);
+		} else {
+			throw std::invalid_argument("Cannot compute the region interval of an inequality");
+		}
+	}
+	return res;
+}
+
+std::multimap<std::string, ClockConstraint>
+get_guard_from_region_intervals(const std::map<std::string, RegionInterval> &intervals)
+{
+	std::multimap<std::string, ClockConstraint> guard;
+	for (const auto &[clock, interval] : intervals) {
+		if (interval.upper && interval.lower == *interval.upper && interval.lower % 2 == 0) {
+			guard.emplace(clock, AtomicClockConstraintT<std::equal_to<Time>>(interval.lower / 2));
+			continue;
+		}
+		if (interval.lower > 0) {
+			if (interval.lower % 2 == 0) {
+				guard.emplace(clock, AtomicClockConstraintT<std::greater_equal<Time>>(interval.lower / 2));
+			} else {
+				guard.emplace(clock, AtomicClockConstraintT<std::greater<Time>>(interval.lower / 2));
+			}
+		}
+		if (interval.upper) {
+			if (*interval.upper % 2 == 0) {
+				guard.emplace(clock, AtomicClockConstraintT<std::less_equal<Time>>(*interval.upper / 2));
+			} else {
+				guard.emplace(clock, AtomicClockConstraintT<std::less<Time>>((*interval.upper + 1) / 2));
+			}
+		}
+	}
+	return guard;
+}
+
 } // namespace automata::ta
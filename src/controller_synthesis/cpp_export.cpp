@@ -0,0 +1,280 @@
+/***************************************************************************
+ *  cpp_export.cpp - Generate C++ code from decision tables
+ *
+ *  Created:   Sun 18 Oct 16:10:44 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "controller_synthesis/cpp_export.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cctype>
+#include <set>
+
+namespace controller_synthesis {
+
+namespace {
+
+const std::set<std::string> cpp_keywords{
+  "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break",
+  "case", "catch", "char", "class", "compl", "const", "constexpr", "const_cast", "continue",
+  "decltype", "default", "delete", "do", "double", "dynamic_cast", "else", "enum", "explicit",
+  "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int", "long",
+  "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or",
+  "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "return", "short",
+  "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch", "template",
+  "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename", "union",
+  "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq"};
+
+bool
+is_identifier(const std::string &name)
+{
+	if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front()))
+	    || cpp_keywords.count(name) > 0) {
+		return false;
+	}
+	return std::all_of(std::begin(name), std::end(name), [](char c) {
+		return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+	});
+}
+
+/** Check whether a name has the form of a fallback action identifier, i.e., A and digits. */
+bool
+is_fallback_identifier(const std::string &name)
+{
+	return name.size() > 1 && name.front() == 'A'
+	       && std::all_of(std::next(std::begin(name)), std::end(name), [](char c) {
+		          return std::isdigit(static_cast<unsigned char>(c));
+	          });
+}
+
+std::string
+get_action_identifier(const DecisionTable &table, ActionId action)
+{
+	// An action named like a fallback could collide with the fallback of another action, so it also
+	// gets a fallback, which is unique as it is determined by the action's ID.
+	if (is_identifier(table.actions[action]) && !is_fallback_identifier(table.actions[action])) {
+		return table.actions[action];
+	}
+	return fmt::format("A{}", action);
+}
+
+std::string
+escape(const std::string &name)
+{
+	std::string res;
+	for (const char c : name) {
+		switch (c) {
+		case '"': res += "\\\""; break;
+		case '\\': res += "\\\\"; break;
+		case '\n': res += "\\n"; break;
+		default: res += c;
+		}
+	}
+	return res;
+}
+
+std::string
+format_tick(Tick tick)
+{
+	return tick == unbounded_tick ? "unbounded" : std::to_string(tick);
+}
+
+/** Format a range of a table as initializer of a std::array. */
+template <typename Range, typename Formatter>
+std::string
+format_array(const Range &range, Formatter formatter)
+{
+	if (std::empty(range)) {
+		return "{}";
+	}
+	std::vector<std::string> elements;
+	for (const auto &element : range) {
+		elements.push_back(formatter(element));
+	}
+	return fmt::format("{{{{{}}}}}", fmt::join(elements, ", "));
+}
+
+std::string
+format_bounds(const std::vector<Tick> &bounds, std::size_t row, std::size_t num_clocks)
+{
+	return format_array(std::vector<Tick>(std::next(std::begin(bounds), row * num_clocks),
+	                                      std::next(std::begin(bounds), (row + 1) * num_clocks)),
+	                    format_tick);
+}
+
+} // namespace
+
+void
+export_to_cpp(const DecisionTable &table, std::ostream &os, const std::string &name_space)
+{
+	const auto num_clocks    = table.clocks.size();
+	const auto num_locations = table.locations.size();
+	const auto num_actions   = table.actions.size();
+	const auto identity      = [](const auto &value) { return fmt::format("{}", value); };
+	const auto quote = [](const std::string &name) { return fmt::format("\"{}\"", escape(name)); };
+
+	os << "// Generated by mtlsyn, do not edit.\n"
+	   << "#pragma once\n\n"
+	   << "#include <algorithm>\n#include <array>\n#include <cstddef>\n#include <cstdint>\n"
+	   << "#include <limits>\n\n";
+	os << "namespace " << name_space << " {\n\n";
+	os << "using Tick = std::uint64_t;\n\n"
+	   << "inline constexpr Tick        unbounded           = std::numeric_limits<Tick>::max();\n"
+	   << "inline constexpr Tick        ticks_per_time_unit = " << table.ticks_per_time_unit << ";\n"
+	   << "inline constexpr std::size_t num_clocks          = " << num_clocks << ";\n\n";
+
+	os << "enum class Location : std::uint32_t {\n";
+	for (std::size_t location = 0; location < num_locations; ++location) {
+		os << "\tL" << location << ",\n";
+	}
+	os << "};\n\n";
+	os << "enum class Action : std::uint32_t {\n";
+	for (ActionId action = 0; action < num_actions; ++action) {
+		os << "\t" << get_action_identifier(table, action) << ",\n";
+	}
+	os << "};\n\n";
+
+	os << "inline constexpr std::array<const char *, " << num_locations << "> location_names"
+	   << format_array(table.locations, quote) << ";\n";
+	os << "inline constexpr std::array<const char *, " << num_actions << "> action_names"
+	   << format_array(table.actions, quote) << ";\n";
+	os << "inline constexpr std::array<bool, " << num_actions << "> controller_actions"
+	   << format_array(table.controller_actions,
+	                   [](bool controllable) { return controllable ? "true" : "false"; })
+	   << ";\n";
+	os << "inline constexpr std::array<const char *, num_clocks> clock_names"
+	   << format_array(table.clocks, quote) << ";\n";
+	os << "inline constexpr Location initial_location = Location::L" << table.initial_location
+	   << ";\n\n";
+
+	os << "struct Row\n{\n"
+	   << "\tstd::array<Tick, num_clocks> lower;\n"
+	   << "\tstd::array<Tick, num_clocks> upper;\n"
+	   << "\tAction                       action;\n"
+	   << "\tLocation                     target;\n"
+	   << "\tstd::uint64_t                resets;\n"
+	   << "};\n\n";
+
+	os << "inline constexpr std::array<Row, " << table.get_num_rows() << "> rows{{\n";
+	for (std::size_t row = 0; row < table.get_num_rows(); ++row) {
+		os << "  Row{" << format_bounds(table.lower_bounds, row, num_clocks) << ", "
+		   << format_bounds(table.upper_bounds, row, num_clocks) << ", Action::"
+		   << get_action_identifier(table, table.row_actions[row]) << ", Location::L"
+		   << table.row_targets[row] << ", " << fmt::format("{:#x}", table.row_resets[row])
+		   << "},\n";
+	}
+	os << "}};\n\n";
+	os << "inline constexpr std::array<Tick, " << table.get_num_rows() << "> primary_upper_maxima"
+	   << format_array(table.primary_upper_maxima, format_tick) << ";\n";
+	os << "inline constexpr std::array<std::uint32_t, " << num_locations + 1 << "> location_offsets"
+	   << format_array(table.location_offsets, identity) << ";\n";
+	os << "inline constexpr std::array<std::uint32_t, " << num_locations << "> controller_row_ends"
+	   << format_array(table.controller_row_ends, identity) << ";\n";
+	os << "inline constexpr std::array<std::uint32_t, " << num_locations << "> primary_clocks"
+	   << format_array(table.primary_clocks, identity) << ";\n\n";
+
+	os << R"(namespace details {
+
+inline bool
+is_enabled(const Row &row, const std::array<Tick, num_clocks> &clocks)
+{
+	for (std::size_t clock = 0; clock != num_clocks; ++clock) {
+		if (clocks[clock] < row.lower[clock] || clocks[clock] > row.upper[clock]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+inline const Row *
+find_row(std::uint32_t                       first,
+         std::uint32_t                       last,
+         std::uint32_t                       primary_clock,
+         const std::array<Tick, num_clocks> &clocks,
+         bool                                any_action,
+         Action                              action)
+{
+	const Row *begin = rows.data() + first;
+	const Row *end   = rows.data() + last;
+	if constexpr (num_clocks > 0) {
+		end = std::upper_bound(
+		  begin, end, clocks[primary_clock], [primary_clock](Tick value, const Row &row) {
+			  return value < row.lower[primary_clock];
+		  });
+	}
+	while (end != begin) {
+		--end;
+		if constexpr (num_clocks > 0) {
+			// No row up to this one allows the value of the primary clock.
+			if (primary_upper_maxima[static_cast<std::size_t>(end - rows.data())]
+			    < clocks[primary_clock]) {
+				return nullptr;
+			}
+		}
+		if ((any_action || end->action == action) && is_enabled(*end, clocks)) {
+			return end;
+		}
+	}
+	return nullptr;
+}
+
+} // namespace details
+
+/** Get the transition of the controller action to take now, or nullptr if the controller waits. */
+inline const Row *
+next_transition(Location location, const std::array<Tick, num_clocks> &clocks)
+{
+	const auto index = static_cast<std::uint32_t>(location);
+	return details::find_row(location_offsets[index],
+	                         controller_row_ends[index],
+	                         primary_clocks[index],
+	                         clocks,
+	                         true,
+	                         Action{});
+}
+
+/** Get the transition that the controller follows if the given action occurs now, if any. */
+inline const Row *
+get_transition(Location location, Action action, const std::array<Tick, num_clocks> &clocks)
+{
+	const auto index        = static_cast<std::uint32_t>(location);
+	const bool controllable = controller_actions[static_cast<std::uint32_t>(action)];
+	return details::find_row(controllable ? location_offsets[index] : controller_row_ends[index],
+	                         controllable ? controller_row_ends[index] : location_offsets[index + 1],
+	                         primary_clocks[index],
+	                         clocks,
+	                         false,
+	                         action);
+}
+
+/** Reset the clocks of the given transition. */
+inline void
+reset_clocks(const Row &row, std::array<Tick, num_clocks> &clocks)
+{
+	for (std::size_t clock = 0; clock != num_clocks; ++clock) {
+		if ((row.resets >> clock) & 1) {
+			clocks[clock] = 0;
+		}
+	}
+}
+
+)";
+	os << "} // namespace " << name_space << "\n";
+}
+
+} // namespace controller_synthesis
@@ -0,0 +1,208 @@
+/***************************************************************************
+ *  decision_table.cpp - Flat decision tables of synthesized controllers
+ *
+ *  Created:   Sun 18 Oct 15:32:08 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "controller_synthesis/decision_table.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace controller_synthesis {
+
+namespace details {
+
+std::pair<Tick, Tick>
+get_tick_interval(const automata::ta::RegionInterval &interval, Tick ticks_per_time_unit)
+{
+	// Even region indexes correspond to integer values, odd ones to the open interval above.
+	const Tick lower =
+	  Tick{interval.lower / 2} * ticks_per_time_unit + (interval.lower % 2 == 0 ? 0 : 1);
+	if (!interval.upper) {
+		return {lower, unbounded_tick};
+	}
+	const auto upper_region = *interval.upper;
+	if (upper_region % 2 == 0) {
+		return {lower, Tick{upper_region / 2} * ticks_per_time_unit};
+	}
+	// The largest tick that is strictly smaller than the next integer.
+	return {lower, Tick{(upper_region + 1) / 2} * ticks_per_time_unit - 1};
+}
+
+namespace {
+
+std::uint32_t
+select_primary_clock(const std::vector<DecisionRow> &controller_rows,
+                     const std::vector<DecisionRow> &environment_rows,
+                     std::size_t                     num_clocks)
+{
+	std::uint32_t primary_clock  = 0;
+	std::size_t   max_num_bounds = 0;
+	for (std::size_t clock = 0; clock < num_clocks; ++clock) {
+		std::set<Tick> bounds;
+		for (const auto *rows : {&controller_rows, &environment_rows}) {
+			for (const auto &row : *rows) {
+				bounds.insert(row.lower[clock]);
+			}
+		}
+		if (bounds.size() > max_num_bounds) {
+			max_num_bounds = bounds.size();
+			primary_clock  = static_cast<std::uint32_t>(clock);
+		}
+	}
+	return primary_clock;
+}
+
+void
+append_rows(DecisionTable *table, std::vector<DecisionRow> &&rows, std::uint32_t primary_clock)
+{
+	// Without any clocks, there is no primary clock to sort by.
+	const auto get_primary_lower = [primary_clock](const DecisionRow &row) {
+		return row.lower.empty() ? Tick{0} : row.lower[primary_clock];
+	};
+	std::sort(std::begin(rows), std::end(rows), [&](const auto &lhs, const auto &rhs) {
+		const Tick lhs_primary = get_primary_lower(lhs);
+		const Tick rhs_primary = get_primary_lower(rhs);
+		return std::tie(lhs_primary, lhs.lower, lhs.upper, lhs.action, lhs.target)
+		       < std::tie(rhs_primary, rhs.lower, rhs.upper, rhs.action, rhs.target);
+	});
+	Tick primary_upper_maximum = 0;
+	for (auto &row : rows) {
+		std::copy(std::begin(row.lower), std::end(row.lower), std::back_inserter(table->lower_bounds));
+		std::copy(std::begin(row.upper), std::end(row.upper), std::back_inserter(table->upper_bounds));
+		primary_upper_maximum = std::max(primary_upper_maximum,
+		                                 row.upper.empty() ? unbounded_tick : row.upper[primary_clock]);
+		table->primary_upper_maxima.push_back(primary_upper_maximum);
+		table->row_actions.push_back(row.action);
+		table->row_targets.push_back(row.target);
+		table->row_resets.push_back(row.resets);
+	}
+}
+
+/** Check whether all clock values are within the bounds of the given row. */
+bool
+is_enabled(const DecisionTable &table, std::size_t row, const std::vector<Tick> &clock_values)
+{
+	const auto num_clocks = table.clocks.size();
+	for (std::size_t clock = 0; clock < num_clocks; ++clock) {
+		const auto value = clock_values[clock];
+		if (value < table.lower_bounds[row * num_clocks + clock]
+		    || value > table.upper_bounds[row * num_clocks + clock]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/** Find the last enabled row in [first, last) that satisfies the predicate.
+ * The rows must be sorted by the lower bound of the primary clock, and [first, last) must be one
+ * part of a location, as the running maxima of the primary clock start at the first row. */
+template <typename Predicate>
+std::optional<std::size_t>
+find_last_enabled_row(const DecisionTable &    table,
+                      std::size_t              first,
+                      std::size_t              last,
+                      std::uint32_t            primary_clock,
+                      const std::vector<Tick> &clock_values,
+                      Predicate                predicate)
+{
+	const auto num_clocks = table.clocks.size();
+	if (clock_values.size() != num_clocks) {
+		throw std::invalid_argument("Expected one value for each clock");
+	}
+	if (num_clocks > 0) {
+		// Skip all rows whose lower bound of the primary clock is larger than the clock value.
+		std::size_t partition_point = first;
+		std::size_t count           = last - first;
+		while (count > 0) {
+			const auto step = count / 2;
+			if (table.lower_bounds[(partition_point + step) * num_clocks + primary_clock]
+			    <= clock_values[primary_clock]) {
+				partition_point += step + 1;
+				count -= step + 1;
+			} else {
+				count = step;
+			}
+		}
+		last = partition_point;
+	}
+	for (std::size_t row = last; row > first; --row) {
+		if (num_clocks > 0 && table.primary_upper_maxima[row - 1] < clock_values[primary_clock]) {
+			// No row up to this one allows the value of the primary clock.
+			break;
+		}
+		if (predicate(row - 1) && is_enabled(table, row - 1, clock_values)) {
+			return row - 1;
+		}
+	}
+	return std::nullopt;
+}
+
+} // namespace
+
+void
+fill_decision_table(DecisionTable *                         table,
+                    std::vector<std::vector<DecisionRow>> &&controller_rows,
+                    std::vector<std::vector<DecisionRow>> &&environment_rows)
+{
+	for (std::size_t location = 0; location < table->locations.size(); ++location) {
+		const auto primary_clock = select_primary_clock(controller_rows[location],
+		                                                environment_rows[location],
+		                                                table->clocks.size());
+		table->primary_clocks.push_back(primary_clock);
+		table->location_offsets.push_back(static_cast<std::uint32_t>(table->get_num_rows()));
+		append_rows(table, std::move(controller_rows[location]), primary_clock);
+		table->controller_row_ends.push_back(static_cast<std::uint32_t>(table->get_num_rows()));
+		append_rows(table, std::move(environment_rows[location]), primary_clock);
+	}
+	table->location_offsets.push_back(static_cast<std::uint32_t>(table->get_num_rows()));
+}
+
+} // namespace details
+
+std::optional<std::size_t>
+find_controller_row(const DecisionTable &    table,
+                    LocationId               location,
+                    const std::vector<Tick> &clock_values)
+{
+	return details::find_last_enabled_row(table,
+	                                      table.location_offsets.at(location),
+	                                      table.controller_row_ends.at(location),
+	                                      table.primary_clocks.at(location),
+	                                      clock_values,
+	                                      [](std::size_t) { return true; });
+}
+
+std::optional<std::size_t>
+find_row(const DecisionTable &    table,
+         LocationId               location,
+         ActionId                 action,
+         const std::vector<Tick> &clock_values)
+{
+	const bool is_controller_action = table.controller_actions.at(action);
+	return details::find_last_enabled_row(
+	  table,
+	  is_controller_action ? table.location_offsets.at(location)
+	                       : table.controller_row_ends.at(location),
+	  is_controller_action ? table.controller_row_ends.at(location)
+	                       : table.location_offsets.at(location + 1),
+	  table.primary_clocks.at(location),
+	  clock_values,
+	  [&table, action](std::size_t row) { return table.row_actions[row] == action; });
+}
+
+} // namespace controller_synthesis
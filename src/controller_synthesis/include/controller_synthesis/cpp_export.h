@@ -0,0 +1,49 @@
+/***************************************************************************
+ *  cpp_export.h - Generate C++ code from decision tables
+ *
+ *  Created:   Sun 18 Oct 16:10:44 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "decision_table.h"
+
+#include <ostream>
+#include <string>
+
+namespace controller_synthesis {
+
+/** @brief Generate a self-contained C++17 header that implements the controller.
+ * The header defines a namespace with the enums Location and Action, the table of rows as
+ * constexpr arrays, and the two functions
+ * - next_transition(location, clocks), which returns the row of the controller action to take or
+ *   nullptr, and
+ * - get_transition(location, action, clocks), which returns the row that the controller follows if
+ *   the given action occurs or nullptr.
+ * Both functions find the candidate rows with a binary search on the primary clock of the location
+ * and do not allocate. Actions are named after the actions of the table if the name is a valid
+ * identifier. Otherwise, the action with the ID i is named Ai. To avoid collisions, this also
+ * applies to actions whose name already has this form. Locations are enumerated as L0, L1, and so
+ * on.
+ * @param table The decision table to export
+ * @param os The stream to write the header to
+ * @param name_space The namespace of the generated code
+ */
+void export_to_cpp(const DecisionTable &table,
+                   std::ostream &       os,
+                   const std::string &  name_space = "controller");
+
+} // namespace controller_synthesis
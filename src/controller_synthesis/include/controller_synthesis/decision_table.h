@@ -0,0 +1,233 @@
+/***************************************************************************
+ *  decision_table.h - Flat decision tables of synthesized controllers
+ *
+ *  Created:   Sun 18 Oct 15:32:08 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "automata/ta.h"
+#include "automata/ta_regions.h"
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace controller_synthesis {
+
+/** A clock value in integer ticks. */
+using Tick = std::uint64_t;
+/** The index of a location in a DecisionTable. */
+using LocationId = std::uint32_t;
+/** The index of an action in a DecisionTable. */
+using ActionId = std::uint32_t;
+
+/** The upper bound of a clock that is not bounded from above. */
+inline constexpr Tick unbounded_tick = std::numeric_limits<Tick>::max();
+
+/** @brief A controller TA flattened into a table of transitions over integer clock ticks.
+ * Each row of the table is one transition with a guard of the form lower[c] <= c <= upper[c] for
+ * each clock c, where the clocks are measured in ticks. All per-row data is stored in flat arrays,
+ * the bounds of row r on clock c are at index r * clocks.size() + c.
+ *
+ * The rows of location l are in the range [location_offsets[l], location_offsets[l+1]). The rows
+ * with a controller action come first and end at controller_row_ends[l], followed by the rows with
+ * an environment action. Both parts are sorted by the lower bound of the location's primary clock,
+ * which is the clock that distinguishes the most rows of that location. This allows to find the
+ * candidates for a clock valuation with a binary search. The candidates are then scanned backwards
+ * until the running maximum of the primary clock's upper bounds drops below the clock value, so
+ * rows with overlapping guards do not make the scan linear in the number of rows.
+ */
+struct DecisionTable
+{
+	/** The number of ticks per time unit of the TA. */
+	Tick ticks_per_time_unit;
+	/** The names of the locations, indexed by LocationId. */
+	std::vector<std::string> locations;
+	/** The names of the actions, indexed by ActionId. */
+	std::vector<std::string> actions;
+	/** Whether the action is controlled by the controller, indexed by ActionId. */
+	std::vector<bool> controller_actions;
+	/** The names of the clocks. */
+	std::vector<std::string> clocks;
+	/** The initial location of the controller. */
+	LocationId initial_location;
+	/** The first row of each location, with a final entry for the end of the last location. */
+	std::vector<std::uint32_t> location_offsets;
+	/** The end of the rows with controller actions of each location. */
+	std::vector<std::uint32_t> controller_row_ends;
+	/** The clock that each location's rows are sorted by. */
+	std::vector<std::uint32_t> primary_clocks;
+	/** The inclusive lower bounds of each row, in ticks. */
+	std::vector<Tick> lower_bounds;
+	/** The inclusive upper bounds of each row, in ticks, or unbounded_tick. */
+	std::vector<Tick> upper_bounds;
+	/** The maximal upper bound of the primary clock from the first row of the same part of the
+	 * location up to each row, in ticks, or unbounded_tick if the table has no clocks. */
+	std::vector<Tick> primary_upper_maxima;
+	/** The action of each row. */
+	std::vector<ActionId> row_actions;
+	/** The target location of each row. */
+	std::vector<LocationId> row_targets;
+	/** The clocks reset by each row as bit mask, where bit c corresponds to clock c. */
+	std::vector<std::uint64_t> row_resets;
+
+	/** Get the number of rows of the table. */
+	std::size_t
+	get_num_rows() const
+	{
+		return row_actions.size();
+	}
+};
+
+namespace details {
+
+/** A transition of the controller TA in terms of location, action, and clock indexes. */
+struct DecisionRow
+{
+	/// The inclusive lower bound of each clock in ticks
+	std::vector<Tick> lower;
+	/// The inclusive upper bound of each clock in ticks
+	std::vector<Tick> upper;
+	/// The action of the transition
+	ActionId action;
+	/// The target location of the transition
+	LocationId target;
+	/// The bit mask of reset clocks
+	std::uint64_t resets;
+};
+
+/** Convert a region interval into an inclusive interval of ticks.
+ * @return The smallest and the largest tick in the interval
+ */
+std::pair<Tick, Tick> get_tick_interval(const automata::ta::RegionInterval &interval,
+                                        Tick                                ticks_per_time_unit);
+
+/** Sort the rows of each location, select the primary clocks, and fill the flat arrays. */
+void fill_decision_table(DecisionTable *                                  table,
+                         std::vector<std::vector<DecisionRow>> &&controller_rows,
+                         std::vector<std::vector<DecisionRow>> &&environment_rows);
+
+} // namespace details
+
+/** @brief Flatten a controller TA into a decision table.
+ * Each guard is converted into an interval of ticks for each clock. As the table is evaluated on
+ * integer ticks, a strict bound x > c becomes x >= c * ticks_per_time_unit + 1. Thus,
+ * ticks_per_time_unit should be at least 2 so that the open regions between two integers contain
+ * a tick. Transitions whose guard does not contain any tick are dropped.
+ * @param controller The controller to flatten, e.g., the result of create_controller
+ * @param controller_actions The actions that are controlled by the controller
+ * @param ticks_per_time_unit The resolution of the clocks
+ * @return The decision table of the controller
+ * @throws std::invalid_argument if the controller has more than 64 clocks or the resolution is zero
+ */
+template <typename LocationT, typename ActionT>
+DecisionTable
+create_decision_table(const automata::ta::TimedAutomaton<LocationT, ActionT> &controller,
+                      const std::set<ActionT> &                               controller_actions,
+                      Tick ticks_per_time_unit = 2)
+{
+	if (ticks_per_time_unit == 0) {
+		throw std::invalid_argument("The number of ticks per time unit must be positive");
+	}
+	if (controller.get_clocks().size() > 64) {
+		throw std::invalid_argument("Decision tables support at most 64 clocks");
+	}
+	DecisionTable table;
+	table.ticks_per_time_unit = ticks_per_time_unit;
+	std::map<automata::ta::Location<LocationT>, LocationId> location_ids;
+	for (const auto &location : controller.get_locations()) {
+		location_ids.emplace(location, static_cast<LocationId>(table.locations.size()));
+		std::stringstream name;
+		name << location;
+		table.locations.push_back(name.str());
+	}
+	table.initial_location = location_ids.at(controller.get_initial_location());
+	std::map<ActionT, ActionId> action_ids;
+	for (const auto &action : controller.get_alphabet()) {
+		action_ids.emplace(action, static_cast<ActionId>(table.actions.size()));
+		std::stringstream name;
+		name << action;
+		table.actions.push_back(name.str());
+		table.controller_actions.push_back(controller_actions.count(action) > 0);
+	}
+	std::map<std::string, std::size_t> clock_ids;
+	for (const auto &clock : controller.get_clocks()) {
+		clock_ids.emplace(clock, table.clocks.size());
+		table.clocks.push_back(clock);
+	}
+
+	std::vector<std::vector<details::DecisionRow>> controller_rows(table.locations.size());
+	std::vector<std::vector<details::DecisionRow>> environment_rows(table.locations.size());
+	for (const auto &[source, transition] : controller.get_transitions()) {
+		details::DecisionRow row{std::vector<Tick>(table.clocks.size(), 0),
+		                         std::vector<Tick>(table.clocks.size(), unbounded_tick),
+		                         action_ids.at(transition.symbol_),
+		                         location_ids.at(transition.target_),
+		                         0};
+		bool satisfiable = true;
+		for (const auto &[clock, interval] :
+		     automata::ta::get_region_intervals(transition.get_guards())) {
+			const auto [lower, upper] = details::get_tick_interval(interval, ticks_per_time_unit);
+			const auto clock_id       = clock_ids.at(clock);
+			row.lower[clock_id]       = lower;
+			row.upper[clock_id]       = upper;
+			satisfiable &= lower <= upper;
+		}
+		if (!satisfiable) {
+			continue;
+		}
+		for (const auto &clock : transition.clock_resets_) {
+			row.resets |= std::uint64_t{1} << clock_ids.at(clock);
+		}
+		auto &rows = table.controller_actions[row.action] ? controller_rows : environment_rows;
+		rows[location_ids.at(source)].push_back(std::move(row));
+	}
+	details::fill_decision_table(&table, std::move(controller_rows), std::move(environment_rows));
+	return table;
+}
+
+/** @brief Find the controller action to take in the given situation.
+ * If multiple controller actions are enabled, the one whose guard on the primary clock has the
+ * largest lower bound is selected.
+ * @param table The decision table of the controller
+ * @param location The current location of the controller
+ * @param clock_values The current value of each clock in ticks
+ * @return The row of the enabled controller transition, if there is any
+ */
+std::optional<std::size_t> find_controller_row(const DecisionTable &    table,
+                                               LocationId               location,
+                                               const std::vector<Tick> &clock_values);
+
+/** @brief Find the transition that the controller follows when the given action occurs.
+ * @param table The decision table of the controller
+ * @param location The current location of the controller
+ * @param action The action that occurred, either a controller or an environment action
+ * @param clock_values The current value of each clock in ticks
+ * @return The row of the enabled transition with the given action, if there is any
+ */
+std::optional<std::size_t> find_row(const DecisionTable &    table,
+                                    LocationId               location,
+                                    ActionId                 action,
+                                    const std::vector<Tick> &clock_values);
+
+} // namespace controller_synthesis
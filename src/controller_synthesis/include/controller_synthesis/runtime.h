@@ -0,0 +1,120 @@
+/***************************************************************************
+ *  runtime.h - Execute synthesized controllers with integer clocks
+ *
+ *  Created:   Sun 18 Oct 18:21:37 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "decision_table.h"
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace controller_synthesis {
+
+/** @brief Execute a controller given as decision table.
+ * The runtime tracks the current location of the controller and the clocks in integer ticks. Clocks
+ * are stored as the time of their last reset, so time can advance without touching the clocks.
+ * Events and queries are given with absolute time stamps in ticks, which must not decrease.
+ *
+ * The guards of a controller created by create_controller refer to the clocks of the plant, but
+ * the controller itself does not reset them. Therefore, the caller reports the clocks that the plant
+ * has reset with each event.
+ *
+ * After construction, queries and events do not allocate memory.
+ */
+class ControllerRuntime
+{
+public:
+	/** The controller action that may be executed and the time until which it is allowed. */
+	struct Decision
+	{
+		/// The controller action to execute
+		ActionId action;
+		/// The last tick (inclusive) at which the action is allowed, or unbounded_tick
+		Tick until;
+	};
+
+	/** Initialize the runtime in the initial location of the controller at time 0.
+	 * @param table The decision table of the controller
+	 */
+	explicit ControllerRuntime(DecisionTable table);
+
+	/** Reset the controller to its initial location with all clocks set to zero.
+	 * @param time The current time in ticks
+	 */
+	void reset(Tick time = 0);
+
+	/** Get the ID of an action.
+	 * @param action The name of the action
+	 * @return The ID of the action, or nothing if the controller does not know the action
+	 */
+	std::optional<ActionId> get_action_id(const std::string &action) const;
+
+	/** Get the bit mask of a set of clocks that can be passed to handle_event.
+	 * @param clocks The names of the clocks
+	 * @return The mask with one bit set for each clock
+	 * @throws std::invalid_argument if one of the clocks is unknown
+	 */
+	std::uint64_t get_clock_mask(const std::set<std::string> &clocks) const;
+
+	/** Follow a controller or environment action that occurred at the given time.
+	 * @param action The action that occurred
+	 * @param time The time of the event in ticks
+	 * @param plant_resets The bit mask of clocks reset by the plant, see get_clock_mask
+	 * @return false if the controller does not have a transition for the event, in which case the
+	 * state of the runtime does not change
+	 * @throws std::invalid_argument if the time is smaller than the time of a previous event
+	 */
+	bool handle_event(ActionId action, Tick time, std::uint64_t plant_resets = 0);
+
+	/** Get the controller action that is allowed at the given time.
+	 * @param time The current time in ticks
+	 * @return The action and the last tick at which it is allowed if no other event occurs, or
+	 * nothing if the controller should wait
+	 * @throws std::invalid_argument if the time is smaller than the time of the last event
+	 */
+	std::optional<Decision> get_allowed_action(Tick time);
+
+	/** Get the current location of the controller. */
+	LocationId
+	get_location() const
+	{
+		return location_;
+	}
+
+	/** Get the decision table that the runtime executes. */
+	const DecisionTable &
+	get_table() const
+	{
+		return table_;
+	}
+
+private:
+	void update_clock_values(Tick time);
+
+	DecisionTable     table_;
+	LocationId        location_;
+	Tick              last_event_time_;
+	std::vector<Tick> reset_times_;
+	std::vector<Tick> clock_values_;
+};
+
+} // namespace controller_synthesis
@@ -0,0 +1,60 @@
+/***************************************************************************
+ *  runtime_proto.h - Load controller protos into the controller runtime
+ *
+ *  Created:   Sun 18 Oct 18:47:12 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "automata/ta.pb.h"
+#include "decision_table.h"
+#include "runtime.h"
+#include "utilities/proto_format.h"
+
+#include <filesystem>
+#include <set>
+#include <string>
+
+namespace controller_synthesis {
+
+/** Flatten a controller proto into a decision table.
+ * @param controller The controller, e.g., as written by ta_to_proto
+ * @param controller_actions The actions that are controlled by the controller
+ * @param ticks_per_time_unit The resolution of the clocks
+ * @return The decision table of the controller
+ */
+DecisionTable create_decision_table(const automata::ta::proto::TimedAutomaton &controller,
+                                    const std::set<std::string> &controller_actions,
+                                    Tick                         ticks_per_time_unit = 2);
+
+/** Load a controller from a file into a runtime.
+ * The file may either contain the binary encoding of the proto or the text format, as written by
+ * the app.
+ * @see utilities::get_proto_format
+ * @param path The path to the controller proto
+ * @param controller_actions The actions that are controlled by the controller
+ * @param ticks_per_time_unit The resolution of the clocks
+ * @param format The format of the file, AUTO to determine it from the extension
+ * @return A runtime in the initial location of the controller
+ * @throws std::invalid_argument if the file cannot be read or parsed
+ */
+ControllerRuntime
+load_controller_runtime(const std::filesystem::path &path,
+                        const std::set<std::string> &controller_actions,
+                        Tick                         ticks_per_time_unit = 2,
+                        utilities::ProtoFormat       format = utilities::ProtoFormat::AUTO);
+
+} // namespace controller_synthesis
@@ -0,0 +1,301 @@
+/***************************************************************************
+ *  simulation.h - Monte Carlo simulation of a plant and a controller
+ *
+ *  Created:   Sun 18 Oct 16:05:12 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "automata/ta.h"
+#include "automata/ta_regions.h"
+#include "decision_table.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace controller_synthesis {
+
+/** @brief A timed automaton flattened for simulation.
+ * The transitions are sorted by their source, the transitions of location l are in the range
+ * [location_offsets[l], location_offsets[l+1]). Each guard is an inclusive interval of ticks for
+ * each of the automaton's clocks, the bounds of transition t on clock c are at index
+ * t * clock_indexes.size() + c. The clocks are shared between all automata of a SimulationSystem,
+ * clock_indexes maps each clock of the automaton to its index in the system.
+ */
+struct SimulationAutomaton
+{
+	/** Whether the location is final, indexed by LocationId. */
+	std::vector<bool> final_locations;
+	/** The initial location. */
+	LocationId initial_location;
+	/** The index of each of the automaton's clocks in the system. */
+	std::vector<std::size_t> clock_indexes;
+	/** The first transition of each location, with a final entry for the end of the last location. */
+	std::vector<std::uint32_t> location_offsets;
+	/** The source of each transition. */
+	std::vector<LocationId> sources;
+	/** The action of each transition. */
+	std::vector<ActionId> actions;
+	/** The target of each transition. */
+	std::vector<LocationId> targets;
+	/** The system clocks reset by each transition as bit mask. */
+	std::vector<std::uint64_t> resets;
+	/** The inclusive lower bound of each transition and clock, in ticks. */
+	std::vector<Tick> lower_bounds;
+	/** The inclusive upper bound of each transition and clock, in ticks, or unbounded_tick. */
+	std::vector<Tick> upper_bounds;
+
+	/** Get the number of transitions. */
+	std::size_t
+	get_num_transitions() const
+	{
+		return actions.size();
+	}
+};
+
+/** A plant, optionally with a controller and a monitor, flattened for simulation.
+ * All automata synchronize on all actions. The controller only restricts the controller actions,
+ * the environment actions are chosen randomly. The monitor must be deterministic and complete,
+ * e.g., as created by mtl_ata_translation::translate_to_monitor.
+ */
+struct SimulationSystem
+{
+	/** The number of ticks per time unit of the automata. */
+	Tick ticks_per_time_unit;
+	/** The names of the clocks of all automata. */
+	std::vector<std::string> clocks;
+	/** The names of the actions of all automata. */
+	std::vector<std::string> actions;
+	/** Whether the action is controlled by the controller, indexed by ActionId. */
+	std::vector<bool> controller_actions;
+	/** The plant. */
+	SimulationAutomaton plant;
+	/** The controller, if any. Without controller, all actions are chosen randomly. */
+	std::optional<SimulationAutomaton> controller;
+	/** The monitor of undesired behaviors, if any. */
+	std::optional<SimulationAutomaton> monitor;
+};
+
+/** The parameters of a simulation. */
+struct SimulationOptions
+{
+	/** The number of independent executions. */
+	std::size_t num_runs{1000};
+	/** The maximal number of steps of each execution, each step is a delay and at most one action. */
+	std::size_t max_steps{100};
+	/** The maximal duration of each execution, in ticks. */
+	Tick time_horizon{1000};
+	/** The maximal delay before the environment acts, in ticks. */
+	Tick max_environment_delay{4};
+	/** The seed of the random number generator. */
+	std::uint64_t seed{0};
+};
+
+/** The result of a simulation. */
+struct SimulationStatistics
+{
+	/** The number of executions. */
+	std::size_t num_runs{0};
+	/** The number of executions in which the monitor detected a violation, zero without a monitor. */
+	std::size_t num_violations{0};
+	/** The number of executions that stopped because the controller did not handle an action. */
+	std::size_t num_uncovered_actions{0};
+	/** The number of executions that stopped because the controller reached a location without
+	 * outgoing transitions. Such a location corresponds to a leaf of the search tree, from which on
+	 * the controller repeats the strategy of an earlier, dominating node. */
+	std::size_t num_controller_leaves{0};
+	/** The total number of actions of all executions. */
+	std::size_t num_steps{0};
+	/** The number of occurrences of each action, indexed by ActionId. */
+	std::vector<std::size_t> action_counts;
+	/** The earliest time of a violation, in ticks. */
+	std::optional<Tick> min_violation_time;
+	/** The latest time of a violation, in ticks. */
+	std::optional<Tick> max_violation_time;
+	/** The average time of a violation, in ticks. */
+	std::optional<double> mean_violation_time;
+	/** The time spent on the simulation. */
+	std::chrono::nanoseconds duration{0};
+
+	/** Get the fraction of executions with a violation. */
+	double
+	get_violation_rate() const
+	{
+		return num_runs == 0 ? 0 : static_cast<double>(num_violations) / num_runs;
+	}
+};
+
+namespace details {
+
+/** Get the ID of a name, adding the name if it is not known yet. */
+std::size_t get_or_add_id(std::vector<std::string> *names, const std::string &name);
+
+/** Sort the transitions of an automaton by their source and compute the location offsets.
+ * @param automaton The automaton with transitions in arbitrary order
+ * @param num_locations The number of locations of the automaton
+ */
+void sort_simulation_transitions(SimulationAutomaton *automaton, std::size_t num_locations);
+
+/** Flatten a timed automaton for a simulation system.
+ * New clocks and actions are added to the system.
+ */
+template <typename LocationT, typename ActionT>
+SimulationAutomaton
+create_simulation_automaton(const automata::ta::TimedAutomaton<LocationT, ActionT> &ta,
+                            SimulationSystem *                                      system)
+{
+	SimulationAutomaton automaton;
+	std::map<automata::ta::Location<LocationT>, LocationId> location_ids;
+	for (const auto &location : ta.get_locations()) {
+		location_ids.emplace(location, static_cast<LocationId>(location_ids.size()));
+		automaton.final_locations.push_back(ta.get_final_locations().count(location) > 0);
+	}
+	automaton.initial_location = location_ids.at(ta.get_initial_location());
+	std::map<std::string, std::size_t> clock_ids;
+	for (const auto &clock : ta.get_clocks()) {
+		clock_ids.emplace(clock, automaton.clock_indexes.size());
+		automaton.clock_indexes.push_back(details::get_or_add_id(&system->clocks, clock));
+	}
+	if (system->clocks.size() > 64) {
+		throw std::invalid_argument("Simulations support at most 64 clocks");
+	}
+	const auto num_clocks = automaton.clock_indexes.size();
+	for (const auto &[source, transition] : ta.get_transitions()) {
+		std::vector<Tick> lower(num_clocks, 0);
+		std::vector<Tick> upper(num_clocks, unbounded_tick);
+		bool              satisfiable = true;
+		for (const auto &[clock, interval] :
+		     automata::ta::get_region_intervals(transition.get_guards())) {
+			const auto [lower_tick, upper_tick] =
+			  details::get_tick_interval(interval, system->ticks_per_time_unit);
+			lower[clock_ids.at(clock)] = lower_tick;
+			upper[clock_ids.at(clock)] = upper_tick;
+			satisfiable &= lower_tick <= upper_tick;
+		}
+		if (!satisfiable) {
+			continue;
+		}
+		std::uint64_t resets = 0;
+		for (const auto &clock : transition.clock_resets_) {
+			resets |= std::uint64_t{1} << automaton.clock_indexes[clock_ids.at(clock)];
+		}
+		std::stringstream action;
+		action << transition.symbol_;
+		const auto action_id = details::get_or_add_id(&system->actions, action.str());
+		system->controller_actions.resize(system->actions.size(), false);
+		automaton.sources.push_back(location_ids.at(source));
+		automaton.actions.push_back(static_cast<ActionId>(action_id));
+		automaton.targets.push_back(location_ids.at(transition.target_));
+		automaton.resets.push_back(resets);
+		automaton.lower_bounds.insert(std::end(automaton.lower_bounds),
+		                              std::begin(lower),
+		                              std::end(lower));
+		automaton.upper_bounds.insert(std::end(automaton.upper_bounds),
+		                              std::begin(upper),
+		                              std::end(upper));
+	}
+	details::sort_simulation_transitions(&automaton, location_ids.size());
+	return automaton;
+}
+
+} // namespace details
+
+/** Flatten a plant for simulation.
+ * @param plant The plant to simulate
+ * @param controller_actions The actions controlled by the controller
+ * @param ticks_per_time_unit The clock resolution, see create_decision_table
+ * @return The simulation system, to which a controller and a monitor can be added
+ */
+template <typename LocationT, typename ActionT>
+SimulationSystem
+create_simulation_system(const automata::ta::TimedAutomaton<LocationT, ActionT> &plant,
+                         const std::set<ActionT> &                               controller_actions,
+                         Tick ticks_per_time_unit = 2)
+{
+	if (ticks_per_time_unit == 0) {
+		throw std::invalid_argument("The number of ticks per time unit must be positive");
+	}
+	SimulationSystem system;
+	system.ticks_per_time_unit = ticks_per_time_unit;
+	for (const auto &action : plant.get_alphabet()) {
+		std::stringstream name;
+		name << action;
+		details::get_or_add_id(&system.actions, name.str());
+		system.controller_actions.push_back(controller_actions.count(action) > 0);
+	}
+	system.plant = details::create_simulation_automaton(plant, &system);
+	return system;
+}
+
+/** Add a controller to a simulation system.
+ * @param system The system to add the controller to
+ * @param controller The controller, whose guards must only use clocks of the plant
+ */
+template <typename LocationT, typename ActionT>
+void
+add_simulation_controller(SimulationSystem *                                      system,
+                          const automata::ta::TimedAutomaton<LocationT, ActionT> &controller)
+{
+	const auto num_clocks = system->clocks.size();
+	system->controller    = details::create_simulation_automaton(controller, system);
+	if (system->clocks.size() != num_clocks) {
+		throw std::invalid_argument("The controller uses clocks that are not in the plant");
+	}
+}
+
+/** Add a monitor of undesired behaviors to a simulation system.
+ * An execution violates the specification as soon as both the plant and the monitor are in a final
+ * location. The simulation only counts violations with a monitor. As the monitor must be
+ * deterministic, violations can only be simulated for specifications in the fragment accepted by
+ * mtl_ata_translation::is_monitorable.
+ * @param system The system to add the monitor to
+ * @param monitor A deterministic and complete monitor
+ */
+template <typename LocationT, typename ActionT>
+void
+add_simulation_monitor(SimulationSystem *                                      system,
+                       const automata::ta::TimedAutomaton<LocationT, ActionT> &monitor)
+{
+	system->monitor = details::create_simulation_automaton(monitor, system);
+}
+
+/** @brief Simulate many independent executions of a system.
+ * All executions are simulated in lockstep. The clock values of all executions are stored as one
+ * array per clock, and the guards are evaluated for all executions at once in branch-free loops,
+ * which the compiler vectorizes.
+ *
+ * In each step, the environment draws a random delay of at most max_environment_delay ticks and
+ * randomly chooses one of the environment transitions enabled after the delay. The controller acts
+ * as early as possible with the first of its enabled transitions. If it can act no later than the
+ * environment, the controller's transition is taken, otherwise the environment's. If neither can
+ * act, only time passes. An execution stops if the monitor detects a violation, if the controller
+ * does not handle an environment action, or if the controller reaches a location without outgoing
+ * transitions. In the latter case, the monitor still reads the last action, so a violation caused
+ * by the action is counted.
+ * @param system The system to simulate
+ * @param options The parameters of the simulation
+ * @return The statistics of all executions
+ */
+SimulationStatistics simulate(const SimulationSystem &system, const SimulationOptions &options);
+
+} // namespace controller_synthesis
@@ -0,0 +1,119 @@
+/***************************************************************************
+ *  runtime.cpp - Execute synthesized controllers with integer clocks
+ *
+ *  Created:   Sun 18 Oct 18:21:37 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "controller_synthesis/runtime.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace controller_synthesis {
+
+ControllerRuntime::ControllerRuntime(DecisionTable table)
+: table_(std::move(table)),
+  location_(table_.initial_location),
+  last_event_time_(0),
+  reset_times_(table_.clocks.size(), 0),
+  clock_values_(table_.clocks.size(), 0)
+{
+}
+
+void
+ControllerRuntime::reset(Tick time)
+{
+	location_        = table_.initial_location;
+	last_event_time_ = time;
+	std::fill(std::begin(reset_times_), std::end(reset_times_), time);
+}
+
+std::optional<ActionId>
+ControllerRuntime::get_action_id(const std::string &action) const
+{
+	const auto it = std::find(std::begin(table_.actions), std::end(table_.actions), action);
+	if (it == std::end(table_.actions)) {
+		return std::nullopt;
+	}
+	return static_cast<ActionId>(std::distance(std::begin(table_.actions), it));
+}
+
+std::uint64_t
+ControllerRuntime::get_clock_mask(const std::set<std::string> &clocks) const
+{
+	std::uint64_t mask = 0;
+	for (const auto &clock : clocks) {
+		const auto it = std::find(std::begin(table_.clocks), std::end(table_.clocks), clock);
+		if (it == std::end(table_.clocks)) {
+			throw std::invalid_argument("Unknown clock '" + clock + "'");
+		}
+		mask |= std::uint64_t{1} << std::distance(std::begin(table_.clocks), it);
+	}
+	return mask;
+}
+
+void
+ControllerRuntime::update_clock_values(Tick time)
+{
+	if (time < last_event_time_) {
+		throw std::invalid_argument("Time must not decrease");
+	}
+	for (std::size_t clock = 0; clock < reset_times_.size(); ++clock) {
+		clock_values_[clock] = time - reset_times_[clock];
+	}
+}
+
+bool
+ControllerRuntime::handle_event(ActionId action, Tick time, std::uint64_t plant_resets)
+{
+	update_clock_values(time);
+	const auto row = find_row(table_, location_, action, clock_values_);
+	if (!row) {
+		return false;
+	}
+	location_         = table_.row_targets[*row];
+	last_event_time_  = time;
+	const auto resets = table_.row_resets[*row] | plant_resets;
+	for (std::size_t clock = 0; clock < reset_times_.size(); ++clock) {
+		if ((resets >> clock) & 1) {
+			reset_times_[clock] = time;
+		}
+	}
+	return true;
+}
+
+std::optional<ControllerRuntime::Decision>
+ControllerRuntime::get_allowed_action(Tick time)
+{
+	update_clock_values(time);
+	const auto row = find_controller_row(table_, location_, clock_values_);
+	if (!row) {
+		return std::nullopt;
+	}
+	// The lower bounds stay satisfied while time passes, thus the action is allowed until the first
+	// clock exceeds its upper bound.
+	Tick       until      = unbounded_tick;
+	const auto num_clocks = table_.clocks.size();
+	for (std::size_t clock = 0; clock < num_clocks; ++clock) {
+		const auto upper = table_.upper_bounds[*row * num_clocks + clock];
+		if (upper != unbounded_tick) {
+			until = std::min(until, time + (upper - clock_values_[clock]));
+		}
+	}
+	return Decision{table_.row_actions[*row], until};
+}
+
+} // namespace controller_synthesis
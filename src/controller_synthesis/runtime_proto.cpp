@@ -0,0 +1,64 @@
+/***************************************************************************
+ *  runtime_proto.cpp - Load controller protos into the controller runtime
+ *
+ *  Created:   Sun 18 Oct 18:47:12 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "controller_synthesis/runtime_proto.h"
+
+#include "automata/ta_proto.h"
+
+#include <google/protobuf/text_format.h>
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace controller_synthesis {
+
+DecisionTable
+create_decision_table(const automata::ta::proto::TimedAutomaton &controller,
+                      const std::set<std::string> &              controller_actions,
+                      Tick                                       ticks_per_time_unit)
+{
+	return create_decision_table(automata::ta::parse_proto(controller),
+	                             controller_actions,
+	                             ticks_per_time_unit);
+}
+
+ControllerRuntime
+load_controller_runtime(const std::filesystem::path &path,
+                        const std::set<std::string> &controller_actions,
+                        Tick                         ticks_per_time_unit,
+                        utilities::ProtoFormat       format)
+{
+	std::ifstream fs(path, std::ios::binary);
+	if (!fs) {
+		throw std::invalid_argument("Could not open controller file '" + path.string() + "'");
+	}
+	const std::string content{std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>()};
+	automata::ta::proto::TimedAutomaton controller;
+	const bool success = utilities::get_proto_format(path, format) == utilities::ProtoFormat::BINARY
+	                       ? controller.ParseFromString(content)
+	                       : google::protobuf::TextFormat::ParseFromString(content, &controller);
+	if (!success) {
+		throw std::invalid_argument("Failed to read controller from file '" + path.string() + "'");
+	}
+	return ControllerRuntime{
+	  create_decision_table(controller, controller_actions, ticks_per_time_unit)};
+}
+
+} // namespace controller_synthesis
@@ -0,0 +1,419 @@
+/***************************************************************************
+ *  simulation.cpp - Monte Carlo simulation of a plant and a controller
+ *
+ *  Created:   Sun 18 Oct 16:05:12 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "controller_synthesis/simulation.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace controller_synthesis {
+
+namespace details {
+
+std::size_t
+get_or_add_id(std::vector<std::string> *names, const std::string &name)
+{
+	const auto it = std::find(std::begin(*names), std::end(*names), name);
+	if (it != std::end(*names)) {
+		return static_cast<std::size_t>(std::distance(std::begin(*names), it));
+	}
+	names->push_back(name);
+	return names->size() - 1;
+}
+
+void
+sort_simulation_transitions(SimulationAutomaton *automaton, std::size_t num_locations)
+{
+	const auto               num_transitions = automaton->get_num_transitions();
+	const auto               num_clocks      = automaton->clock_indexes.size();
+	std::vector<std::size_t> order(num_transitions);
+	std::iota(std::begin(order), std::end(order), 0);
+	std::stable_sort(std::begin(order), std::end(order), [automaton](std::size_t a, std::size_t b) {
+		return automaton->sources[a] < automaton->sources[b];
+	});
+	SimulationAutomaton sorted;
+	sorted.final_locations  = automaton->final_locations;
+	sorted.initial_location = automaton->initial_location;
+	sorted.clock_indexes    = automaton->clock_indexes;
+	sorted.location_offsets.assign(num_locations + 1, 0);
+	for (const auto t : order) {
+		sorted.sources.push_back(automaton->sources[t]);
+		sorted.actions.push_back(automaton->actions[t]);
+		sorted.targets.push_back(automaton->targets[t]);
+		sorted.resets.push_back(automaton->resets[t]);
+		for (std::size_t clock = 0; clock < num_clocks; ++clock) {
+			sorted.lower_bounds.push_back(automaton->lower_bounds[t * num_clocks + clock]);
+			sorted.upper_bounds.push_back(automaton->upper_bounds[t * num_clocks + clock]);
+		}
+		++sorted.location_offsets[automaton->sources[t] + 1];
+	}
+	std::partial_sum(std::begin(sorted.location_offsets),
+	                 std::end(sorted.location_offsets),
+	                 std::begin(sorted.location_offsets));
+	*automaton = std::move(sorted);
+}
+
+} // namespace details
+
+namespace {
+
+/** A joint move of the controller and the plant, with the combined guard over all system clocks. */
+struct ControllerMove
+{
+	std::size_t              plant_transition;
+	std::size_t              controller_transition;
+	std::vector<std::size_t> constrained_clocks;
+	std::vector<Tick>        lower_bounds;
+	std::vector<Tick>        upper_bounds;
+};
+
+/** Restrict the enabled mask of all runs to the runs in which the guard of the transition is
+ * satisfied after the given delays. */
+void
+restrict_to_guard(const SimulationAutomaton &           automaton,
+                  std::size_t                           transition,
+                  const std::vector<std::vector<Tick>> &clocks,
+                  const std::vector<Tick> &             delays,
+                  std::vector<std::uint8_t> *           enabled)
+{
+	const auto    num_runs   = delays.size();
+	const auto    num_clocks = automaton.clock_indexes.size();
+	const Tick *  d          = delays.data();
+	std::uint8_t *e          = enabled->data();
+	for (std::size_t clock = 0; clock < num_clocks; ++clock) {
+		const Tick lower = automaton.lower_bounds[transition * num_clocks + clock];
+		const Tick upper = automaton.upper_bounds[transition * num_clocks + clock];
+		if (lower == 0 && upper == unbounded_tick) {
+			continue;
+		}
+		const Tick *v = clocks[automaton.clock_indexes[clock]].data();
+		for (std::size_t run = 0; run < num_runs; ++run) {
+			const Tick value = v[run] + d[run];
+			e[run] &= static_cast<std::uint8_t>((value >= lower) & (value <= upper));
+		}
+	}
+}
+
+/** Find the first transition of a single run with the given action that is enabled after the delay.
+ */
+std::optional<std::size_t>
+find_transition(const SimulationAutomaton &           automaton,
+                LocationId                            location,
+                ActionId                              action,
+                const std::vector<std::vector<Tick>> &clocks,
+                std::size_t                           run,
+                Tick                                  delay)
+{
+	const auto num_clocks = automaton.clock_indexes.size();
+	for (auto transition = automaton.location_offsets[location];
+	     transition < automaton.location_offsets[location + 1];
+	     ++transition) {
+		if (automaton.actions[transition] != action) {
+			continue;
+		}
+		bool enabled = true;
+		for (std::size_t clock = 0; clock < num_clocks && enabled; ++clock) {
+			const Tick value = clocks[automaton.clock_indexes[clock]][run] + delay;
+			enabled          = value >= automaton.lower_bounds[transition * num_clocks + clock]
+			          && value <= automaton.upper_bounds[transition * num_clocks + clock];
+		}
+		if (enabled) {
+			return transition;
+		}
+	}
+	return std::nullopt;
+}
+
+/** Restrict the combined guard of a move to the guard of the given transition. */
+void
+restrict_move(const SimulationAutomaton &automaton, std::size_t transition, ControllerMove *move)
+{
+	const auto num_clocks = automaton.clock_indexes.size();
+	for (std::size_t clock = 0; clock < num_clocks; ++clock) {
+		const auto index          = automaton.clock_indexes[clock];
+		move->lower_bounds[index] = std::max(move->lower_bounds[index],
+		                                     automaton.lower_bounds[transition * num_clocks + clock]);
+		move->upper_bounds[index] = std::min(move->upper_bounds[index],
+		                                     automaton.upper_bounds[transition * num_clocks + clock]);
+	}
+}
+
+/** Combine the guards of all pairs of controller and plant transitions with the same action. */
+std::vector<ControllerMove>
+get_controller_moves(const SimulationSystem &system)
+{
+	std::vector<ControllerMove> moves;
+	if (!system.controller) {
+		return moves;
+	}
+	const auto &plant      = system.plant;
+	const auto &controller = *system.controller;
+	const auto  num_clocks = system.clocks.size();
+	for (std::size_t c = 0; c < controller.get_num_transitions(); ++c) {
+		if (!system.controller_actions[controller.actions[c]]) {
+			continue;
+		}
+		for (std::size_t p = 0; p < plant.get_num_transitions(); ++p) {
+			if (plant.actions[p] != controller.actions[c]) {
+				continue;
+			}
+			ControllerMove move{p, c, {}, std::vector<Tick>(num_clocks, 0), {}};
+			move.upper_bounds.assign(num_clocks, unbounded_tick);
+			restrict_move(plant, p, &move);
+			restrict_move(controller, c, &move);
+			for (std::size_t clock = 0; clock < num_clocks; ++clock) {
+				if (move.lower_bounds[clock] != 0 || move.upper_bounds[clock] != unbounded_tick) {
+					move.constrained_clocks.push_back(clock);
+				}
+			}
+			moves.push_back(std::move(move));
+		}
+	}
+	return moves;
+}
+
+} // namespace
+
+SimulationStatistics
+simulate(const SimulationSystem &system, const SimulationOptions &options)
+{
+	const auto start      = std::chrono::steady_clock::now();
+	const auto num_runs   = options.num_runs;
+	const auto num_clocks = system.clocks.size();
+	const auto &plant     = system.plant;
+	const auto moves      = get_controller_moves(system);
+	std::vector<std::size_t> environment_transitions;
+	for (std::size_t t = 0; t < plant.get_num_transitions(); ++t) {
+		if (!system.controller || !system.controller_actions[plant.actions[t]]) {
+			environment_transitions.push_back(t);
+		}
+	}
+
+	SimulationStatistics statistics;
+	statistics.num_runs = num_runs;
+	statistics.action_counts.assign(system.actions.size(), 0);
+
+	// The state of all runs, one array per component.
+	std::vector<LocationId>        plant_locations(num_runs, plant.initial_location);
+	std::vector<LocationId>        controller_locations(num_runs);
+	std::vector<LocationId>        monitor_locations(num_runs);
+	std::vector<std::vector<Tick>> clocks(num_clocks, std::vector<Tick>(num_runs, 0));
+	std::vector<Tick>              times(num_runs, 0);
+	std::vector<std::uint8_t>      active(num_runs, 1);
+	if (system.controller) {
+		std::fill(std::begin(controller_locations),
+		          std::end(controller_locations),
+		          system.controller->initial_location);
+	}
+	if (system.monitor) {
+		std::fill(std::begin(monitor_locations),
+		          std::end(monitor_locations),
+		          system.monitor->initial_location);
+	}
+
+	// Scratch buffers of each step.
+	std::vector<Tick>                      environment_delays(num_runs);
+	std::vector<double>                    environment_samples(num_runs);
+	std::vector<std::vector<std::uint8_t>> environment_enabled(environment_transitions.size());
+	std::vector<std::uint32_t>             num_environment_enabled(num_runs);
+	std::vector<std::int64_t>              environment_remaining(num_runs);
+	std::vector<std::size_t>               environment_choices(num_runs);
+	std::vector<Tick>                      controller_delays(num_runs);
+	std::vector<std::size_t>               controller_choices(num_runs);
+	std::vector<Tick>                      delays(num_runs);
+	std::vector<std::uint64_t>             resets(num_runs);
+
+	std::mt19937_64                        generator{options.seed};
+	std::uniform_int_distribution<Tick>    delay_distribution{0, options.max_environment_delay};
+	std::uniform_real_distribution<double> choice_distribution{0, 1};
+	std::size_t                            num_active = num_runs;
+	double                                 violation_time_sum = 0;
+
+	for (std::size_t step = 0; step < options.max_steps && num_active > 0; ++step) {
+		for (std::size_t run = 0; run < num_runs; ++run) {
+			environment_delays[run]  = delay_distribution(generator);
+			environment_samples[run] = choice_distribution(generator);
+		}
+
+		// Count the enabled environment transitions of each run and pick one of them uniformly.
+		std::fill(std::begin(num_environment_enabled), std::end(num_environment_enabled), 0);
+		for (std::size_t i = 0; i < environment_transitions.size(); ++i) {
+			const auto t       = environment_transitions[i];
+			auto &     enabled = environment_enabled[i];
+			enabled.resize(num_runs);
+			const auto source = plant.sources[t];
+			for (std::size_t run = 0; run < num_runs; ++run) {
+				enabled[run] = active[run] & static_cast<std::uint8_t>(plant_locations[run] == source);
+			}
+			restrict_to_guard(plant, t, clocks, environment_delays, &enabled);
+			for (std::size_t run = 0; run < num_runs; ++run) {
+				num_environment_enabled[run] += enabled[run];
+			}
+		}
+		for (std::size_t run = 0; run < num_runs; ++run) {
+			environment_remaining[run] = static_cast<std::int64_t>(
+			  environment_samples[run] * static_cast<double>(num_environment_enabled[run]));
+		}
+		for (std::size_t i = 0; i < environment_transitions.size(); ++i) {
+			const auto &enabled = environment_enabled[i];
+			for (std::size_t run = 0; run < num_runs; ++run) {
+				const bool chosen         = enabled[run] && environment_remaining[run] == 0;
+				environment_choices[run]  = chosen ? environment_transitions[i] : environment_choices[run];
+				environment_remaining[run] -= enabled[run];
+			}
+		}
+
+		// Compute the earliest delay after which the controller can act.
+		std::fill(std::begin(controller_delays), std::end(controller_delays), unbounded_tick);
+		for (std::size_t m = 0; m < moves.size(); ++m) {
+			const auto &move              = moves[m];
+			const auto  plant_source      = plant.sources[move.plant_transition];
+			const auto  controller_source = system.controller->sources[move.controller_transition];
+			for (std::size_t run = 0; run < num_runs; ++run) {
+				const bool feasible = active[run] && plant_locations[run] == plant_source
+				                      && controller_locations[run] == controller_source;
+				delays[run] = feasible ? 0 : unbounded_tick;
+			}
+			for (const auto clock : move.constrained_clocks) {
+				const Tick  lower = move.lower_bounds[clock];
+				const Tick  upper = move.upper_bounds[clock];
+				const Tick *v     = clocks[clock].data();
+				for (std::size_t run = 0; run < num_runs; ++run) {
+					delays[run] = std::max(delays[run], lower > v[run] ? lower - v[run] : 0);
+				}
+				if (upper == unbounded_tick) {
+					continue;
+				}
+				// All lower bounds must be satisfied before any clock exceeds its upper bound.
+				for (std::size_t run = 0; run < num_runs; ++run) {
+					const bool expired = delays[run] != unbounded_tick && v[run] + delays[run] > upper;
+					delays[run]        = expired ? unbounded_tick : delays[run];
+				}
+			}
+			for (std::size_t run = 0; run < num_runs; ++run) {
+				const bool better        = delays[run] < controller_delays[run];
+				controller_delays[run]   = better ? delays[run] : controller_delays[run];
+				controller_choices[run]  = better ? m : controller_choices[run];
+			}
+		}
+
+		// Decide which transition each run takes.
+		std::fill(std::begin(delays), std::end(delays), 0);
+		std::fill(std::begin(resets), std::end(resets), 0);
+		for (std::size_t run = 0; run < num_runs; ++run) {
+			if (!active[run]) {
+				continue;
+			}
+			const bool controller_can_act  = controller_delays[run] != unbounded_tick;
+			const bool environment_can_act = num_environment_enabled[run] > 0;
+			std::optional<std::size_t> plant_transition;
+			std::optional<std::size_t> controller_transition;
+			Tick                       delay = environment_delays[run];
+			if (controller_can_act
+			    && (!environment_can_act || controller_delays[run] <= environment_delays[run])) {
+				delay                 = controller_delays[run];
+				plant_transition      = moves[controller_choices[run]].plant_transition;
+				controller_transition = moves[controller_choices[run]].controller_transition;
+			} else if (environment_can_act) {
+				plant_transition = environment_choices[run];
+				if (system.controller) {
+					controller_transition = find_transition(*system.controller,
+					                                        controller_locations[run],
+					                                        plant.actions[*plant_transition],
+					                                        clocks,
+					                                        run,
+					                                        delay);
+					if (!controller_transition) {
+						++statistics.num_uncovered_actions;
+						active[run] = 0;
+						--num_active;
+						continue;
+					}
+				}
+			}
+			if (times[run] + delay > options.time_horizon) {
+				active[run] = 0;
+				--num_active;
+				continue;
+			}
+			delays[run] = delay;
+			times[run] += delay;
+			if (!plant_transition) {
+				continue;
+			}
+			const auto action    = plant.actions[*plant_transition];
+			plant_locations[run] = plant.targets[*plant_transition];
+			resets[run]          = plant.resets[*plant_transition];
+			++statistics.action_counts[action];
+			++statistics.num_steps;
+			bool controller_leaf = false;
+			if (controller_transition) {
+				const auto &controller    = *system.controller;
+				const auto  target        = controller.targets[*controller_transition];
+				controller_locations[run] = target;
+				resets[run] |= controller.resets[*controller_transition];
+				controller_leaf =
+				  controller.location_offsets[target] == controller.location_offsets[target + 1];
+				statistics.num_controller_leaves += controller_leaf;
+			}
+			// Update the monitor before a run stops in a controller leaf, the last action may still
+			// cause a violation.
+			bool violation = false;
+			if (system.monitor) {
+				if (const auto monitor_transition = find_transition(
+				      *system.monitor, monitor_locations[run], action, clocks, run, delay)) {
+					monitor_locations[run] = system.monitor->targets[*monitor_transition];
+					resets[run] |= system.monitor->resets[*monitor_transition];
+				}
+				violation = plant.final_locations[plant_locations[run]]
+				            && system.monitor->final_locations[monitor_locations[run]];
+			}
+			if (violation) {
+				++statistics.num_violations;
+				statistics.min_violation_time =
+				  std::min(statistics.min_violation_time.value_or(unbounded_tick), times[run]);
+				statistics.max_violation_time =
+				  std::max(statistics.max_violation_time.value_or(0), times[run]);
+				violation_time_sum += static_cast<double>(times[run]);
+			}
+			if (violation || controller_leaf) {
+				active[run] = 0;
+				--num_active;
+			}
+		}
+
+		// Let time pass and reset the clocks.
+		for (std::size_t clock = 0; clock < num_clocks; ++clock) {
+			Tick *v = clocks[clock].data();
+			for (std::size_t run = 0; run < num_runs; ++run) {
+				const Tick value = v[run] + delays[run];
+				v[run]           = ((resets[run] >> clock) & 1) ? 0 : value;
+			}
+		}
+	}
+	if (statistics.num_violations > 0) {
+		statistics.mean_violation_time =
+		  violation_time_sum / static_cast<double>(statistics.num_violations);
+	}
+	statistics.duration = std::chrono::steady_clock::now() - start;
+	return statistics;
+}
+
+} // namespace controller_synthesis
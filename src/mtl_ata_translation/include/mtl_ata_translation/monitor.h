@@ -0,0 +1,55 @@
+/***************************************************************************
+ *  monitor.h - Compile safety MTL fragments into deterministic TA monitors
+ *
+ *  Created:   Sun 18 Oct 10:12:31 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "automata/ta.h"
+#include "mtl/MTLFormula.h"
+#include "translator.h"
+
+#include <set>
+#include <string>
+
+namespace mtl_ata_translation {
+
+/** Check whether the formula is in the fragment that can be compiled into a deterministic monitor.
+ * The fragment consists of all disjunctions of timed eventualities F_I b, where b is a Boolean
+ * combination of atomic propositions and the bounds of each interval I are integers. Each such
+ * formula describes a bad event that occurs within a fixed time window, and thus it can be
+ * monitored with a single clock that is never reset.
+ * @param formula The formula to check
+ * @return true if translate_to_monitor can be applied to the formula
+ */
+bool is_monitorable(const logic::MTLFormula<ActionType> &formula);
+
+/** Compile a formula into a deterministic timed automaton.
+ * The resulting automaton reads the same timed words as the ATA constructed by translate and
+ * accepts exactly the same language. In contrast to the ATA, it is deterministic and complete, so
+ * it can be composed with the plant and the search does not need to track sets of ATA states.
+ * The formula must be in the fragment accepted by is_monitorable.
+ * @param formula The formula to compile
+ * @param alphabet The alphabet that the monitor should read, defaults to the symbols of the formula
+ * @return A deterministic TA with the locations "init", "wait", and "violation", where "violation"
+ * is the only final location.
+ */
+automata::ta::TimedAutomaton<std::string, ActionType>
+translate_to_monitor(const logic::MTLFormula<ActionType> &          formula,
+                     std::set<logic::AtomicProposition<ActionType>> alphabet = {});
+
+} // namespace mtl_ata_translation
@@ -0,0 +1,241 @@
+/***************************************************************************
+ *  monitor.cpp - Compile safety MTL fragments into deterministic TA monitors
+ *
+ *  Created:   Sun 18 Oct 10:12:31 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "mtl_ata_translation/monitor.h"
+
+#include "automata/automata.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace mtl_ata_translation {
+
+using automata::AtomicClockConstraintT;
+using automata::ClockConstraint;
+using automata::Endpoint;
+using automata::Time;
+using logic::AtomicProposition;
+using logic::LOP;
+using logic::MTLFormula;
+using logic::TimeInterval;
+using logic::TimePoint;
+using utilities::arithmetic::BoundType;
+using Location   = automata::ta::Location<std::string>;
+using Transition = automata::ta::Transition<std::string, ActionType>;
+
+namespace {
+
+const std::string monitor_clock{"monitor"};
+
+/// Collect the disjuncts of a formula in positive normal form.
+void
+collect_disjuncts(const MTLFormula<ActionType> &formula, std::vector<MTLFormula<ActionType>> &res)
+{
+	if (formula.get_operator() == LOP::LOR) {
+		for (const auto &operand : formula.get_operands()) {
+			collect_disjuncts(operand, res);
+		}
+	} else {
+		res.push_back(formula);
+	}
+}
+
+/// Check whether the formula only talks about the current symbol.
+bool
+is_state_formula(const MTLFormula<ActionType> &formula)
+{
+	switch (formula.get_operator()) {
+	case LOP::TRUE:
+	case LOP::FALSE:
+	case LOP::AP: return true;
+	case LOP::LNEG:
+	case LOP::LAND:
+	case LOP::LOR:
+		return std::all_of(std::begin(formula.get_operands()),
+		                   std::end(formula.get_operands()),
+		                   [](const auto &operand) { return is_state_formula(operand); });
+	case LOP::LUNTIL:
+	case LOP::LDUNTIL: return false;
+	}
+	return false;
+}
+
+/// Evaluate a state formula on a single symbol.
+bool
+holds_on(const MTLFormula<ActionType> &formula, const AtomicProposition<ActionType> &symbol)
+{
+	switch (formula.get_operator()) {
+	case LOP::TRUE: return true;
+	case LOP::FALSE: return false;
+	case LOP::AP: return formula.get_atomicProposition() == symbol;
+	case LOP::LNEG: return !holds_on(formula.get_operands().front(), symbol);
+	case LOP::LAND:
+		return std::all_of(std::begin(formula.get_operands()),
+		                   std::end(formula.get_operands()),
+		                   [&symbol](const auto &operand) { return holds_on(operand, symbol); });
+	case LOP::LOR:
+		return std::any_of(std::begin(formula.get_operands()),
+		                   std::end(formula.get_operands()),
+		                   [&symbol](const auto &operand) { return holds_on(operand, symbol); });
+	default: throw std::logic_error("Cannot evaluate a temporal formula on a single symbol");
+	}
+}
+
+bool
+is_integral_bound(TimePoint bound, BoundType type)
+{
+	return type == BoundType::INFTY || (bound >= 0 && std::floor(bound) == bound);
+}
+
+bool
+is_monitorable_disjunct(const MTLFormula<ActionType> &formula)
+{
+	if (formula.get_operator() != LOP::LUNTIL
+	    || formula.get_operands().front().get_operator() != LOP::TRUE
+	    || !is_state_formula(formula.get_operands().back())) {
+		return false;
+	}
+	const auto interval = formula.get_interval();
+	return is_integral_bound(interval.lower(), interval.lowerBoundType())
+	       && is_integral_bound(interval.upper(), interval.upperBoundType());
+}
+
+Endpoint
+get_largest_finite_bound(const TimeInterval &interval)
+{
+	Endpoint res = 0;
+	if (interval.lowerBoundType() != BoundType::INFTY) {
+		res = std::max(res, static_cast<Endpoint>(interval.lower()));
+	}
+	if (interval.upperBoundType() != BoundType::INFTY) {
+		res = std::max(res, static_cast<Endpoint>(interval.upper()));
+	}
+	return res;
+}
+
+/** Compute the guard that describes the region indexes [first, last].
+ * The region index 2 * max_constant + 1 describes all values larger than max_constant.
+ */
+std::multimap<std::string, ClockConstraint>
+get_guard(std::size_t first, std::size_t last, Endpoint max_constant)
+{
+	std::multimap<std::string, ClockConstraint> guard;
+	if (first > 0) {
+		if (first % 2 == 0) {
+			guard.emplace(monitor_clock,
+			              AtomicClockConstraintT<std::greater_equal<Time>>(
+			                static_cast<Endpoint>(first / 2)));
+		} else {
+			guard.emplace(monitor_clock,
+			              AtomicClockConstraintT<std::greater<Time>>(static_cast<Endpoint>(first / 2)));
+		}
+	}
+	if (last < 2 * max_constant + 1) {
+		if (last % 2 == 0) {
+			guard.emplace(monitor_clock,
+			              AtomicClockConstraintT<std::less_equal<Time>>(static_cast<Endpoint>(last / 2)));
+		} else {
+			guard.emplace(monitor_clock,
+			              AtomicClockConstraintT<std::less<Time>>(static_cast<Endpoint>(last / 2 + 1)));
+		}
+	}
+	return guard;
+}
+
+} // namespace
+
+bool
+is_monitorable(const MTLFormula<ActionType> &formula)
+{
+	std::vector<MTLFormula<ActionType>> disjuncts;
+	collect_disjuncts(formula.to_positive_normal_form(), disjuncts);
+	return std::all_of(std::begin(disjuncts), std::end(disjuncts), is_monitorable_disjunct);
+}
+
+automata::ta::TimedAutomaton<std::string, ActionType>
+translate_to_monitor(const MTLFormula<ActionType> &          formula,
+                     std::set<AtomicProposition<ActionType>> alphabet)
+{
+	const auto pnf = formula.to_positive_normal_form();
+	if (!is_monitorable(pnf)) {
+		std::stringstream ss;
+		ss << "The formula " << formula << " cannot be compiled into a deterministic monitor";
+		throw std::invalid_argument(ss.str());
+	}
+	if (alphabet.empty()) {
+		alphabet = pnf.get_alphabet();
+	}
+	std::vector<MTLFormula<ActionType>> disjuncts;
+	collect_disjuncts(pnf, disjuncts);
+	Endpoint max_constant = 0;
+	for (const auto &disjunct : disjuncts) {
+		max_constant = std::max(max_constant, get_largest_finite_bound(disjunct.get_interval()));
+	}
+
+	const Location init{"init"};
+	const Location wait{"wait"};
+	const Location violation{"violation"};
+	std::set<ActionType> actions;
+	for (const auto &symbol : alphabet) {
+		actions.insert(symbol.ap_);
+	}
+	automata::ta::TimedAutomaton<std::string, ActionType> monitor{actions, init, {violation}};
+	monitor.add_location(wait);
+	monitor.add_clock(monitor_clock);
+	const std::size_t num_regions = 2 * max_constant + 2;
+	for (const auto &symbol : alphabet) {
+		// The first symbol is consumed by the ATA's initial location and never satisfies a disjunct.
+		monitor.add_transition(Transition{init, symbol.ap_, wait});
+		monitor.add_transition(Transition{violation, symbol.ap_, violation});
+		// Mark all regions of the (never reset) monitor clock in which reading the symbol satisfies
+		// one of the disjuncts.
+		std::vector<bool> bad_region(num_regions, false);
+		for (const auto &disjunct : disjuncts) {
+			if (!holds_on(disjunct.get_operands().back(), symbol)) {
+				continue;
+			}
+			const auto interval = disjunct.get_interval();
+			for (std::size_t region = 0; region < num_regions; ++region) {
+				// A representative value of the region.
+				const TimePoint value = region % 2 == 0 ? region / 2 : region / 2 + 0.5;
+				if (interval.contains(value)) {
+					bad_region[region] = true;
+				}
+			}
+		}
+		// Each maximal run of regions with the same status results in one transition. The runs are
+		// disjoint, hence the monitor is deterministic.
+		std::size_t first = 0;
+		for (std::size_t region = 1; region <= num_regions; ++region) {
+			if (region == num_regions || bad_region[region] != bad_region[first]) {
+				monitor.add_transition(Transition{wait,
+				                                  symbol.ap_,
+				                                  bad_region[first] ? violation : wait,
+				                                  get_guard(first, region - 1, max_constant)});
+				first = region;
+			}
+		}
+	}
+	return monitor;
+}
+
+} // namespace mtl_ata_translation
@@ -0,0 +1,186 @@
+/***************************************************************************
+ *  ata_analysis.h - Static analysis of ATA locations of translated MTL formulas
+ *
+ *  Created:   Sun 18 Oct 23:12:40 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "canonical_word.h"
+#include "mtl/MTLFormula.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <variant>
+
+namespace search {
+
+template <typename ActionType>
+bool
+can_reach_accepting_configuration(const logic::MTLFormula<ActionType> &                  location,
+                                  const std::set<logic::AtomicProposition<ActionType>> &alphabet);
+
+namespace details {
+
+/** Check whether the ATA formula init(formula, symbol) has a model from which the ATA can reach
+ * an accepting configuration.
+ * This follows the definition of init in the translation by Ouaknine and Worrell.
+ * @param formula The MTL formula in positive normal form
+ * @param symbol The symbol that is read
+ * @param alphabet The alphabet of the ATA
+ * @return false if every model of init(formula, symbol) is hopeless
+ */
+template <typename ActionType>
+bool
+init_can_reach_accepting_configuration(
+  const logic::MTLFormula<ActionType> &                  formula,
+  const logic::AtomicProposition<ActionType> &           symbol,
+  const std::set<logic::AtomicProposition<ActionType>> &alphabet)
+{
+	const auto &operands = formula.get_operands();
+	switch (formula.get_operator()) {
+	case logic::LOP::TRUE: return true;
+	case logic::LOP::FALSE: return false;
+	case logic::LOP::AP: return formula.get_atomicProposition() == symbol;
+	case logic::LOP::LNEG:
+		switch (operands.front().get_operator()) {
+		case logic::LOP::TRUE: return false;
+		case logic::LOP::FALSE: return true;
+		case logic::LOP::AP: return operands.front().get_atomicProposition() != symbol;
+		default: return true;
+		}
+	case logic::LOP::LAND:
+		return std::all_of(std::begin(operands), std::end(operands), [&](const auto &operand) {
+			return init_can_reach_accepting_configuration(operand, symbol, alphabet);
+		});
+	case logic::LOP::LOR:
+		return std::any_of(std::begin(operands), std::end(operands), [&](const auto &operand) {
+			return init_can_reach_accepting_configuration(operand, symbol, alphabet);
+		});
+	case logic::LOP::LUNTIL:
+	case logic::LOP::LDUNTIL: return can_reach_accepting_configuration(formula, alphabet);
+	}
+	return true;
+}
+
+} // namespace details
+
+/** Check whether an ATA location of a translated MTL formula may reach an accepting configuration.
+ * A dual until location is accepting. An until location phi_1 U_I phi_2 is not accepting and can
+ * only be left by reading a symbol that satisfies phi_2 while the clock is in I. Thus, it is
+ * hopeless if I is empty or if no symbol leads to a model of init(phi_2) that may reach an
+ * accepting configuration itself. As the ATA sink location is never left, it is hopeless. All other
+ * locations are assumed to be able to reach an accepting configuration.
+ * The analysis over-approximates the locations that may reach an accepting configuration, so a
+ * configuration that contains a hopeless location is never accepting, and neither are its
+ * successors.
+ * @param location The ATA location, i.e., an MTL formula in positive normal form
+ * @param alphabet The alphabet of the ATA
+ * @return false if the location can never reach an accepting configuration
+ */
+template <typename ActionType>
+bool
+can_reach_accepting_configuration(const logic::MTLFormula<ActionType> &                  location,
+                                  const std::set<logic::AtomicProposition<ActionType>> &alphabet)
+{
+	switch (location.get_operator()) {
+	case logic::LOP::LDUNTIL: return true;
+	case logic::LOP::LUNTIL:
+		if (location.get_interval().is_empty()) {
+			return false;
+		}
+		return std::any_of(std::begin(alphabet), std::end(alphabet), [&](const auto &symbol) {
+			return details::init_can_reach_accepting_configuration(location.get_operands().back(),
+			                                                       symbol,
+			                                                       alphabet);
+		});
+	case logic::LOP::AP:
+		return location != logic::MTLFormula<ActionType>{logic::AtomicProposition<ActionType>{"sink"}};
+	default: return true;
+	}
+}
+
+/** Check whether an ATA region state can never be part of an accepting configuration.
+ * Additionally to the static analysis of the location, an until location phi_1 U_I phi_2 is
+ * hopeless once its clock has passed the upper bound of I, as the clock only increases until the
+ * location is left. As the maximal region index of an until location is always larger than the last
+ * region index that satisfies the upper bound of its interval if the upper bound does not exceed K,
+ * a saturated clock is also beyond the upper bound.
+ * @param state The ATA region state to check
+ * @param alphabet The alphabet of the ATA
+ * @return true if no configuration with the state can ever reach an accepting configuration
+ */
+template <typename ActionType>
+bool
+is_hopeless(const ATARegionState<ActionType> &                     state,
+            const std::set<logic::AtomicProposition<ActionType>> &alphabet)
+{
+	if (!can_reach_accepting_configuration(state.formula, alphabet)) {
+		return true;
+	}
+	if (state.formula.get_operator() != logic::LOP::LUNTIL) {
+		return false;
+	}
+	using utilities::arithmetic::BoundType;
+	const auto interval = state.formula.get_interval();
+	// The region index 2 * n is the clock value n and the region index 2 * n + 1 is the open
+	// interval (n, n + 1). Find the last region that contains a clock value that satisfies the bound.
+	RegionIndex last_region_index;
+	switch (interval.upperBoundType()) {
+	case BoundType::INFTY: return false;
+	case BoundType::WEAK: {
+		// A weak bound c is satisfied in the region 2 * c if c is an integer, and in the open interval
+		// below c otherwise.
+		const auto floor  = std::floor(interval.upper());
+		last_region_index = 2 * static_cast<RegionIndex>(floor) + (floor == interval.upper() ? 0 : 1);
+		break;
+	}
+	case BoundType::STRICT: {
+		// A strict bound c is never satisfied at c itself, but always in the open interval below c.
+		const auto ceil = static_cast<RegionIndex>(std::ceil(interval.upper()));
+		if (ceil == 0) {
+			return true;
+		}
+		last_region_index = 2 * ceil - 1;
+		break;
+	}
+	}
+	return state.region_index > last_region_index;
+}
+
+/** Check whether a canonical word can never reach an accepting ATA configuration.
+ * @param word The canonical word to check
+ * @param alphabet The alphabet of the ATA
+ * @return true if the word contains a hopeless ATA region state
+ */
+template <typename Location, typename ActionType>
+bool
+is_hopeless(const CanonicalABWord<Location, ActionType> &         word,
+            const std::set<logic::AtomicProposition<ActionType>> &alphabet)
+{
+	return std::any_of(std::begin(word), std::end(word), [&alphabet](const auto &partition) {
+		return std::any_of(std::begin(partition),
+		                   std::end(partition),
+		                   [&alphabet](const auto &symbol) {
+			                   return std::holds_alternative<ATARegionState<ActionType>>(symbol)
+			                          && is_hopeless(std::get<ATARegionState<ActionType>>(symbol),
+			                                         alphabet);
+		                   });
+	});
+}
+
+} // namespace search
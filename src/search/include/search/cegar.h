@@ -0,0 +1,229 @@
+/***************************************************************************
+ *  cegar.h - Counterexample-guided abstraction refinement of the plant clocks
+ *
+ *  Created:   Sun 18 Oct 21:02:47 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "automata/ta.h"
+#include "automata/ta_slicing.h"
+#include "create_controller.h"
+#include "search.h"
+#include "verify_controller.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace controller_synthesis {
+
+/** The result of a synthesis with abstraction refinement. */
+template <typename ActionT>
+struct CegarResult
+{
+	/** The label of the concrete game, either TOP or BOTTOM. */
+	search::NodeLabel label{search::NodeLabel::UNLABELED};
+	/** The controller if the controller wins. */
+	std::optional<automata::ta::TimedAutomaton<ControllerLocation, ActionT>> controller;
+	/** The clocks whose environment guards are tracked in each iteration. */
+	std::vector<std::set<std::string>> tracked_clocks;
+	/** The number of abstract search nodes summed over all iterations. */
+	std::size_t num_nodes{0};
+	/** The number of abstract games that the environment won with a relaxed guard. */
+	std::size_t num_spurious_counter_strategies{0};
+	/** The time spent on the synthesis. */
+	std::chrono::nanoseconds duration{0};
+};
+
+namespace details {
+
+/** Abstract a plant by relaxing the environment's guards.
+ * The guards of environment transitions are only kept for the given clocks, all guards of the
+ * controller's transitions are kept. Afterwards, all clocks that no longer occur in any guard are
+ * removed along with their resets. As only guards of the environment are relaxed, the abstract
+ * plant allows more behaviors of the environment, but the same behaviors of the controller. Thus,
+ * a controller that wins on the abstract plant also wins on the concrete plant.
+ * @see automata::ta::restrict_clocks
+ * @param plant The concrete plant
+ * @param clocks The clocks whose environment guards are kept
+ * @param environment_actions The actions controlled by the environment
+ * @return The abstract plant
+ */
+template <typename LocationT, typename ActionT>
+automata::ta::TimedAutomaton<LocationT, ActionT>
+abstract_plant(const automata::ta::TimedAutomaton<LocationT, ActionT> &plant,
+               const std::set<std::string> &                           clocks,
+               const std::set<ActionT> &                               environment_actions)
+{
+	std::vector<automata::ta::Transition<LocationT, ActionT>> transitions;
+	for (const auto &[source, transition] : plant.get_transitions()) {
+		std::multimap<std::string, automata::ClockConstraint> guards;
+		std::copy_if(std::begin(transition.get_guards()),
+		             std::end(transition.get_guards()),
+		             std::inserter(guards, std::end(guards)),
+		             [&](const auto &guard) {
+			             return environment_actions.count(transition.symbol_) == 0
+			                    || clocks.count(guard.first) > 0;
+		             });
+		transitions.emplace_back(
+		  transition.source_, transition.symbol_, transition.target_, guards, transition.clock_resets_);
+	}
+	const automata::ta::TimedAutomaton<LocationT, ActionT> relaxed{plant.get_locations(),
+	                                                               plant.get_alphabet(),
+	                                                               plant.get_initial_location(),
+	                                                               plant.get_final_locations(),
+	                                                               plant.get_clocks(),
+	                                                               transitions};
+	return automata::ta::restrict_clocks(relaxed, automata::ta::get_constrained_clocks(relaxed));
+}
+
+/** Get the clocks that occur in a guard of a transition with one of the given actions. */
+template <typename LocationT, typename ActionT>
+std::set<std::string>
+get_guarded_clocks(const automata::ta::TimedAutomaton<LocationT, ActionT> &plant,
+                   const std::set<ActionT> &                               actions)
+{
+	std::set<std::string> res;
+	for (const auto &[source, transition] : plant.get_transitions()) {
+		if (actions.count(transition.symbol_) == 0) {
+			continue;
+		}
+		for (const auto &[clock, constraint] : transition.get_guards()) {
+			res.insert(clock);
+		}
+	}
+	return res;
+}
+
+/** Get the environment actions on a failing trace of a search tree that the environment wins.
+ * Starting at the root, follow a child labeled with BOTTOM until a leaf is reached. This is a
+ * trace along which the environment wins, e.g., because it reaches a bad node. For each node on the
+ * trace, collect the environment actions of the incoming edge.
+ * @param root The root of the search tree, labeled with BOTTOM
+ * @param environment_actions The actions controlled by the environment
+ * @return The environment actions that occur on the failing trace
+ */
+template <typename LocationT, typename ActionT>
+std::set<ActionT>
+get_failing_trace_actions(const search::SearchTreeNode<LocationT, ActionT> *root,
+                          const std::set<ActionT> &                          environment_actions)
+{
+	std::set<ActionT> res;
+	for (const auto *node = root; node != nullptr;) {
+		for (const auto &[increment, action] : node->incoming_actions) {
+			if (environment_actions.count(action) > 0) {
+				res.insert(action);
+			}
+		}
+		const auto child =
+		  std::find_if(std::begin(node->children), std::end(node->children), [](const auto &child) {
+			  return child->label == search::NodeLabel::BOTTOM;
+		  });
+		node = child == std::end(node->children) ? nullptr : child->get();
+	}
+	return res;
+}
+
+} // namespace details
+
+/** Synthesize a controller with counterexample-guided abstraction refinement.
+ * Instead of searching on the concrete plant, start with an abstraction that relaxes the guards of
+ * the environment and only keeps those of some clocks. Clocks that only occur in relaxed guards are
+ * dropped, so the abstract game has fewer clocks. Solve the abstract game with the tree search:
+ * - If the controller wins the abstract game, it also wins the concrete game, because the abstract
+ *   environment can do everything that the concrete environment can do. The controller is returned.
+ * - If the environment wins the abstract game, the counter-strategy may rely on an environment
+ *   action whose concrete guard was relaxed. Follow a failing trace in the abstract search tree and
+ *   track the clocks in the guards of the environment actions on that trace in the next iteration.
+ * If none of these clocks is untracked, all clocks in environment guards are tracked. Once all of
+ * them are tracked, the abstraction is equivalent to the concrete plant and its result is final.
+ * Easy instances whose environment guards do not matter thus only search the smaller abstract game.
+ * @param plant The concrete plant
+ * @param ata The specification of undesired behaviors
+ * @param controller_actions The actions that the controller may decide to take
+ * @param environment_actions The actions controlled by the environment
+ * @param K The maximal constant occurring in a clock constraint of the concrete problem
+ * @param initial_clocks The clocks whose environment guards are tracked in the first abstraction
+ * @param multi_threaded If true, run the search multi-threaded
+ * @return The result, including the controller if the controller wins
+ */
+template <typename LocationT, typename ActionT>
+CegarResult<ActionT>
+synthesize_with_cegar(const automata::ta::TimedAutomaton<LocationT, ActionT> &plant,
+                      SpecificationATA<ActionT> *                             ata,
+                      const std::set<ActionT> &                               controller_actions,
+                      const std::set<ActionT> &                               environment_actions,
+                      search::RegionIndex                                     K,
+                      const std::set<std::string> &initial_clocks = {},
+                      bool                         multi_threaded = true)
+{
+	const auto start = std::chrono::steady_clock::now();
+	const auto environment_clocks = details::get_guarded_clocks(plant, environment_actions);
+	CegarResult<ActionT>  result;
+	std::set<std::string> tracked;
+	std::set_intersection(std::begin(initial_clocks),
+	                      std::end(initial_clocks),
+	                      std::begin(environment_clocks),
+	                      std::end(environment_clocks),
+	                      std::inserter(tracked, std::end(tracked)));
+	while (true) {
+		result.tracked_clocks.push_back(tracked);
+		const bool concrete = tracked == environment_clocks;
+		const auto abstract = details::abstract_plant(plant, tracked, environment_actions);
+		search::TreeSearch<LocationT, ActionT> search{
+		  &abstract, ata, controller_actions, environment_actions, K, true, true};
+		search.build_tree(multi_threaded);
+		result.num_nodes += search.get_size();
+		const search::NodeLabel label = search.get_root()->label;
+		SPDLOG_INFO("CEGAR iteration {} with clocks {{{}}}: {} nodes, the {} wins",
+		            result.tracked_clocks.size(),
+		            fmt::join(tracked, ", "),
+		            search.get_size(),
+		            label == search::NodeLabel::TOP ? "controller" : "environment");
+		if (label == search::NodeLabel::TOP) {
+			result.label = search::NodeLabel::TOP;
+			result.controller.emplace(create_compact_controller(search.get_root(), K));
+			break;
+		}
+		if (concrete) {
+			result.label = search::NodeLabel::BOTTOM;
+			break;
+		}
+		++result.num_spurious_counter_strategies;
+		const auto previous_size = tracked.size();
+		for (const auto &clock : details::get_guarded_clocks(
+		       plant, details::get_failing_trace_actions(search.get_root(), environment_actions))) {
+			if (environment_clocks.count(clock) > 0) {
+				tracked.insert(clock);
+			}
+		}
+		if (tracked.size() == previous_size) {
+			tracked = environment_clocks;
+		}
+	}
+	result.duration =
+	  std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	return result;
+}
+
+} // namespace controller_synthesis
@@ -0,0 +1,304 @@
+/***************************************************************************
+ *  constant_normalization.h - Rescale the time constants of a synthesis problem
+ *
+ *  Created:   Mon 19 Oct 00:08:31 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "automata/automata.h"
+#include "automata/ta.h"
+#include "mtl/MTLFormula.h"
+#include "utilities/numbers.h"
+
+#include <fmt/format.h>
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace search {
+
+/** @brief A rescaling of the time unit of a synthesis problem.
+ * Each constant c of the original problem becomes c * multiplier / divisor in the normalized
+ * problem. As timed automata and MTL are invariant under scaling the time, a controller for the
+ * normalized problem is a controller for the original problem after scaling its constants back.
+ */
+struct ConstantNormalization
+{
+	/** The factor that makes all constants integers. */
+	automata::Endpoint multiplier{1};
+	/** The greatest common divisor of all constants after applying the multiplier. */
+	automata::Endpoint divisor{1};
+};
+
+namespace details {
+
+/** Get the smallest positive integer d such that value * d is an integer.
+ * @param value The constant to check
+ * @param max_denominator The largest denominator to consider
+ * @return The denominator of the value
+ */
+inline automata::Endpoint
+get_denominator(double value, automata::Endpoint max_denominator = 1000)
+{
+	for (automata::Endpoint denominator = 1; denominator <= max_denominator; ++denominator) {
+		const double scaled = value * denominator;
+		if (utilities::is_approx_same(scaled, std::round(scaled))) {
+			return denominator;
+		}
+	}
+	throw std::invalid_argument(
+	  fmt::format("Cannot normalize the constant {}, it is not a fraction with a denominator of at "
+	              "most {}",
+	              value,
+	              max_denominator));
+}
+
+/** Compute the least common multiple of two endpoints.
+ * @param a The first endpoint
+ * @param b The second endpoint
+ * @return The least common multiple of a and b
+ * @throw std::overflow_error if the least common multiple is not representable as an endpoint
+ */
+inline automata::Endpoint
+checked_lcm(automata::Endpoint a, automata::Endpoint b)
+{
+	if (a == 0 || b == 0) {
+		return 0;
+	}
+	const automata::Endpoint factor = a / std::gcd(a, b);
+	if (factor > std::numeric_limits<automata::Endpoint>::max() / b) {
+		throw std::overflow_error(
+		  fmt::format("Cannot normalize the constants, the least common multiple of the denominators "
+		              "{} and {} is too large",
+		              a,
+		              b));
+	}
+	return factor * b;
+}
+
+/** Collect the bounds of all intervals in a formula. */
+template <typename ActionType>
+void
+collect_interval_bounds(const logic::MTLFormula<ActionType> &formula, std::vector<double> *bounds)
+{
+	using utilities::arithmetic::BoundType;
+	if (formula.get_operator() == logic::LOP::LUNTIL
+	    || formula.get_operator() == logic::LOP::LDUNTIL) {
+		const auto interval = formula.get_interval();
+		if (interval.lowerBoundType() != BoundType::INFTY) {
+			bounds->push_back(interval.lower());
+		}
+		if (interval.upperBoundType() != BoundType::INFTY) {
+			bounds->push_back(interval.upper());
+		}
+	}
+	for (const auto &operand : formula.get_operands()) {
+		collect_interval_bounds(operand, bounds);
+	}
+}
+
+/** Scale all guard constants of a timed automaton.
+ * @param ta The timed automaton to scale
+ * @param scale The function that computes the new constant from the old one
+ * @return The timed automaton with the scaled guards
+ */
+template <typename LocationT, typename ActionType, typename ScaleFunction>
+automata::ta::TimedAutomaton<LocationT, ActionType>
+scale_guards(const automata::ta::TimedAutomaton<LocationT, ActionType> &ta, ScaleFunction scale)
+{
+	std::vector<automata::ta::Transition<LocationT, ActionType>> transitions;
+	for (const auto &[source, transition] : ta.get_transitions()) {
+		std::multimap<std::string, automata::ClockConstraint> guards;
+		for (const auto &[clock, constraint] : transition.get_guards()) {
+			guards.emplace(clock, std::visit(
+			                        [&scale](const auto &atomic) -> automata::ClockConstraint {
+				                        return std::decay_t<decltype(atomic)>(
+				                          scale(atomic.get_comparand()));
+			                        },
+			                        constraint));
+		}
+		transitions.emplace_back(transition.source_,
+		                         transition.symbol_,
+		                         transition.target_,
+		                         guards,
+		                         transition.clock_resets_);
+	}
+	return automata::ta::TimedAutomaton<LocationT, ActionType>{ta.get_locations(),
+	                                                           ta.get_alphabet(),
+	                                                           ta.get_initial_location(),
+	                                                           ta.get_final_locations(),
+	                                                           ta.get_clocks(),
+	                                                           transitions};
+}
+
+/** Scale all interval bounds of an MTL formula.
+ * @param formula The formula to scale
+ * @param scale The function that computes the new bound from the old one
+ * @return The formula with the scaled intervals
+ */
+template <typename ActionType, typename ScaleFunction>
+logic::MTLFormula<ActionType>
+scale_intervals(const logic::MTLFormula<ActionType> &formula, ScaleFunction scale)
+{
+	using utilities::arithmetic::BoundType;
+	std::vector<logic::MTLFormula<ActionType>> operands;
+	for (const auto &operand : formula.get_operands()) {
+		operands.push_back(scale_intervals(operand, scale));
+	}
+	switch (formula.get_operator()) {
+	case logic::LOP::AP:
+	case logic::LOP::TRUE:
+	case logic::LOP::FALSE: return formula;
+	case logic::LOP::LNEG: return !operands.front();
+	case logic::LOP::LAND: return logic::MTLFormula<ActionType>::create_conjunction(operands);
+	case logic::LOP::LOR: return logic::MTLFormula<ActionType>::create_disjunction(operands);
+	case logic::LOP::LUNTIL:
+	case logic::LOP::LDUNTIL: {
+		const auto interval = formula.get_interval();
+		const auto scale_bound = [&scale](double bound, BoundType type) {
+			return type == BoundType::INFTY ? bound : scale(bound);
+		};
+		const logic::TimeInterval scaled{scale_bound(interval.lower(), interval.lowerBoundType()),
+		                                 interval.lowerBoundType(),
+		                                 scale_bound(interval.upper(), interval.upperBoundType()),
+		                                 interval.upperBoundType()};
+		if (formula.get_operator() == logic::LOP::LUNTIL) {
+			return operands.front().until(operands.back(), scaled);
+		}
+		return operands.front().dual_until(operands.back(), scaled);
+	}
+	}
+	return formula;
+}
+
+} // namespace details
+
+/** Compute the normalization that rescales all constants of a synthesis problem to the smallest
+ * equivalent integers.
+ * All constants are first multiplied by the least common multiple of their denominators, which
+ * makes them integers, and then divided by their greatest common divisor. As the number of regions
+ * grows with the largest constant, the normalized problem may have much fewer regions, e.g., if all
+ * constants are multiples of 5.
+ * @param plant The plant to be controlled
+ * @param spec The specification of undesired behaviors
+ * @return The normalization of the constants
+ * @throw std::overflow_error if a normalized constant is not representable as an endpoint
+ */
+template <typename LocationT, typename ActionType>
+ConstantNormalization
+get_constant_normalization(const automata::ta::TimedAutomaton<LocationT, ActionType> &plant,
+                           const logic::MTLFormula<ActionType> &                      spec)
+{
+	std::vector<double> constants;
+	for (const auto &[source, transition] : plant.get_transitions()) {
+		for (const auto &[clock, constraint] : transition.get_guards()) {
+			constants.push_back(
+			  std::visit([](const auto &atomic) { return atomic.get_comparand(); }, constraint));
+		}
+	}
+	details::collect_interval_bounds(spec, &constants);
+	ConstantNormalization normalization;
+	for (const auto constant : constants) {
+		normalization.multiplier =
+		  details::checked_lcm(normalization.multiplier, details::get_denominator(constant));
+	}
+	automata::Endpoint divisor = 0;
+	for (const auto constant : constants) {
+		const double scaled = std::round(constant * normalization.multiplier);
+		if (scaled > std::numeric_limits<automata::Endpoint>::max()) {
+			throw std::overflow_error(
+			  fmt::format("Cannot normalize the constant {}, it is too large after multiplying it "
+			              "with {}",
+			              constant,
+			              normalization.multiplier));
+		}
+		divisor = std::gcd(divisor, static_cast<automata::Endpoint>(scaled));
+	}
+	normalization.divisor = divisor == 0 ? 1 : divisor;
+	return normalization;
+}
+
+/** Rescale the guards of a plant.
+ * @param plant The plant to rescale
+ * @param normalization The normalization from get_constant_normalization
+ * @return The plant with normalized constants
+ */
+template <typename LocationT, typename ActionType>
+automata::ta::TimedAutomaton<LocationT, ActionType>
+normalize(const automata::ta::TimedAutomaton<LocationT, ActionType> &plant,
+          const ConstantNormalization &                              normalization)
+{
+	return details::scale_guards(plant, [&normalization](automata::Endpoint constant) {
+		return constant * normalization.multiplier / normalization.divisor;
+	});
+}
+
+/** Rescale the intervals of a specification.
+ * @param spec The specification to rescale
+ * @param normalization The normalization from get_constant_normalization
+ * @return The specification with normalized constants
+ */
+template <typename ActionType>
+logic::MTLFormula<ActionType>
+normalize(const logic::MTLFormula<ActionType> &spec, const ConstantNormalization &normalization)
+{
+	return details::scale_intervals(spec, [&normalization](double bound) {
+		return std::round(bound * normalization.multiplier) / normalization.divisor;
+	});
+}
+
+/** Check whether each integer constant of the normalized problem is an integer in the original
+ * time unit.
+ * @param normalization The normalization from get_constant_normalization
+ * @return true if denormalize can rescale any controller
+ */
+inline bool
+has_integral_time_unit(const ConstantNormalization &normalization)
+{
+	return normalization.divisor % normalization.multiplier == 0;
+}
+
+/** Rescale the guards of a controller for the normalized problem back to the original time unit.
+ * @param controller The controller synthesized for the normalized problem
+ * @param normalization The normalization from get_constant_normalization
+ * @return The controller with constants in the original time unit
+ */
+template <typename LocationT, typename ActionType>
+automata::ta::TimedAutomaton<LocationT, ActionType>
+denormalize(const automata::ta::TimedAutomaton<LocationT, ActionType> &controller,
+            const ConstantNormalization &                              normalization)
+{
+	if (!has_integral_time_unit(normalization)) {
+		throw std::invalid_argument(
+		  fmt::format("Cannot rescale the controller, one time unit of the normalized problem is {}/{} "
+		              "time units of the original problem",
+		              normalization.divisor,
+		              normalization.multiplier));
+	}
+	return details::scale_guards(controller, [&normalization](automata::Endpoint constant) {
+		return constant * (normalization.divisor / normalization.multiplier);
+	});
+}
+
+} // namespace search
@@ -0,0 +1,347 @@
+/***************************************************************************
+ *  controller_stream.h - Create a controller incrementally during the search
+ *
+ *  Created:   Sun 18 Oct 14:02:17 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "automata/ta.h"
+#include "create_controller.h"
+#include "search_tree.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+namespace controller_synthesis {
+
+/** Create a compact controller while the search is still running.
+ * The controller transitions of a node only depend on the node and its children. Once the node is
+ * labeled with TOP, all its ancestors are part of the controller, and all its children are labeled,
+ * these transitions are final and the stream emits them into the controller. Afterwards, the
+ * children labeled with TOP become candidates for the next update. As a label only changes when a
+ * node below it is expanded, an update with the expanded node only checks the candidates on the
+ * path from the node to the root.
+ *
+ * Optionally, the stream also frees the canonical words of all nodes below a node as soon as the
+ * whole controller below the node has been emitted. Unlabeled nodes below non-TOP children are
+ * canceled, as they no longer affect the controller. Sub-trees in which all nodes have been
+ * expanded are destroyed, the others are kept as the search may still have to process their nodes.
+ * This must only be enabled if the search runs single-threaded, because a concurrent expansion may
+ * still read the words of its ancestors. In the multi-threaded case, the tree is kept until the
+ * search has finished.
+ *
+ * The resulting controller has the same transitions as the one created by
+ * create_compact_controller, but the locations may be numbered differently. If the words of a node
+ * have been freed, a later node with the same words gets a new location.
+ */
+template <typename LocationT, typename ActionT>
+class ControllerStream
+{
+public:
+	/** The node type of the search tree. */
+	using Node = search::SearchTreeNode<LocationT, ActionT>;
+	/** The set of canonical words of a controller location. */
+	using WordSet = std::set<search::CanonicalABWord<LocationT, ActionT>>;
+
+	/** Initialize the stream.
+	 * @param root The root of the search tree, which must not be freed before the stream
+	 * @param K The value of the maximal constant occurring anywhere in the input problem
+	 * @param free_words If true, free the canonical words of nodes that have been emitted
+	 * @param location_words If not null, store the set of canonical words of each controller location
+	 * in this map, e.g., for debugging
+	 */
+	ControllerStream(Node *                                 root,
+	                 search::RegionIndex                    K,
+	                 bool                                   free_words     = false,
+	                 std::map<ControllerLocation, WordSet> *location_words = nullptr)
+	: root_(root),
+	  K_(K),
+	  free_words_(free_words),
+	  location_words_(location_words),
+	  controller_({}, automata::ta::Location<ControllerLocation>{get_location(root)}, {})
+	{
+		frontier_.insert(root);
+	}
+
+	/** Emit the transitions of all nodes that have become final since the last update.
+	 * This checks all candidates. If another thread is already updating the stream, the call returns
+	 * immediately.
+	 * @return The number of nodes that have been emitted
+	 */
+	std::size_t
+	update()
+	{
+		std::unique_lock lock{mutex_, std::try_to_lock};
+		if (!lock.owns_lock()) {
+			return 0;
+		}
+		return emit_final_nodes({std::begin(frontier_), std::end(frontier_)});
+	}
+
+	/** Emit the transitions of all nodes that have become final after expanding the given node.
+	 * This only checks the candidates on the path from the node to the root and their descendants
+	 * that become candidates in turn. It may be called concurrently with the search, e.g., from an
+	 * expansion callback. If another thread is already updating the stream, the call returns
+	 * immediately and the remaining nodes are emitted by a later update or by finish.
+	 * @param node The node that has been expanded
+	 * @return The number of nodes that have been emitted
+	 */
+	std::size_t
+	update(Node *node)
+	{
+		std::unique_lock lock{mutex_, std::try_to_lock};
+		if (!lock.owns_lock()) {
+			return 0;
+		}
+		std::vector<Node *> candidates;
+		for (; node != nullptr; node = node->parent) {
+			if (const auto it = frontier_.find(node); it != std::end(frontier_)) {
+				candidates.push_back(*it);
+			}
+		}
+		return emit_final_nodes(std::move(candidates));
+	}
+
+	/** Check whether the whole controller has been emitted.
+	 * @return true if the root is labeled with TOP and there are no pending nodes
+	 */
+	bool
+	is_complete() const
+	{
+		std::lock_guard lock{mutex_};
+		return frontier_.empty();
+	}
+
+	/** Emit all remaining nodes and get the controller.
+	 * This must be called after the search has finished.
+	 * @return The controller as timed automaton
+	 */
+	const automata::ta::TimedAutomaton<ControllerLocation, ActionT> &
+	finish()
+	{
+		std::lock_guard lock{mutex_};
+		emit_final_nodes({std::begin(frontier_), std::end(frontier_)});
+		if (root_->label != search::NodeLabel::TOP) {
+			throw std::invalid_argument(
+			  "Cannot create a controller for a node that is not labeled with TOP");
+		}
+		if (!frontier_.empty()) {
+			throw std::logic_error("Cannot finish the controller, the search tree is not fully labeled");
+		}
+		return controller_;
+	}
+
+	/** Get the controller that has been emitted so far.
+	 * @return The partial controller
+	 */
+	const automata::ta::TimedAutomaton<ControllerLocation, ActionT> &
+	get_controller() const
+	{
+		return controller_;
+	}
+
+	/** Get the number of nodes that have been emitted so far.
+	 * @return The number of emitted nodes
+	 */
+	std::size_t
+	get_num_emitted_nodes() const
+	{
+		std::lock_guard lock{mutex_};
+		return num_emitted_;
+	}
+
+	/** Get the number of nodes whose words have been freed so far.
+	 * @return The number of freed nodes
+	 */
+	std::size_t
+	get_num_freed_nodes() const
+	{
+		std::lock_guard lock{mutex_};
+		return num_freed_;
+	}
+
+	/** Get the number of nodes that have been destroyed so far.
+	 * @return The number of destroyed nodes
+	 */
+	std::size_t
+	get_num_destroyed_nodes() const
+	{
+		std::lock_guard lock{mutex_};
+		return num_destroyed_;
+	}
+
+private:
+	/** Check whether the transitions of a frontier node are final. */
+	static bool
+	is_final(const Node *node)
+	{
+		return node->label == search::NodeLabel::TOP
+		       && std::all_of(std::begin(node->children),
+		                      std::end(node->children),
+		                      [](const auto &child) {
+			                      return child->label != search::NodeLabel::UNLABELED;
+		                      });
+	}
+
+	/** Check whether all nodes of a sub-tree have been expanded, so the search no longer accesses
+	 * them. */
+	static bool
+	is_fully_expanded(const Node *node)
+	{
+		return node->is_expanded
+		       && std::all_of(std::begin(node->children),
+		                      std::end(node->children),
+		                      [](const auto &child) { return is_fully_expanded(child.get()); });
+	}
+
+	/** Emit the final nodes among the candidates and among the children that become candidates. */
+	std::size_t
+	emit_final_nodes(std::vector<Node *> candidates)
+	{
+		std::size_t num_emitted = 0;
+		while (!candidates.empty()) {
+			Node *node = candidates.back();
+			candidates.pop_back();
+			if (frontier_.count(node) == 0 || !is_final(node)) {
+				continue;
+			}
+			frontier_.erase(node);
+			emit(node, &candidates);
+			++num_emitted;
+		}
+		num_emitted_ += num_emitted;
+		return num_emitted;
+	}
+
+	ControllerLocation
+	get_location(const Node *node)
+	{
+		const auto [it, inserted] = ids_.insert({&node->words, num_locations_});
+		if (inserted) {
+			++num_locations_;
+			if (location_words_ != nullptr) {
+				location_words_->emplace(it->second, node->words);
+			}
+		}
+		return it->second;
+	}
+
+	void
+	emit(Node *node, std::vector<Node *> *candidates)
+	{
+		using Transition = automata::ta::Transition<ControllerLocation, ActionT>;
+		const automata::ta::Location<ControllerLocation> source{get_location(node)};
+		std::size_t                                      num_top_children = 0;
+		for (const auto &[successor, successor_constraints] :
+		     details::get_controller_fragment(node, K_)) {
+			const automata::ta::Location<ControllerLocation> target{get_location(successor)};
+			controller_.add_location(target);
+			controller_.add_final_location(target);
+			for (const auto &[action, constraints] : successor_constraints) {
+				for (const auto &[clock, _constraint] : constraints) {
+					controller_.add_clock(clock);
+				}
+				controller_.add_action(action);
+				controller_.add_transition(Transition{source, action, target, constraints, {}});
+			}
+			++num_top_children;
+		}
+		for (const auto &child : node->children) {
+			if (child->label == search::NodeLabel::TOP) {
+				frontier_.insert(child.get());
+				candidates->push_back(child.get());
+			} else if (free_words_) {
+				free_subtree(child.get());
+			}
+		}
+		if (free_words_) {
+			pending_children_[node] = num_top_children;
+			if (num_top_children == 0) {
+				set_done(node);
+			}
+		}
+	}
+
+	/** Cancel all unlabeled nodes of a sub-tree and free the words of its nodes. */
+	void
+	free_subtree(Node *node)
+	{
+		if (node->label == search::NodeLabel::UNLABELED) {
+			node->set_label(search::NodeLabel::CANCELED, true);
+		}
+		for (const auto &child : node->children) {
+			free_subtree(child.get());
+		}
+		free_node(node);
+	}
+
+	void
+	free_node(Node *node)
+	{
+		// The location is identified by the words of the node, so it is no longer found afterwards.
+		if (const auto it = ids_.find(&node->words);
+		    it != std::end(ids_) && it->first == &node->words) {
+			ids_.erase(it);
+		}
+		WordSet{}.swap(node->words);
+		++num_freed_;
+	}
+
+	/** Mark the sub-tree of an emitted node as done, free the node's words, and destroy the child
+	 * sub-trees that the search no longer accesses. */
+	void
+	set_done(Node *node)
+	{
+		pending_children_.erase(node);
+		free_node(node);
+		const auto destroyed = std::partition(std::begin(node->children),
+		                                      std::end(node->children),
+		                                      [](const auto &child) {
+			                                      return !is_fully_expanded(child.get());
+		                                      });
+		for (auto child = destroyed; child != std::end(node->children); ++child) {
+			num_destroyed_ += std::distance(std::begin(**child), std::end(**child));
+		}
+		node->children.erase(destroyed, std::end(node->children));
+		if (node->parent != nullptr) {
+			if (--pending_children_.at(node->parent) == 0) {
+				set_done(node->parent);
+			}
+		}
+	}
+
+	Node *const                                                                root_;
+	const search::RegionIndex                                                  K_;
+	const bool                                                                 free_words_;
+	std::map<ControllerLocation, WordSet> *const                               location_words_;
+	std::map<const WordSet *, ControllerLocation, details::WordSetPointerLess> ids_;
+	ControllerLocation                                                         num_locations_{0};
+	automata::ta::TimedAutomaton<ControllerLocation, ActionT>                  controller_;
+	std::unordered_set<Node *>                                                 frontier_;
+	std::map<const Node *, std::size_t>                                        pending_children_;
+	std::size_t                                                                num_emitted_{0};
+	std::size_t                                                                num_freed_{0};
+	std::size_t                                                                num_destroyed_{0};
+	mutable std::mutex                                                         mutex_;
+};
+
+} // namespace controller_synthesis
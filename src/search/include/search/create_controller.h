@@ -26,10 +26,16 @@
 #include "search/canonical_word.h"
 #include "search/preorder_traversal.h"
 #include "search/synchronous_product.h"
+#include "utilities/priority_thread_pool.h"
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <map>
 #include <stdexcept>
+#include <thread>
+#include <vector>
+
 namespace controller_synthesis {
 
 namespace details {
@@ -58,13 +64,27 @@ get_constraints_from_time_successor(
 	return res;
 }
 
-/** @brief Compute the corresponding constraints from a set of outgoing actions of a node.
- * Given the word of a node and the node's outgoing actions to a successor, we can compute the clock
- * constraints for that transition from the region increments of the outgoing actions. Do this by
- * computing the time successor corresponding to each region increment, then computing the
- * corresponding constraints, and then post-process the constraints such that neighboring intervals
- * are merged into one constraint.
- * @param canonical_words The canonical words of the node.
+/** Get the nth time successor from a precomputed chain of time successors.
+ * @param time_successors The time successors of a word as computed by search::get_time_successors
+ * @param n The region increment
+ * @return The time successor that is reached with the region increment n
+ */
+template <typename LocationT, typename ActionT>
+const search::CanonicalABWord<LocationT, ActionT> &
+get_nth_time_successor(
+  const std::vector<std::pair<search::RegionIndex, search::CanonicalABWord<LocationT, ActionT>>>
+    &                 time_successors,
+  search::RegionIndex n)
+{
+	assert(!time_successors.empty());
+	// The last time successor is its own time successor, all larger increments result in it.
+	return time_successors[std::min(static_cast<std::size_t>(n), time_successors.size() - 1)].second;
+}
+
+/** @brief Compute the constraints of a set of outgoing actions from precomputed time successors.
+ * This computes the same constraints as get_constraints_from_outgoing_actions, but uses the chain
+ * of time successors of the node's reg_a so it can be shared between all successors of the node.
+ * @param time_successors The time successors of the node's reg_a
  * @param actions The outgoing actions of the node as set of pairs (region increment, action name)
  * @param K The value of the maximal constant occurring anywhere in the input problem
  * @return A multimap, where each entry is a pair (a, c), where c is a multimap of clock constraints
@@ -72,21 +92,17 @@ get_constraints_from_time_successor(
  */
 template <typename LocationT, typename ActionT>
 std::multimap<ActionT, std::multimap<std::string, automata::ClockConstraint>>
-get_constraints_from_outgoing_actions(
-  const std::set<search::CanonicalABWord<LocationT, ActionT>> canonical_words,
-  const std::set<std::pair<search::RegionIndex, ActionT>> &   actions,
-  search::RegionIndex                                         K)
+get_constraints_from_time_successors(
+  const std::vector<std::pair<search::RegionIndex, search::CanonicalABWord<LocationT, ActionT>>>
+    &                                                      time_successors,
+  const std::set<std::pair<search::RegionIndex, ActionT>> &actions,
+  search::RegionIndex                                      K)
 {
 	std::map<ActionT, std::set<search::RegionIndex>> good_actions;
 	for (const auto &[region_increment, action] : actions) {
 		good_actions[action].insert(region_increment);
 	}
 
-	// We only need the reg_a of the words. As we know that they are all the same, we can just take
-	// the first one.
-	assert(reg_a(*std::begin(canonical_words)) == reg_a(*std::rbegin(canonical_words)));
-	const auto node_reg_a = reg_a(*std::begin(canonical_words));
-
 	std::multimap<ActionT, std::multimap<std::string, automata::ClockConstraint>> res;
 	for (const auto &[action, increments] : good_actions) {
 		assert(!increments.empty());
@@ -97,18 +113,18 @@ get_constraints_from_outgoing_actions(
 				std::multimap<std::string, automata::ClockConstraint> constraints;
 				if (first_good_increment == increment) {
 					// They are the same, create both constraints at the same time to obtain a = constraint
-					// for even regions. constraints.merge(
+					// for even regions.
 					constraints.merge(get_constraints_from_time_successor(
-					  search::get_nth_time_successor(node_reg_a, *first_good_increment, K),
+					  get_nth_time_successor(time_successors, *first_good_increment),
 					  K,
 					  automata::ta::ConstraintBoundType::BOTH));
 				} else {
 					constraints.merge(get_constraints_from_time_successor(
-					  search::get_nth_time_successor(node_reg_a, *first_good_increment, K),
+					  get_nth_time_successor(time_successors, *first_good_increment),
 					  K,
 					  automata::ta::ConstraintBoundType::LOWER));
 					constraints.merge(get_constraints_from_time_successor(
-					  search::get_nth_time_successor(node_reg_a, *increment, K),
+					  get_nth_time_successor(time_successors, *increment),
 					  K,
 					  automata::ta::ConstraintBoundType::UPPER));
 				}
@@ -120,60 +136,273 @@ get_constraints_from_outgoing_actions(
 	return res;
 }
 
+/** @brief Compute the corresponding constraints from a set of outgoing actions of a node.
+ * Given the word of a node and the node's outgoing actions to a successor, we can compute the clock
+ * constraints for that transition from the region increments of the outgoing actions. Do this by
+ * computing the time successor corresponding to each region increment, then computing the
+ * corresponding constraints, and then post-process the constraints such that neighboring intervals
+ * are merged into one constraint.
+ * @param canonical_words The canonical words of the node.
+ * @param actions The outgoing actions of the node as set of pairs (region increment, action name)
+ * @param K The value of the maximal constant occurring anywhere in the input problem
+ * @return A multimap, where each entry is a pair (a, c), where c is a multimap of clock constraints
+ * necessary when taking action a.
+ */
 template <typename LocationT, typename ActionT>
-void
-add_node_to_controller(
-  const search::SearchTreeNode<LocationT, ActionT> *const node,
-  search::RegionIndex                                     K,
-  automata::ta::TimedAutomaton<std::set<search::CanonicalABWord<LocationT, ActionT>>,
-                               ActionT> *                              controller)
+std::multimap<ActionT, std::multimap<std::string, automata::ClockConstraint>>
+get_constraints_from_outgoing_actions(
+  const std::set<search::CanonicalABWord<LocationT, ActionT>> canonical_words,
+  const std::set<std::pair<search::RegionIndex, ActionT>> &   actions,
+  search::RegionIndex                                         K)
 {
-	using search::NodeLabel;
-	using Transition =
-	  automata::ta::Transition<std::set<search::CanonicalABWord<LocationT, ActionT>>,
-	                           ActionT>;
-	using Location =
-	  automata::ta::Location<std::set<search::CanonicalABWord<LocationT, ActionT>>>;
-	if (node->label != NodeLabel::TOP) {
-		throw std::invalid_argument(
-		  "Cannot create a controller for a node that is not labeled with TOP");
+	// We only need the reg_a of the words. As we know that they are all the same, we can just take
+	// the first one.
+	assert(reg_a(*std::begin(canonical_words)) == reg_a(*std::rbegin(canonical_words)));
+	return get_constraints_from_time_successors(
+	  search::get_time_successors(reg_a(*std::begin(canonical_words)), K), actions, K);
+}
+
+/** The transitions that a single search node contributes to the controller.
+ * Each entry is a successor labeled with TOP together with the constraints of each action that
+ * leads to the successor.
+ */
+template <typename LocationT, typename ActionT>
+using ControllerFragment = std::vector<
+  std::pair<const search::SearchTreeNode<LocationT, ActionT> *,
+            std::multimap<ActionT, std::multimap<std::string, automata::ClockConstraint>>>>;
+
+/** Compute the transitions that a node contributes to the controller.
+ * The time successors of the node's reg_a are computed once and shared between all successors.
+ * This only reads the node and its children and can therefore run concurrently for different nodes.
+ * @param node The node, which must be labeled with TOP
+ * @param K The value of the maximal constant occurring anywhere in the input problem
+ * @return The controller fragment of the node
+ */
+template <typename LocationT, typename ActionT>
+ControllerFragment<LocationT, ActionT>
+get_controller_fragment(const search::SearchTreeNode<LocationT, ActionT> *const node,
+                        search::RegionIndex                                     K)
+{
+	ControllerFragment<LocationT, ActionT> fragment;
+	if (std::none_of(std::begin(node->children), std::end(node->children), [](const auto &child) {
+		    return child->label == search::NodeLabel::TOP;
+	    })) {
+		return fragment;
 	}
+	assert(reg_a(*std::begin(node->words)) == reg_a(*std::rbegin(node->words)));
+	const auto time_successors = search::get_time_successors(reg_a(*std::begin(node->words)), K);
 	for (const auto &successor : node->children) {
-		if (successor->label != NodeLabel::TOP) {
+		if (successor->label != search::NodeLabel::TOP) {
 			continue;
 		}
-		controller->add_location(Location{successor->words});
-		controller->add_final_location(Location{successor->words});
+		fragment.emplace_back(
+		  successor.get(),
+		  get_constraints_from_time_successors(time_successors, successor->incoming_actions, K));
+	}
+	return fragment;
+}
+
+/** Collect all nodes of the controller in pre-order.
+ * These are the root and all of its descendants that are connected to it by nodes labeled with TOP.
+ * The order is the same as the order of a recursive depth-first traversal.
+ * @param root The root of the sub-tree
+ * @return The nodes in pre-order
+ */
+template <typename LocationT, typename ActionT>
+std::vector<const search::SearchTreeNode<LocationT, ActionT> *>
+get_controller_nodes(const search::SearchTreeNode<LocationT, ActionT> *const root)
+{
+	std::vector<const search::SearchTreeNode<LocationT, ActionT> *> nodes;
+	std::vector<const search::SearchTreeNode<LocationT, ActionT> *> stack{root};
+	while (!stack.empty()) {
+		const auto node = stack.back();
+		stack.pop_back();
+		nodes.push_back(node);
+		for (auto child = std::rbegin(node->children); child != std::rend(node->children); ++child) {
+			if ((*child)->label == search::NodeLabel::TOP) {
+				stack.push_back(child->get());
+			}
+		}
+	}
+	return nodes;
+}
 
-		for (const auto &[action, constraints] :
-		     get_constraints_from_outgoing_actions(node->words, successor->incoming_actions, K)) {
+/** Merge the fragment of a node and all its descendants into the controller.
+ * This follows the order of a recursive depth-first traversal, i.e., the sub-tree of a successor
+ * is merged before the next successor.
+ * @param index The index of the node in the list of controller nodes
+ * @param nodes The controller nodes in pre-order
+ * @param fragments The fragment of each node, which are freed after merging them
+ * @param indexes The index of each controller node
+ * @param controller The controller to add the transitions to
+ * @param get_location A function that maps a node to its location in the controller
+ */
+template <typename LocationT, typename ActionT, typename ControllerLocationT, typename LocationFunction>
+void
+merge_controller_fragments(
+  std::size_t                                                                     index,
+  const std::vector<const search::SearchTreeNode<LocationT, ActionT> *> &         nodes,
+  std::vector<ControllerFragment<LocationT, ActionT>> *const                      fragments,
+  const std::map<const search::SearchTreeNode<LocationT, ActionT> *, std::size_t> &indexes,
+  automata::ta::TimedAutomaton<ControllerLocationT, ActionT> *const                controller,
+  LocationFunction &&                                                             get_location)
+{
+	using Transition = automata::ta::Transition<ControllerLocationT, ActionT>;
+	const auto source   = get_location(nodes[index]);
+	const auto fragment = std::move((*fragments)[index]);
+	(*fragments)[index] = {};
+	for (const auto &[successor, successor_constraints] : fragment) {
+		const auto target = get_location(successor);
+		controller->add_location(target);
+		controller->add_final_location(target);
+		for (const auto &[action, constraints] : successor_constraints) {
 			for (const auto &[clock, _constraint] : constraints) {
 				controller->add_clock(clock);
 			}
 			controller->add_action(action);
-			controller->add_transition(
-			  Transition{Location{node->words}, action, Location{successor->words}, constraints, {}});
+			controller->add_transition(Transition{source, action, target, constraints, {}});
+		}
+		merge_controller_fragments(
+		  indexes.at(successor), nodes, fragments, indexes, controller, get_location);
+	}
+}
+
+/** Add the sub-tree of a node to the controller.
+ * The fragments of the nodes are computed independently, optionally in parallel. They are then
+ * merged into the controller in pre-order, so the locations are discovered in the same order as
+ * with a sequential depth-first traversal.
+ * @param node The node to add, which must be labeled with TOP
+ * @param K The value of the maximal constant occurring anywhere in the input problem
+ * @param controller The controller to add the node's transitions and successors to
+ * @param get_location A function that maps a node to its location in the controller
+ * @param multi_threaded If true, compute the fragments with a thread pool
+ */
+template <typename LocationT, typename ActionT, typename ControllerLocationT, typename LocationFunction>
+void
+add_node_to_controller(const search::SearchTreeNode<LocationT, ActionT> *const           node,
+                       search::RegionIndex                                               K,
+                       automata::ta::TimedAutomaton<ControllerLocationT, ActionT> *const controller,
+                       LocationFunction &&get_location,
+                       bool                multi_threaded = true)
+{
+	using search::NodeLabel;
+	if (node->label != NodeLabel::TOP) {
+		throw std::invalid_argument(
+		  "Cannot create a controller for a node that is not labeled with TOP");
+	}
+	const auto                                          nodes = get_controller_nodes(node);
+	std::vector<ControllerFragment<LocationT, ActionT>> fragments(nodes.size());
+	const std::size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+	if (multi_threaded && num_threads > 1 && nodes.size() > 1) {
+		// Split the nodes into contiguous chunks so that each job does a reasonable amount of work.
+		const std::size_t chunk_size = std::max<std::size_t>(1, nodes.size() / (4 * num_threads));
+		utilities::ThreadPool<long> pool{utilities::ThreadPool<long>::StartOnInit::NO, num_threads};
+		for (std::size_t first = 0; first < nodes.size(); first += chunk_size) {
+			const std::size_t last = std::min(first + chunk_size, nodes.size());
+			pool.add_job([&nodes, &fragments, first, last, K] {
+				for (std::size_t i = first; i < last; ++i) {
+					fragments[i] = get_controller_fragment(nodes[i], K);
+				}
+			});
 		}
-		add_node_to_controller(successor.get(), K, controller);
+		pool.start();
+		pool.finish();
+	} else {
+		for (std::size_t i = 0; i < nodes.size(); ++i) {
+			fragments[i] = get_controller_fragment(nodes[i], K);
+		}
+	}
+	std::map<const search::SearchTreeNode<LocationT, ActionT> *, std::size_t> indexes;
+	for (std::size_t i = 0; i < nodes.size(); ++i) {
+		indexes.emplace(nodes[i], i);
 	}
+	merge_controller_fragments(0, nodes, &fragments, indexes, controller, get_location);
 }
 
+/** Compare two pointers to word sets by the sets they point to. */
+struct WordSetPointerLess
+{
+	/** Compare the pointed-to sets.
+	 * @param first The first set to compare
+	 * @param second The second set to compare
+	 * @return true if the first set is smaller than the second set
+	 */
+	template <typename WordSet>
+	bool
+	operator()(const WordSet *first, const WordSet *second) const
+	{
+		return *first < *second;
+	}
+};
+
 } // namespace details
 
+/** Create a controller from a labeled search tree.
+ * Each location of the controller is the set of canonical words of the corresponding search node.
+ * @param root The root of the labeled search tree
+ * @param K The value of the maximal constant occurring anywhere in the input problem
+ * @param multi_threaded If true, compute the transitions of the nodes in parallel
+ * @return The controller as timed automaton
+ * @see create_compact_controller for a controller with integer locations
+ */
 template <typename LocationT, typename ActionT>
 automata::ta::TimedAutomaton<std::set<search::CanonicalABWord<LocationT, ActionT>>,
                              ActionT>
 create_controller(const search::SearchTreeNode<LocationT, ActionT> *const root,
-                  search::RegionIndex                                     K)
+                  search::RegionIndex                                     K,
+                  bool                                                    multi_threaded = true)
 {
 	using namespace details;
-	using search::NodeLabel;
 	using Location =
 	  automata::ta::Location<std::set<search::CanonicalABWord<LocationT, ActionT>>>;
 	automata::ta::TimedAutomaton<std::set<search::CanonicalABWord<LocationT, ActionT>>,
 	                             ActionT>
 	  controller{{}, Location{root->words}, {}};
-	add_node_to_controller(root, K, &controller);
+	add_node_to_controller(
+	  root, K, &controller, [](const auto *node) { return Location{node->words}; }, multi_threaded);
+	return controller;
+}
+
+/** The location type of a compact controller. */
+using ControllerLocation = std::size_t;
+
+/** Create a controller with integer locations from a labeled search tree.
+ * This creates the same controller as create_controller, but each distinct set of canonical words
+ * is replaced by an integer ID. The IDs are assigned in the order in which the locations are
+ * discovered, starting with 0 for the root.
+ * @param root The root of the labeled search tree
+ * @param K The value of the maximal constant occurring anywhere in the input problem
+ * @param location_words If not null, store the set of canonical words of each controller location
+ * in this map, e.g., for debugging
+ * @param multi_threaded If true, compute the transitions of the nodes in parallel
+ * @return The controller as timed automaton
+ */
+template <typename LocationT, typename ActionT>
+automata::ta::TimedAutomaton<ControllerLocation, ActionT>
+create_compact_controller(
+  const search::SearchTreeNode<LocationT, ActionT> *const root,
+  search::RegionIndex                                     K,
+  std::map<ControllerLocation, std::set<search::CanonicalABWord<LocationT, ActionT>>>
+    * location_words = nullptr,
+  bool multi_threaded = true)
+{
+	using namespace details;
+	using Location = automata::ta::Location<ControllerLocation>;
+	using WordSet  = std::set<search::CanonicalABWord<LocationT, ActionT>>;
+	// Identify locations by the word set of the node to obtain the same structure as
+	// create_controller. The word sets are owned by the search tree, so we do not need to copy them.
+	std::map<const WordSet *, ControllerLocation, WordSetPointerLess> ids;
+	const auto get_location = [&ids, location_words](const auto *node) {
+		const auto [it, inserted] = ids.insert({&node->words, ids.size()});
+		if (inserted && location_words != nullptr) {
+			location_words->emplace(it->second, node->words);
+		}
+		return Location{it->second};
+	};
+	automata::ta::TimedAutomaton<ControllerLocation, ActionT> controller{{},
+	                                                                     get_location(root),
+	                                                                     {}};
+	add_node_to_controller(root, K, &controller, get_location, multi_threaded);
 	return controller;
 }
 
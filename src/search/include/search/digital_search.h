@@ -0,0 +1,228 @@
+/***************************************************************************
+ *  digital_search.h - Search the configuration tree with integer clock values
+ *
+ *  Created:   Sun 18 Oct 21:51:36 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "automata/ata.h"
+#include "automata/ta.h"
+#include "canonical_word.h"
+#include "mtl/MTLFormula.h"
+#include "search.h"
+#include "synchronous_product.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace search {
+
+/** Check whether integer clock values are sufficient to solve the synthesis problem.
+ * Following the digitization result by Henzinger, Manna, and Pnueli, a timed system whose clock
+ * constraints are all closed, i.e., that only uses the comparisons <=, =, and >=, has a violating
+ * run iff it has a violating run in which all actions occur at integer time points. This is the
+ * case if every guard of the plant and every time interval of the specification is closed or
+ * unbounded.
+ * @param plant The plant
+ * @param spec The specification of undesired behaviors
+ * @return true if the digital clock search is sound for the plant and the specification
+ */
+template <typename LocationT, typename ActionT>
+bool
+digital_clocks_are_sound(const automata::ta::TimedAutomaton<LocationT, ActionT> &plant,
+                         const logic::MTLFormula<ActionT> &                      spec)
+{
+	using utilities::arithmetic::BoundType;
+	for (const auto &[source, transition] : plant.get_transitions()) {
+		for (const auto &[clock, constraint] : transition.get_guards()) {
+			if (std::holds_alternative<automata::AtomicClockConstraintT<std::less<automata::Time>>>(
+			      constraint)
+			    || std::holds_alternative<
+			      automata::AtomicClockConstraintT<std::greater<automata::Time>>>(constraint)) {
+				return false;
+			}
+		}
+	}
+	for (const auto op : {logic::LOP::LUNTIL, logic::LOP::LDUNTIL}) {
+		for (const auto &formula : spec.get_subformulas_of_type(op)) {
+			const auto interval = formula.get_interval();
+			if (interval.lowerBoundType() == BoundType::STRICT
+			    || interval.upperBoundType() == BoundType::STRICT) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+namespace details {
+
+/** Bring a word with integer clock values into a unique form.
+ * All symbols with an even region index, i.e., an integer clock value, are in the first
+ * partition. All saturated symbols, which exceed their maximal constant, are in the second
+ * partition, as their fractional part does not matter.
+ * @param word A word with integer or saturated clock values
+ * @param K The maximal constant occurring in a clock constraint
+ * @return The normalized word
+ */
+template <typename Location, typename ActionType>
+CanonicalABWord<Location, ActionType>
+get_digital_word(const CanonicalABWord<Location, ActionType> &word, RegionIndex K)
+{
+	std::set<ABRegionSymbol<Location, ActionType>> integral;
+	std::set<ABRegionSymbol<Location, ActionType>> saturated;
+	for (const auto &partition : word) {
+		for (auto symbol : partition) {
+			const auto max_region_index = get_maximal_region_index(symbol, K);
+			if (get_region_index(symbol) % 2 == 0 && get_region_index(symbol) < max_region_index) {
+				integral.insert(std::move(symbol));
+			} else {
+				std::visit([max_region_index](auto &state) { state.region_index = max_region_index; },
+				           symbol);
+				saturated.insert(std::move(symbol));
+			}
+		}
+	}
+	CanonicalABWord<Location, ActionType> res;
+	if (!integral.empty()) {
+		res.push_back(std::move(integral));
+	}
+	if (!saturated.empty()) {
+		res.push_back(std::move(saturated));
+	}
+	return res;
+}
+
+/** Compute all time successors of a word with integer clock values.
+ * Each time successor lets one time unit pass, which increments each region index by two until
+ * the clock saturates. To keep the region increments comparable with the region search, the n-th
+ * time successor is reported with the region increment 2n, which is the increment of the region
+ * search from an integer time point to the n-th next integer time point.
+ * @param word A word in the form of get_digital_word
+ * @param K The maximal constant occurring in a clock constraint
+ * @return All time successors of the word along with their region increments
+ */
+template <typename Location, typename ActionType>
+std::vector<std::pair<RegionIndex, CanonicalABWord<Location, ActionType>>>
+get_digital_time_successors(const CanonicalABWord<Location, ActionType> &word, RegionIndex K)
+{
+	std::vector<std::pair<RegionIndex, CanonicalABWord<Location, ActionType>>> res;
+	res.emplace_back(0, get_digital_word(word, K));
+	while (true) {
+		CanonicalABWord<Location, ActionType> successor;
+		for (const auto &partition : res.back().second) {
+			std::set<ABRegionSymbol<Location, ActionType>> incremented;
+			for (auto symbol : partition) {
+				const auto max_region_index = get_maximal_region_index(symbol, K);
+				std::visit(
+				  [max_region_index](auto &state) {
+					  state.region_index = std::min(state.region_index + 2, max_region_index);
+				  },
+				  symbol);
+				incremented.insert(std::move(symbol));
+			}
+			successor.push_back(std::move(incremented));
+		}
+		successor = get_digital_word(successor, K);
+		if (successor == res.back().second) {
+			return res;
+		}
+		res.emplace_back(res.back().first + 2, std::move(successor));
+	}
+}
+
+} // namespace details
+
+/** Search the configuration tree with digital clocks.
+ * Instead of regions with orderings of the fractional parts, each canonical word only contains
+ * integer clock values, where each clock saturates at its maximal region index. Time only passes
+ * in steps of one time unit, so a node has at most one time successor per time unit and no
+ * successors in between integer time points. This is only sound if digital_clocks_are_sound holds
+ * for the plant and the specification. Apart from the time successors, the search is the same as
+ * the TreeSearch, including labeling and scheduling, so the resulting tree can be used in the same
+ * way. As the controller only acts at integer time points, all guards of a controller created from
+ * the tree only allow integer clock values.
+ */
+template <typename Location, typename ActionType>
+class DigitalTreeSearch : public TreeSearch<Location, ActionType>
+{
+public:
+	/** The type of the specification. */
+	using ATA = automata::ata::AlternatingTimedAutomaton<logic::MTLFormula<ActionType>,
+	                                                     logic::AtomicProposition<ActionType>>;
+
+	/** Initialize the search.
+	 * @param ta The plant to be controlled
+	 * @param ata The specification of undesired behaviors
+	 * @param controller_actions The actions that the controller may decide to take
+	 * @param environment_actions The actions controlled by the environment
+	 * @param K The maximal constant occurring in a clock constraint
+	 * @param incremental_labeling True, if incremental labeling should be used (default=false)
+	 * @param terminate_early If true, cancel the children of a node that has already been labeled
+	 * @param heuristic The heuristic to use during tree expansion
+	 */
+	DigitalTreeSearch(const automata::ta::TimedAutomaton<Location, ActionType> *ta,
+	                  ATA *                                                     ata,
+	                  std::set<ActionType>                                      controller_actions,
+	                  std::set<ActionType>                                      environment_actions,
+	                  RegionIndex                                               K,
+	                  bool incremental_labeling = false,
+	                  bool terminate_early      = false,
+	                  std::unique_ptr<Heuristic<long, Location, ActionType>> heuristic =
+	                    std::make_unique<BfsHeuristic<long, Location, ActionType>>())
+	: TreeSearch<Location, ActionType>(ta,
+	                                   ata,
+	                                   controller_actions,
+	                                   environment_actions,
+	                                   K,
+	                                   incremental_labeling,
+	                                   terminate_early,
+	                                   std::move(heuristic)),
+	  ta_(ta),
+	  ata_(ata),
+	  K_(K)
+	{
+	}
+
+protected:
+	std::map<CanonicalABWord<Location, ActionType>, SuccessorClass<Location, ActionType>>
+	compute_successor_classes(
+	  const std::set<CanonicalABWord<Location, ActionType>> &words) const override
+	{
+		const auto K = K_;
+		return get_successor_classes(
+		  *ta_,
+		  *ata_,
+		  words,
+		  K,
+		  [K](const auto &word) { return details::get_digital_time_successors(word, K); },
+		  [K](const auto &word) { return details::get_digital_word(word, K); });
+	}
+
+private:
+	const automata::ta::TimedAutomaton<Location, ActionType> *const ta_;
+	const ATA *const                                                ata_;
+	const RegionIndex                                               K_;
+};
+
+} // namespace search
@@ -0,0 +1,442 @@
+/***************************************************************************
+ *  graph_search.h - Solve the game on the explicit graph of word sets
+ *
+ *  Created:   Sun 18 Oct 19:02:33 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "automata/ata.h"
+#include "automata/ta.h"
+#include "canonical_word.h"
+#include "create_controller.h"
+#include "search.h"
+#include "search_tree.h"
+#include "utilities/priority_thread_pool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace search {
+
+/** A node of the explicit game graph.
+ * In contrast to a SearchTreeNode, each set of canonical words occurs at most once in the graph, a
+ * node may have multiple predecessors, and the graph may contain cycles.
+ */
+template <typename Location, typename ActionType>
+struct GraphNode
+{
+	/** The canonical words of the node. */
+	std::set<CanonicalABWord<Location, ActionType>> words;
+	/** The state of the node, UNKNOWN if the node has successors that determine its label. */
+	NodeState state{NodeState::UNKNOWN};
+	/** TOP if the node is in the controller's winning region, BOTTOM otherwise. */
+	NodeLabel label{NodeLabel::UNLABELED};
+	/** The successors of the node together with the increments and actions leading to them. */
+	std::vector<std::pair<std::size_t, std::set<std::pair<RegionIndex, ActionType>>>> successors;
+	/** The IDs of all nodes that have this node as successor. */
+	std::vector<std::size_t> predecessors;
+};
+
+namespace details {
+
+/** @brief Distribute loops over indexes on a thread pool.
+ * The pool is started once and reused for every loop, so a search that processes many small layers
+ * does not start new threads for each layer.
+ */
+class IndexPool
+{
+public:
+	/** Create the pool.
+	 * @param multi_threaded If false, all loops are run sequentially without starting any threads
+	 */
+	explicit IndexPool(bool multi_threaded)
+	: num_threads_(multi_threaded ? std::max(1u, std::thread::hardware_concurrency()) : 1)
+	{
+		if (num_threads_ > 1) {
+			pool_.emplace(utilities::ThreadPool<long>::StartOnInit::YES, num_threads_);
+		}
+	}
+
+	/** Call a function for each index in [0, count) and wait until all calls are done.
+	 * The function must be safe to call concurrently for different indexes.
+	 * @param count The number of indexes
+	 * @param function The function to call with each index
+	 */
+	template <typename Function>
+	void
+	for_each_index(std::size_t count, Function &&function)
+	{
+		if (!pool_ || count < 2) {
+			for (std::size_t i = 0; i < count; ++i) {
+				function(i);
+			}
+			return;
+		}
+		// Split the indexes into contiguous chunks so that each job does a reasonable amount of work.
+		const std::size_t chunk_size = std::max<std::size_t>(1, count / (4 * num_threads_));
+		std::unique_lock  lock{mutex_};
+		remaining_jobs_ = (count + chunk_size - 1) / chunk_size;
+		for (std::size_t first = 0; first < count; first += chunk_size) {
+			const std::size_t last = std::min(first + chunk_size, count);
+			pool_->add_job([this, &function, first, last] {
+				for (std::size_t i = first; i < last; ++i) {
+					function(i);
+				}
+				std::lock_guard guard{mutex_};
+				if (--remaining_jobs_ == 0) {
+					done_.notify_all();
+				}
+			});
+		}
+		done_.wait(lock, [this] { return remaining_jobs_ == 0; });
+	}
+
+private:
+	const std::size_t                          num_threads_;
+	std::optional<utilities::ThreadPool<long>> pool_;
+	std::mutex                                 mutex_;
+	std::condition_variable                    done_;
+	std::size_t                                remaining_jobs_{0};
+};
+
+} // namespace details
+
+/** @brief Solve the synthesis problem on the explicit graph of canonical word sets.
+ * The TreeSearch explores each configuration separately for every path that reaches it and relies
+ * on monotonic domination to terminate. Instead, this search merges all nodes with the same set of
+ * canonical words, which results in a finite graph that may contain cycles. On this graph, the
+ * environment's attractor of the bad nodes is computed as least fixpoint, using the same condition
+ * as TreeSearch::label: a node is losing if the environment can reach a losing node before the
+ * controller can reach a non-losing node. All nodes outside of the attractor are in the
+ * controller's winning region, as the controller can avoid the bad nodes forever.
+ *
+ * Both the graph construction and the fixpoint computation process one layer at a time and
+ * distribute the nodes of each layer on a thread pool.
+ */
+template <typename Location, typename ActionType>
+class GraphSearch
+{
+public:
+	/** The node type of the game graph. */
+	using Node = GraphNode<Location, ActionType>;
+	/** The set of canonical words of a node. */
+	using WordSet = std::set<CanonicalABWord<Location, ActionType>>;
+
+	/** Initialize the search.
+	 * @param ta The plant to be controlled
+	 * @param ata The specification of undesired behaviors
+	 * @param controller_actions The actions that the controller may decide to take
+	 * @param environment_actions The actions controlled by the environment
+	 * @param K The maximal constant occurring in a clock constraint
+	 */
+	GraphSearch(const automata::ta::TimedAutomaton<Location, ActionType> *ta,
+	            const automata::ata::AlternatingTimedAutomaton<logic::MTLFormula<ActionType>,
+	                                                           logic::AtomicProposition<ActionType>>
+	              *                  ata,
+	            std::set<ActionType> controller_actions,
+	            std::set<ActionType> environment_actions,
+	            RegionIndex          K)
+	: ta_(ta),
+	  ata_(ata),
+	  controller_actions_(std::move(controller_actions)),
+	  environment_actions_(std::move(environment_actions)),
+	  K_(K)
+	{
+		Node root;
+		root.words = {
+		  get_canonical_word(ta->get_initial_configuration(), ata->get_initial_configuration(), K)};
+		ids_.emplace(root.words, 0);
+		nodes_.push_back(std::move(root));
+	}
+
+	/** Build the graph of all reachable word sets.
+	 * @param multi_threaded If true, compute the successors of each layer in parallel
+	 */
+	void
+	build_graph(bool multi_threaded = true)
+	{
+		details::IndexPool       pool{multi_threaded};
+		std::vector<std::size_t> layer{0};
+		while (!layer.empty()) {
+			std::vector<std::map<CanonicalABWord<Location, ActionType>,
+			                     SuccessorClass<Location, ActionType>>>
+			                       successors(layer.size());
+			std::vector<NodeState> states(layer.size(), NodeState::UNKNOWN);
+			pool.for_each_index(layer.size(), [&](std::size_t i) {
+				const auto &words = nodes_[layer[i]].words;
+				if (is_bad(words)) {
+					states[i] = NodeState::BAD;
+				} else if (!has_satisfiable_ata_configuration(words)) {
+					states[i] = NodeState::GOOD;
+				} else {
+					successors[i] = get_successor_classes(*ta_, *ata_, words, K_);
+					if (successors[i].empty()) {
+						states[i] = NodeState::DEAD;
+					}
+				}
+			});
+			// Merge the successors sequentially so the node IDs do not depend on the scheduling.
+			std::vector<std::size_t> next_layer;
+			for (std::size_t i = 0; i < layer.size(); ++i) {
+				const auto id    = layer[i];
+				nodes_[id].state = states[i];
+				for (auto &[word_reg, successor_class] : successors[i]) {
+					const auto [it, is_new] = ids_.emplace(successor_class.words, nodes_.size());
+					if (is_new) {
+						Node successor;
+						successor.words = std::move(successor_class.words);
+						nodes_.push_back(std::move(successor));
+						next_layer.push_back(it->second);
+					}
+					nodes_[id].successors.emplace_back(it->second,
+					                                   std::move(successor_class.incoming_actions));
+					nodes_[it->second].predecessors.push_back(id);
+				}
+			}
+			layer = std::move(next_layer);
+		}
+	}
+
+	/** Compute the winning region by labeling all nodes.
+	 * The graph must have been built with build_graph before.
+	 * @param multi_threaded If true, check the candidates of each iteration in parallel
+	 */
+	void
+	label(bool multi_threaded = true)
+	{
+		std::vector<bool>        losing(nodes_.size(), false);
+		std::vector<bool>        is_candidate(nodes_.size(), false);
+		std::vector<std::size_t> candidates;
+		const auto               add_predecessors = [&](std::size_t id) {
+			for (const auto predecessor : nodes_[id].predecessors) {
+				if (!losing[predecessor] && !is_candidate[predecessor]
+				    && nodes_[predecessor].state == NodeState::UNKNOWN) {
+					is_candidate[predecessor] = true;
+					candidates.push_back(predecessor);
+				}
+			}
+		};
+		for (std::size_t id = 0; id < nodes_.size(); ++id) {
+			if (nodes_[id].state == NodeState::BAD) {
+				losing[id] = true;
+			}
+		}
+		for (std::size_t id = 0; id < nodes_.size(); ++id) {
+			if (losing[id]) {
+				add_predecessors(id);
+			}
+		}
+		// As the condition is monotone in the set of losing nodes, all candidates of one iteration can
+		// be checked against the same set and the iteration converges to the least fixpoint.
+		details::IndexPool pool{multi_threaded};
+		while (!candidates.empty()) {
+			std::vector<std::size_t> current;
+			current.swap(candidates);
+			std::vector<char> is_losing(current.size(), false);
+			pool.for_each_index(current.size(), [&](std::size_t i) {
+				is_losing[i] = environment_wins_first(nodes_[current[i]], losing);
+			});
+			for (const auto id : current) {
+				is_candidate[id] = false;
+			}
+			for (std::size_t i = 0; i < current.size(); ++i) {
+				if (is_losing[i]) {
+					losing[current[i]] = true;
+				}
+			}
+			for (std::size_t i = 0; i < current.size(); ++i) {
+				if (is_losing[i]) {
+					add_predecessors(current[i]);
+				}
+			}
+		}
+		for (std::size_t id = 0; id < nodes_.size(); ++id) {
+			nodes_[id].label = losing[id] ? NodeLabel::BOTTOM : NodeLabel::TOP;
+		}
+	}
+
+	/** Get the root of the graph.
+	 * @return The node of the initial configuration
+	 */
+	const Node &
+	get_root() const
+	{
+		return nodes_.front();
+	}
+
+	/** Get all nodes of the graph, indexed by their ID.
+	 * @return The nodes, the root has the ID 0
+	 */
+	const std::vector<Node> &
+	get_nodes() const
+	{
+		return nodes_;
+	}
+
+	/** Get the number of nodes of the graph.
+	 * @return The number of distinct word sets reachable from the initial configuration
+	 */
+	std::size_t
+	get_size() const
+	{
+		return nodes_.size();
+	}
+
+	/** Get the maximal constant of the search.
+	 * @return The maximal constant occurring in a clock constraint
+	 */
+	RegionIndex
+	get_K() const
+	{
+		return K_;
+	}
+
+private:
+	bool
+	is_bad(const WordSet &words) const
+	{
+		return std::any_of(words.begin(), words.end(), [this](const auto &word) {
+			const auto candidate = get_candidate(word);
+			return ta_->is_accepting_configuration(candidate.first)
+			       && ata_->is_accepting_configuration(candidate.second);
+		});
+	}
+
+	/** Check whether the environment can reach a losing node before the controller can reach a
+	 * non-losing node. */
+	bool
+	environment_wins_first(const Node &node, const std::vector<bool> &losing) const
+	{
+		bool        found_bad = false;
+		RegionIndex first_good_controller_step{std::numeric_limits<RegionIndex>::max()};
+		RegionIndex first_bad_environment_step{std::numeric_limits<RegionIndex>::max()};
+		for (const auto &[successor, incoming_actions] : node.successors) {
+			for (const auto &[step, action] : incoming_actions) {
+				if (!losing[successor]
+				    && controller_actions_.find(action) != std::end(controller_actions_)) {
+					first_good_controller_step = std::min(first_good_controller_step, step);
+				} else if (losing[successor]
+				           && environment_actions_.find(action) != std::end(environment_actions_)) {
+					found_bad                  = true;
+					first_bad_environment_step = std::min(first_bad_environment_step, step);
+				}
+			}
+		}
+		return found_bad && first_good_controller_step >= first_bad_environment_step;
+	}
+
+	const automata::ta::TimedAutomaton<Location, ActionType> *const                             ta_;
+	const automata::ata::AlternatingTimedAutomaton<logic::MTLFormula<ActionType>,
+	                                               logic::AtomicProposition<ActionType>> *const ata_;
+
+	const std::set<ActionType>     controller_actions_;
+	const std::set<ActionType>     environment_actions_;
+	const RegionIndex              K_;
+	std::vector<Node>              nodes_;
+	std::map<WordSet, std::size_t> ids_;
+};
+
+} // namespace search
+
+namespace controller_synthesis {
+
+/** @brief Create a controller from the winning region of a solved game graph.
+ * The controller contains one location for each winning node that is reachable from the root via
+ * winning nodes. As the graph may contain cycles, the controller may contain cycles as well, and
+ * unlike the controllers created from a search tree, it does not have any locations without
+ * outgoing transitions that stand for a repetition of an earlier node.
+ * @param search The search, which must have been built and labeled
+ * @param multi_threaded If true, compute the transitions of the locations in parallel
+ * @return The controller, where the root has the location 0
+ */
+template <typename LocationT, typename ActionT>
+automata::ta::TimedAutomaton<ControllerLocation, ActionT>
+create_compact_controller(const search::GraphSearch<LocationT, ActionT> &search,
+                          bool                                           multi_threaded = true)
+{
+	using Location   = automata::ta::Location<ControllerLocation>;
+	using Transition = automata::ta::Transition<ControllerLocation, ActionT>;
+	const auto &nodes = search.get_nodes();
+	if (search.get_root().label != search::NodeLabel::TOP) {
+		throw std::invalid_argument(
+		  "Cannot create a controller for a node that is not labeled with TOP");
+	}
+	// Number the controller nodes in the order of a breadth-first traversal.
+	std::vector<std::size_t>                  controller_nodes{0};
+	std::map<std::size_t, ControllerLocation> locations{{0, 0}};
+	for (std::size_t i = 0; i < controller_nodes.size(); ++i) {
+		for (const auto &[successor, _actions] : nodes[controller_nodes[i]].successors) {
+			if (nodes[successor].label == search::NodeLabel::TOP
+			    && locations.emplace(successor, locations.size()).second) {
+				controller_nodes.push_back(successor);
+			}
+		}
+	}
+	std::vector<std::vector<
+	  std::pair<std::size_t,
+	            std::multimap<ActionT, std::multimap<std::string, automata::ClockConstraint>>>>>
+	  fragments(controller_nodes.size());
+	search::details::IndexPool pool{multi_threaded};
+	pool.for_each_index(controller_nodes.size(), [&](std::size_t i) {
+		const auto &node = nodes[controller_nodes[i]];
+		if (node.state != search::NodeState::UNKNOWN) {
+			return;
+		}
+		assert(reg_a(*std::begin(node.words)) == reg_a(*std::rbegin(node.words)));
+		const auto time_successors =
+		  search::get_time_successors(reg_a(*std::begin(node.words)), search.get_K());
+		for (const auto &[successor, actions] : node.successors) {
+			if (nodes[successor].label == search::NodeLabel::TOP) {
+				fragments[i].emplace_back(
+				  successor,
+				  details::get_constraints_from_time_successors(time_successors, actions, search.get_K()));
+			}
+		}
+	});
+	automata::ta::TimedAutomaton<ControllerLocation, ActionT> controller({},
+	                                                                     Location{0},
+	                                                                     {Location{0}});
+	for (std::size_t i = 0; i < controller_nodes.size(); ++i) {
+		const Location source{locations.at(controller_nodes[i])};
+		controller.add_location(source);
+		controller.add_final_location(source);
+		for (const auto &[successor, successor_constraints] : fragments[i]) {
+			const Location target{locations.at(successor)};
+			controller.add_location(target);
+			controller.add_final_location(target);
+			for (const auto &[action, constraints] : successor_constraints) {
+				for (const auto &[clock, _constraint] : constraints) {
+					controller.add_clock(clock);
+				}
+				controller.add_action(action);
+				controller.add_transition(Transition{source, action, target, constraints, {}});
+			}
+		}
+	}
+	return controller;
+}
+
+} // namespace controller_synthesis
@@ -0,0 +1,139 @@
+/***************************************************************************
+ *  monitor_search.h - Search with a deterministic specification monitor
+ *
+ *  Created:   Sun 18 Oct 10:48:02 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "automata/ata.h"
+#include "automata/ata_formula.h"
+#include "automata/ta.h"
+#include "automata/ta_product.h"
+#include "mtl/MTLFormula.h"
+#include "search.h"
+
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace search {
+
+namespace details {
+
+/** Create an ATA that accepts every word with at least one symbol.
+ * The ATA never has any state after the first symbol and thus does not contribute to the canonical
+ * words.
+ */
+template <typename ActionType>
+automata::ata::AlternatingTimedAutomaton<logic::MTLFormula<ActionType>,
+                                         logic::AtomicProposition<ActionType>>
+create_trivial_ata(const std::set<ActionType> &actions)
+{
+	using Location = logic::MTLFormula<ActionType>;
+	using Symbol   = logic::AtomicProposition<ActionType>;
+	const Location                                          initial_location{Symbol{"l0"}};
+	std::set<Symbol>                                        alphabet;
+	std::set<automata::ata::Transition<Location, Symbol>> transitions;
+	for (const auto &action : actions) {
+		alphabet.insert(Symbol{action});
+		transitions.insert(automata::ata::Transition<Location, Symbol>(
+		  initial_location, Symbol{action}, std::make_unique<automata::ata::TrueFormula<Location>>()));
+	}
+	return automata::ata::AlternatingTimedAutomaton<Location, Symbol>(
+	  alphabet, initial_location, {}, std::move(transitions), Location{Symbol{"sink"}});
+}
+
+/** The automata that a MonitorTreeSearch operates on.
+ * This is a separate base class of the MonitorTreeSearch so that the automata are constructed
+ * before the TreeSearch base class, which keeps pointers to them.
+ */
+template <typename LocationT, typename ActionType>
+struct MonitoredPlant
+{
+	/** Compose the plant with the monitor. */
+	MonitoredPlant(const automata::ta::TimedAutomaton<std::vector<LocationT>, ActionType> &plant,
+	               const automata::ta::TimedAutomaton<LocationT, ActionType> &             monitor)
+	: monitored_plant(automata::ta::add_observer(plant, monitor)),
+	  trivial_ata(create_trivial_ata(monitored_plant.get_alphabet()))
+	{
+	}
+	/** The plant extended by the monitor. */
+	automata::ta::TimedAutomaton<std::vector<LocationT>, ActionType> monitored_plant;
+	/** An ATA that accepts every non-empty word. */
+	automata::ata::AlternatingTimedAutomaton<logic::MTLFormula<ActionType>,
+	                                         logic::AtomicProposition<ActionType>>
+	  trivial_ata;
+};
+
+} // namespace details
+
+/** Search the configuration tree with a deterministic monitor instead of an ATA.
+ * If the specification of undesired behaviors can be compiled into a deterministic timed automaton
+ * (see mtl_ata_translation::translate_to_monitor), the monitor is composed with the plant and the
+ * search runs on the monitored plant with a trivial ATA. As the monitor is deterministic, each
+ * canonical word only contains the plant and monitor clocks, which avoids the blowup caused by sets
+ * of ATA states. A node is bad iff the plant is in a final location and the monitor has detected a
+ * violation.
+ */
+template <typename LocationT, typename ActionType>
+class MonitorTreeSearch : private details::MonitoredPlant<LocationT, ActionType>,
+                          public TreeSearch<std::vector<LocationT>, ActionType>
+{
+public:
+	/** Initialize the search.
+	 * @param plant The plant to be controlled
+	 * @param monitor A deterministic and complete monitor of the undesired behaviors
+	 * @param controller_actions The actions that the controller may decide to take
+	 * @param environment_actions The actions controlled by the environment
+	 * @param K The maximal constant occurring in a clock constraint of the plant or the monitor
+	 * @param incremental_labeling True, if incremental labeling should be used (default=false)
+	 * @param terminate_early If true, cancel the children of a node that has already been labeled
+	 * @param heuristic The heuristic to use during tree expansion
+	 */
+	MonitorTreeSearch(
+	  const automata::ta::TimedAutomaton<std::vector<LocationT>, ActionType> &plant,
+	  const automata::ta::TimedAutomaton<LocationT, ActionType> &             monitor,
+	  std::set<ActionType>                                                    controller_actions,
+	  std::set<ActionType>                                                    environment_actions,
+	  RegionIndex                                                             K,
+	  bool incremental_labeling = false,
+	  bool terminate_early      = false,
+	  std::unique_ptr<Heuristic<long, std::vector<LocationT>, ActionType>> heuristic =
+	    std::make_unique<BfsHeuristic<long, std::vector<LocationT>, ActionType>>())
+	: details::MonitoredPlant<LocationT, ActionType>(plant, monitor),
+	  TreeSearch<std::vector<LocationT>, ActionType>(&this->monitored_plant,
+	                                                 &this->trivial_ata,
+	                                                 controller_actions,
+	                                                 environment_actions,
+	                                                 K,
+	                                                 incremental_labeling,
+	                                                 terminate_early,
+	                                                 std::move(heuristic))
+	{
+	}
+
+	/** Get the plant composed with the monitor.
+	 * @return The monitored plant that the search operates on
+	 */
+	const automata::ta::TimedAutomaton<std::vector<LocationT>, ActionType> &
+	get_monitored_plant() const
+	{
+		return this->monitored_plant;
+	}
+};
+
+} // namespace search
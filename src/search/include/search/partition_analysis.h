@@ -0,0 +1,176 @@
+/***************************************************************************
+ *  partition_analysis.h - Label one search tree for many controller action sets
+ *
+ *  Created:   Mon 19 Oct 00:52:18 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "search_tree.h"
+#include "utilities/priority_thread_pool.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace search {
+
+/** Compute the label of a node for the given partition of the actions without modifying the tree.
+ * This computes the same label as TreeSearch::label, but it does not store the labels in the
+ * nodes. Thus, the same tree can be labeled for multiple partitions concurrently. The tree must
+ * have been built without incremental labeling, as the expansion would otherwise depend on the
+ * partition that was used during the search.
+ * @param node The node to label
+ * @param controller_actions The actions that the controller may decide to take
+ * @param environment_actions The actions controlled by the environment
+ * @return TOP if the controller wins from the node, BOTTOM otherwise
+ */
+template <typename Location, typename ActionType>
+NodeLabel
+compute_label(const SearchTreeNode<Location, ActionType> &node,
+              const std::set<ActionType> &                controller_actions,
+              const std::set<ActionType> &                environment_actions)
+{
+	if (node.state == NodeState::GOOD || node.state == NodeState::DEAD) {
+		return NodeLabel::TOP;
+	}
+	if (node.state == NodeState::BAD) {
+		return NodeLabel::BOTTOM;
+	}
+	bool        found_bad = false;
+	RegionIndex first_good_controller_step{std::numeric_limits<RegionIndex>::max()};
+	RegionIndex first_bad_environment_step{std::numeric_limits<RegionIndex>::max()};
+	for (const auto &child : node.children) {
+		const auto child_label = compute_label(*child, controller_actions, environment_actions);
+		for (const auto &[step, action] : child->incoming_actions) {
+			if (child_label == NodeLabel::TOP
+			    && controller_actions.find(action) != std::end(controller_actions)) {
+				first_good_controller_step = std::min(first_good_controller_step, step);
+			} else if (child_label == NodeLabel::BOTTOM
+			           && environment_actions.find(action) != std::end(environment_actions)) {
+				found_bad                  = true;
+				first_bad_environment_step = std::min(first_bad_environment_step, step);
+			}
+		}
+	}
+	if (!found_bad || first_good_controller_step < first_bad_environment_step) {
+		return NodeLabel::TOP;
+	}
+	return NodeLabel::BOTTOM;
+}
+
+/** Check whether the controller wins if it controls the given actions.
+ * @param root The root of a search tree built without incremental labeling
+ * @param actions All actions of the plant
+ * @param controller_actions The actions that the controller may decide to take, all other actions
+ * are controlled by the environment
+ * @return true if the root is labeled with TOP for the partition
+ */
+template <typename Location, typename ActionType>
+bool
+is_controllable(const SearchTreeNode<Location, ActionType> &root,
+                const std::set<ActionType> &                actions,
+                const std::set<ActionType> &                controller_actions)
+{
+	std::set<ActionType> environment_actions;
+	std::set_difference(std::begin(actions),
+	                    std::end(actions),
+	                    std::begin(controller_actions),
+	                    std::end(controller_actions),
+	                    std::inserter(environment_actions, std::end(environment_actions)));
+	return compute_label(root, controller_actions, environment_actions) == NodeLabel::TOP;
+}
+
+/** Check for each of the given controller action sets whether the controller wins.
+ * As the labels are not stored in the tree, the partitions are checked concurrently on the same
+ * tree.
+ * @param root The root of a search tree built without incremental labeling
+ * @param actions All actions of the plant
+ * @param controller_action_sets The controller actions of each partition
+ * @param multi_threaded If true, check the partitions with a thread pool
+ * @return For each partition, whether the controller wins
+ */
+template <typename Location, typename ActionType>
+std::vector<bool>
+get_controllable_partitions(const SearchTreeNode<Location, ActionType> &    root,
+                            const std::set<ActionType> &                    actions,
+                            const std::vector<std::set<ActionType>> &controller_action_sets,
+                            bool                                            multi_threaded = true)
+{
+	// Use chars rather than bools so the jobs write to distinct memory locations.
+	std::vector<char> controllable(controller_action_sets.size(), false);
+	const std::size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+	if (multi_threaded && num_threads > 1 && controller_action_sets.size() > 1) {
+		utilities::ThreadPool<long> pool{utilities::ThreadPool<long>::StartOnInit::NO, num_threads};
+		for (std::size_t i = 0; i < controller_action_sets.size(); ++i) {
+			pool.add_job([&root, &actions, &controller_action_sets, &controllable, i] {
+				controllable[i] = is_controllable(root, actions, controller_action_sets[i]);
+			});
+		}
+		pool.start();
+		pool.finish();
+	} else {
+		for (std::size_t i = 0; i < controller_action_sets.size(); ++i) {
+			controllable[i] = is_controllable(root, actions, controller_action_sets[i]);
+		}
+	}
+	return std::vector<bool>(std::begin(controllable), std::end(controllable));
+}
+
+/** Find a minimal set of controller actions such that the controller wins.
+ * Giving an action to the controller never helps the environment, so if the controller wins with
+ * some actions, it also wins with any superset of them. Starting with all actions, each action is
+ * given to the environment if the controller still wins without it. The resulting set is minimal
+ * w.r.t. set inclusion, but not necessarily of minimal size.
+ * @param root The root of a search tree built without incremental labeling
+ * @param actions All actions of the plant
+ * @param required_actions Actions that the controller always controls
+ * @return A minimal set of controller actions, or nothing if the controller cannot win at all
+ */
+template <typename Location, typename ActionType>
+std::optional<std::set<ActionType>>
+find_minimal_controller_actions(const SearchTreeNode<Location, ActionType> &root,
+                                const std::set<ActionType> &                actions,
+                                const std::set<ActionType> &                required_actions = {})
+{
+	if (!std::includes(std::begin(actions),
+	                   std::end(actions),
+	                   std::begin(required_actions),
+	                   std::end(required_actions))) {
+		throw std::invalid_argument("The required controller actions must be actions of the plant");
+	}
+	std::set<ActionType> controller_actions = actions;
+	if (!is_controllable(root, actions, controller_actions)) {
+		return std::nullopt;
+	}
+	for (const auto &action : actions) {
+		if (required_actions.count(action) > 0) {
+			continue;
+		}
+		controller_actions.erase(action);
+		if (!is_controllable(root, actions, controller_actions)) {
+			controller_actions.insert(action);
+		}
+	}
+	return controller_actions;
+}
+
+} // namespace search
@@ -21,6 +21,8 @@
 
 #include "automata/ata.h"
 #include "automata/ta.h"
+#include "automata/ta_reachability.h"
+#include "ata_analysis.h"
 #include "canonical_word.h"
 #include "heuristics.h"
 #include "mtl/MTLFormula.h"
@@ -33,10 +35,14 @@
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <chrono>
+#include <functional>
 #include <iterator>
 #include <limits>
+#include <map>
 #include <memory>
 #include <queue>
+#include <set>
 #include <variant>
 
 namespace search {
@@ -48,9 +54,9 @@ namespace search {
  */
 template <typename Location, typename ActionType>
 bool
-has_satisfiable_ata_configuration(const SearchTreeNode<Location, ActionType> &node)
+has_satisfiable_ata_configuration(const std::set<CanonicalABWord<Location, ActionType>> &words)
 {
-	return !std::all_of(std::begin(node.words), std::end(node.words), [](const auto &word) {
+	return !std::all_of(std::begin(words), std::end(words), [](const auto &word) {
 		return std::any_of(std::begin(word), std::end(word), [](const auto &component) {
 			return std::find_if(std::begin(component),
 			                    std::end(component),
@@ -65,6 +71,105 @@ has_satisfiable_ata_configuration(const SearchTreeNode<Location, ActionType> &no
 	});
 }
 
+/** @brief Check if the node has a satisfiable ATA configuration.
+ * @return false if every word in the node contains an ATA sink location
+ */
+template <typename Location, typename ActionType>
+bool
+has_satisfiable_ata_configuration(const SearchTreeNode<Location, ActionType> &node)
+{
+	return has_satisfiable_ata_configuration(node.words);
+}
+
+/** The successors of a set of canonical words that share the same reg_a. */
+template <typename Location, typename ActionType>
+struct SuccessorClass
+{
+	/** The successor words. */
+	std::set<CanonicalABWord<Location, ActionType>> words;
+	/** The region increments and actions that lead to the successor words. */
+	std::set<std::pair<RegionIndex, ActionType>> incoming_actions;
+};
+
+/** Compute the successors of a set of canonical words, partitioned by their reg_a.
+ * Each class of successors corresponds to one child of a search node.
+ * @param ta The plant
+ * @param ata The specification of undesired behaviors
+ * @param words The canonical words to compute the successors of
+ * @param K The maximal constant occurring in a clock constraint
+ * @param time_successors_of A function that computes the time successors of a word along with
+ * their region increments, e.g., get_time_successors
+ * @param normalize A function that is applied to each successor word before it is partitioned
+ * @return A map from each reg_a to the successor words with that reg_a
+ */
+template <typename Location,
+          typename ActionType,
+          typename TimeSuccessorFunction,
+          typename NormalizationFunction>
+std::map<CanonicalABWord<Location, ActionType>, SuccessorClass<Location, ActionType>>
+get_successor_classes(
+  const automata::ta::TimedAutomaton<Location, ActionType> &                            ta,
+  const automata::ata::AlternatingTimedAutomaton<logic::MTLFormula<ActionType>,
+                                                 logic::AtomicProposition<ActionType>> &ata,
+  const std::set<CanonicalABWord<Location, ActionType>> &                               words,
+  RegionIndex                                                                           K,
+  TimeSuccessorFunction time_successors_of,
+  NormalizationFunction normalize)
+{
+	std::map<CanonicalABWord<Location, ActionType>, SuccessorClass<Location, ActionType>> res;
+	// Pre-compute time successors so we avoid re-computing them for each symbol.
+	std::map<CanonicalABWord<Location, ActionType>,
+	         std::vector<std::pair<RegionIndex, CanonicalABWord<Location, ActionType>>>>
+	  time_successors;
+	for (const auto &word : words) {
+		time_successors[word] = time_successors_of(word);
+	}
+	for (const auto &symbol : ta.get_alphabet()) {
+		std::set<std::pair<RegionIndex, CanonicalABWord<Location, ActionType>>> successors;
+		for (const auto &word : words) {
+			for (const auto &[increment, time_successor] : time_successors[word]) {
+				for (const auto &successor :
+				     get_next_canonical_words(ta, ata, get_candidate(time_successor), symbol, K)) {
+					successors.emplace(increment, normalize(successor));
+				}
+			}
+		}
+		// Partition the successors by their reg_a component.
+		for (const auto &[increment, successor] : successors) {
+			auto &successor_class = res[reg_a(successor)];
+			successor_class.words.insert(successor);
+			successor_class.incoming_actions.insert(std::make_pair(increment, symbol));
+		}
+	}
+	return res;
+}
+
+/** Compute the successors of a set of canonical words, partitioned by their reg_a.
+ * Each class of successors corresponds to one child of a search node.
+ * @param ta The plant
+ * @param ata The specification of undesired behaviors
+ * @param words The canonical words to compute the successors of
+ * @param K The maximal constant occurring in a clock constraint
+ * @return A map from each reg_a to the successor words with that reg_a
+ */
+template <typename Location, typename ActionType>
+std::map<CanonicalABWord<Location, ActionType>, SuccessorClass<Location, ActionType>>
+get_successor_classes(
+  const automata::ta::TimedAutomaton<Location, ActionType> &                            ta,
+  const automata::ata::AlternatingTimedAutomaton<logic::MTLFormula<ActionType>,
+                                                 logic::AtomicProposition<ActionType>> &ata,
+  const std::set<CanonicalABWord<Location, ActionType>> &                               words,
+  RegionIndex                                                                           K)
+{
+	return get_successor_classes(
+	  ta,
+	  ata,
+	  words,
+	  K,
+	  [K](const auto &word) { return get_time_successors(word, K); },
+	  [](const auto &word) { return word; });
+}
+
 /** Search the configuration tree for a valid controller. */
 template <typename Location, typename ActionType>
 class TreeSearch
@@ -99,6 +204,8 @@ public:
 	  K_(K),
 	  incremental_labeling_(incremental_labeling),
 	  terminate_early_(terminate_early),
+	  locations_reaching_final_(
+	    automata::ta::get_coreachable_locations(*ta, ta->get_final_locations())),
 	  tree_root_(std::make_unique<Node>(std::set<CanonicalABWord<Location, ActionType>>{
 	    get_canonical_word(ta->get_initial_configuration(), ata->get_initial_configuration(), K)})),
 	  heuristic(std::move(heuristic))
@@ -115,6 +222,8 @@ public:
 		add_node_to_queue(tree_root_.get());
 	}
 
+	virtual ~TreeSearch() = default;
+
 	/** Get the root of the search tree.
 	 * @return A pointer to the root, only valid as long as the TreeSearch object has not been
 	 * destroyed
@@ -139,6 +248,41 @@ public:
 		});
 	}
 
+	/** Check if a node can never become bad because its plant location cannot reach a final location.
+	 * All words of a node have the same reg_a and thus the same plant location. As a node can only
+	 * be bad if the plant is in a final location, no descendant of such a node is bad.
+	 * @param node A pointer to the node to check
+	 * @return true if no final location of the plant is reachable from the node's location
+	 */
+	bool
+	is_safe_node(Node *node) const
+	{
+		for (const auto &partition : *std::begin(node->words)) {
+			for (const auto &symbol : partition) {
+				if (std::holds_alternative<TARegionState<Location>>(symbol)) {
+					return locations_reaching_final_.count(
+					         std::get<TARegionState<Location>>(symbol).location)
+					       == 0;
+				}
+			}
+		}
+		return false;
+	}
+
+	/** Check if a node can never become bad because none of its ATA configurations can ever become
+	 * accepting.
+	 * @param node A pointer to the node to check
+	 * @return true if every word of the node contains a hopeless ATA state
+	 * @see is_hopeless
+	 */
+	bool
+	is_hopeless_node(Node *node) const
+	{
+		return std::all_of(std::begin(node->words), std::end(node->words), [this](const auto &word) {
+			return is_hopeless(word, ata_->get_alphabet());
+		});
+	}
+
 	/** Check if there is an ancestor that monotonally dominates the given node
 	 * @param node The node to check
 	 */
@@ -161,7 +305,45 @@ public:
 	void
 	add_node_to_queue(Node *node)
 	{
-		pool_.add_job([this, node] { expand_node(node); }, -heuristic->compute_cost(node));
+		pool_.add_job(
+		  [this, node] {
+			  if (timed_expansion_callback_) {
+				  const auto start = std::chrono::steady_clock::now();
+				  expand_node(node);
+				  timed_expansion_callback_(node,
+				                            std::chrono::duration_cast<std::chrono::nanoseconds>(
+				                              std::chrono::steady_clock::now() - start));
+			  } else {
+				  expand_node(node);
+			  }
+			  if (expansion_callback_) {
+				  expansion_callback_(node);
+			  }
+		  },
+		  -heuristic->compute_cost(node));
+	}
+
+	/** Set a function that is called after each node expansion.
+	 * This can be used to process the tree while it is being built, e.g., to emit controller
+	 * transitions as soon as they are final. With a multi-threaded search, the function is called
+	 * concurrently from the worker threads. The function must be set before the search starts.
+	 * @param callback The function to call with the expanded node
+	 */
+	void
+	set_expansion_callback(std::function<void(Node *)> callback)
+	{
+		expansion_callback_ = std::move(callback);
+	}
+
+	/** Set a function that is called after each node expansion with the time spent on expanding it.
+	 * The function is called before the function set with set_expansion_callback. Otherwise, the
+	 * same restrictions apply.
+	 * @param callback The function to call with the expanded node and its expansion time
+	 */
+	void
+	set_timed_expansion_callback(std::function<void(Node *, std::chrono::nanoseconds)> callback)
+	{
+		timed_expansion_callback_ = std::move(callback);
 	}
 
 	/** Build the complete search tree by expanding nodes recursively.
@@ -213,7 +395,17 @@ public:
 			}
 			return;
 		}
-		if (!has_satisfiable_ata_configuration(*node)) {
+		if (is_safe_node(node)) {
+			node->label_reason = LabelReason::NO_REACHABLE_FINAL_LOCATION;
+			node->state        = NodeState::GOOD;
+			node->is_expanded  = true;
+			if (incremental_labeling_) {
+				node->set_label(NodeLabel::TOP, terminate_early_);
+				node->label_propagate(controller_actions_, environment_actions_, terminate_early_);
+			}
+			return;
+		}
+		if (!has_satisfiable_ata_configuration(*node) || is_hopeless_node(node)) {
 			node->label_reason = LabelReason::NO_ATA_SUCCESSOR;
 			node->state        = NodeState::GOOD;
 			node->is_expanded  = true;
@@ -234,54 +426,14 @@ public:
 			return;
 		}
 		assert(node->children.empty());
-		// Represent a set of configurations by their reg_a component so we can later partition the
-		// set
-		std::map<CanonicalABWord<Location, ActionType>, std::set<CanonicalABWord<Location, ActionType>>>
-		  child_classes;
-		// Store with which actions we reach each CanonicalABWord
-		std::map<CanonicalABWord<Location, ActionType>, std::set<std::pair<RegionIndex, ActionType>>>
-		  outgoing_actions;
-
-		// Pre-compute time successors so we avoid re-computing them for each symbol.
-		std::map<CanonicalABWord<Location, ActionType>,
-		         std::vector<std::pair<RegionIndex, CanonicalABWord<Location, ActionType>>>>
-		  time_successors;
-		for (const auto &word : node->words) {
-			time_successors[word] = get_time_successors(word, K_);
-		}
-		for (const auto &symbol : ta_->get_alphabet()) {
-			std::set<std::pair<RegionIndex, CanonicalABWord<Location, ActionType>>> successors;
-			for (const auto &word : node->words) {
-				for (const auto &[increment, time_successor] : time_successors[word]) {
-					for (const auto &successor :
-					     get_next_canonical_words(*ta_, *ata_, get_candidate(time_successor), symbol, K_)) {
-						successors.emplace(increment, successor);
-					}
-				}
-			}
-
-			// Partition the successors by their reg_a component.
-			for (const auto &[increment, successor] : successors) {
-				const auto word_reg = reg_a(successor);
-				child_classes[word_reg].insert(successor);
-				outgoing_actions[word_reg].insert(std::make_pair(increment, symbol));
-			}
-		}
-
-		assert(child_classes.size() == outgoing_actions.size());
-
 		// Create child nodes, where each child contains all successors words of
 		// the same reg_a class.
-		std::transform(std::begin(child_classes),
-		               std::end(child_classes),
-		               std::back_inserter(node->children),
-		               [node, &outgoing_actions](auto &&map_entry) {
-			               auto child =
-			                 std::make_unique<Node>(std::move(map_entry.second),
-			                                        node,
-			                                        std::move(outgoing_actions[map_entry.first]));
-			               return child;
-		               });
+		for (auto &[word_reg, successor_class] : compute_successor_classes(node->words)) {
+			remove_hopeless_words(&successor_class.words);
+			node->children.push_back(std::make_unique<Node>(std::move(successor_class.words),
+			                                                node,
+			                                                std::move(successor_class.incoming_actions)));
+		}
 		SPDLOG_TRACE("Finished processing sub tree:\n{}", node_to_string(*node, true));
 		// Check if the node has been canceled in the meantime.
 		if (node->label == NodeLabel::CANCELED) {
@@ -361,7 +513,37 @@ public:
 		return sum;
 	}
 
+protected:
+	/** Compute the successors of the words of a node, partitioned into the node's children.
+	 * @param words The words of the node to expand
+	 * @return A map from each reg_a to the successor words with that reg_a
+	 * @see get_successor_classes
+	 */
+	virtual std::map<CanonicalABWord<Location, ActionType>, SuccessorClass<Location, ActionType>>
+	compute_successor_classes(const std::set<CanonicalABWord<Location, ActionType>> &words) const
+	{
+		return get_successor_classes(*ta_, *ata_, words, K_);
+	}
+
 private:
+	/** Remove all words that can never reach an accepting ATA configuration from a set of successor
+	 * words. As no successor of such a word is ever bad, the word does not affect the label of the
+	 * node. If all words are hopeless, they are kept so the node is labeled when it is expanded.
+	 * @param words The successor words of a child
+	 */
+	void
+	remove_hopeless_words(std::set<CanonicalABWord<Location, ActionType>> *words) const
+	{
+		std::set<CanonicalABWord<Location, ActionType>> remaining;
+		std::copy_if(std::begin(*words),
+		             std::end(*words),
+		             std::inserter(remaining, std::end(remaining)),
+		             [this](const auto &word) { return !is_hopeless(word, ata_->get_alphabet()); });
+		if (!remaining.empty()) {
+			*words = std::move(remaining);
+		}
+	}
+
 	const automata::ta::TimedAutomaton<Location, ActionType> *const                             ta_;
 	const automata::ata::AlternatingTimedAutomaton<logic::MTLFormula<ActionType>,
 	                                               logic::AtomicProposition<ActionType>> *const ata_;
@@ -372,9 +554,14 @@ private:
 	const bool                 incremental_labeling_;
 	const bool                 terminate_early_{false};
 
+	/** The plant locations from which a final location may be reachable. */
+	const std::set<automata::ta::Location<Location>> locations_reaching_final_;
+
 	std::unique_ptr<Node>       tree_root_;
 	utilities::ThreadPool<long> pool_{utilities::ThreadPool<long>::StartOnInit::NO};
 	std::unique_ptr<Heuristic<long, Location, ActionType>> heuristic;
+	std::function<void(Node *)>                            expansion_callback_;
+	std::function<void(Node *, std::chrono::nanoseconds)>  timed_expansion_callback_;
 };
 
 } // namespace search
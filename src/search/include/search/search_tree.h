@@ -57,6 +57,7 @@ enum class LabelReason {
 	DEAD_NODE,
 	NO_ATA_SUCCESSOR,
 	MONOTONIC_DOMINATION,
+	NO_REACHABLE_FINAL_LOCATION,
 	NO_BAD_ENV_ACTION,
 	GOOD_CONTROLLER_ACTION_FIRST,
 	BAD_ENV_ACTION_FIRST
@@ -261,13 +262,15 @@ struct SearchTreeNode
 	/** The set of actions on the incoming edge, i.e., how we can reach this node from its parent */
 	std::set<std::pair<RegionIndex, ActionType>> incoming_actions;
 	/** A more detailed description for the node that explains the current label. */
-	LabelReason label_reason = LabelReason::UNKNOWN;
+	std::atomic<LabelReason> label_reason = LabelReason::UNKNOWN;
 };
 
 /** Print a node state. */
 std::ostream &operator<<(std::ostream &os, const search::NodeState &node_state);
 /** Print a node label. */
 std::ostream &operator<<(std::ostream &os, const search::NodeLabel &node_label);
+/** Print a label reason. */
+std::ostream &operator<<(std::ostream &os, const search::LabelReason &label_reason);
 
 /** @brief Print a SearchTreeNode, optionally the whole tree.
  * By default, just print information about the node itself on a single line. Optionally, also print
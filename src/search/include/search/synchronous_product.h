@@ -31,6 +31,7 @@
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <stdexcept>
 #include <type_traits>
@@ -69,6 +70,38 @@ get_region_index(const ABRegionSymbol<Location, ActionType> &w)
 	}
 }
 
+/** Get the maximal region index that an ABRegionSymbol may reach.
+ * A TA clock may be compared to any constant up to K, so its maximal region index is 2 * K + 1. The
+ * clock of an ATA state is only ever compared against the interval of its own location, so all
+ * values beyond the largest bound of that interval are equivalent. For ATA states in an until or
+ * dual until location, the maximal region index is therefore determined by the location's interval.
+ * @param w The symbol to get the maximal region index for
+ * @param K The upper bound for all constants appearing in clock constraints
+ * @return The region index at which the symbol's clock saturates
+ */
+template <typename Location, typename ActionType>
+RegionIndex
+get_maximal_region_index(const ABRegionSymbol<Location, ActionType> &w, RegionIndex K)
+{
+	if (std::holds_alternative<TARegionState<Location>>(w)) {
+		return 2 * K + 1;
+	}
+	const auto &formula = std::get<ATARegionState<ActionType>>(w).formula;
+	if (formula.get_operator() != logic::LOP::LUNTIL
+	    && formula.get_operator() != logic::LOP::LDUNTIL) {
+		return 2 * K + 1;
+	}
+	const auto  interval = formula.get_interval();
+	RegionIndex constant = 0;
+	if (interval.lowerBoundType() != utilities::arithmetic::BoundType::INFTY) {
+		constant = std::max(constant, static_cast<RegionIndex>(std::ceil(interval.lower())));
+	}
+	if (interval.upperBoundType() != utilities::arithmetic::BoundType::INFTY) {
+		constant = std::max(constant, static_cast<RegionIndex>(std::ceil(interval.upper())));
+	}
+	return 2 * std::min(constant, K) + 1;
+}
+
 /** Thrown if a canonical word is not valid. */
 class InvalidCanonicalWordException : public std::domain_error
 {
@@ -159,13 +192,15 @@ is_valid_canonical_word(const CanonicalABWord<Location, ActionType> &word)
 /// Increment the region indexes in the configurations of the given ABRegionSymbol.
 /** This is a helper function to increase the region index so we reach the next region set.
  * @param configurations The set of configurations to increment the region indexes in
- * @param max_region_index The maximal region index that may never be passed
+ * @param K The upper bound for all constants appearing in clock constraints, no region index is
+ * incremented beyond its maximal region index
  * @return A copy of the given configurations with incremented region indexes
+ * @see get_maximal_region_index
  */
 template <typename Location, typename ActionType>
 std::set<ABRegionSymbol<Location, ActionType>>
 increment_region_indexes(const std::set<ABRegionSymbol<Location, ActionType>> &configurations,
-                         RegionIndex                                           max_region_index)
+                         RegionIndex                                           K)
 {
 	// Assert that our assumption holds: All region indexes are either odd or even, never mixed.
 	assert(
@@ -181,7 +216,8 @@ increment_region_indexes(const std::set<ABRegionSymbol<Location, ActionType>> &c
 	std::transform(configurations.begin(),
 	               configurations.end(),
 	               std::inserter(res, res.end()),
-	               [max_region_index](auto configuration) {
+	               [K](auto configuration) {
+		               const RegionIndex max_region_index = get_maximal_region_index(configuration, K);
 		               if (std::holds_alternative<TARegionState<Location>>(configuration)) {
 			               auto &ta_configuration    = std::get<TARegionState<Location>>(configuration);
 			               RegionIndex &region_index = ta_configuration.region_index;
@@ -204,6 +240,49 @@ increment_region_indexes(const std::set<ABRegionSymbol<Location, ActionType>> &c
 	return res;
 }
 
+/** Move all saturated ATA states of a word into a single partition.
+ * An ATA state whose region index is its maximal region index represents all clock values beyond
+ * the bounds of its location, hence its fractional part is irrelevant. To obtain a unique word for
+ * equivalent configurations, all such states are moved into the last partition if that partition
+ * only contains saturated symbols, or into a new last partition otherwise.
+ * @param word The word to normalize
+ * @param K The upper bound for all constants appearing in clock constraints
+ * @return The normalized word
+ */
+template <typename Location, typename ActionType>
+CanonicalABWord<Location, ActionType>
+merge_saturated_ata_states(const CanonicalABWord<Location, ActionType> &word, RegionIndex K)
+{
+	const auto is_saturated = [K](const auto &symbol) {
+		return get_region_index(symbol) == get_maximal_region_index(symbol, K);
+	};
+	std::set<ABRegionSymbol<Location, ActionType>> saturated;
+	CanonicalABWord<Location, ActionType>          res;
+	for (const auto &partition : word) {
+		std::set<ABRegionSymbol<Location, ActionType>> remaining;
+		for (const auto &symbol : partition) {
+			if (std::holds_alternative<ATARegionState<ActionType>>(symbol) && is_saturated(symbol)) {
+				saturated.insert(symbol);
+			} else {
+				remaining.insert(symbol);
+			}
+		}
+		if (!remaining.empty()) {
+			res.push_back(std::move(remaining));
+		}
+	}
+	if (saturated.empty()) {
+		return word;
+	}
+	if (!res.empty() && get_region_index(*res.back().begin()) % 2 == 1
+	    && std::all_of(std::begin(res.back()), std::end(res.back()), is_saturated)) {
+		res.back().insert(std::begin(saturated), std::end(saturated));
+	} else {
+		res.push_back(std::move(saturated));
+	}
+	return res;
+}
+
 /** Get the CanonicalABWord that directly follows the given word. The next word
  * is the word Abs where the Abs_i with the maximal fractional part is
  * incremented such that it goes into the next region. This corresponds to
@@ -224,16 +303,14 @@ get_time_successor(const CanonicalABWord<Location, ActionType> &word, automata::
 		return {};
 	}
 	CanonicalABWord<Location, ActionType> res;
-	const RegionIndex                     max_region_index = 2 * K + 1;
-	// Find the last partition where at least one configuration has a region index smaller than the
+	const auto                            is_maxed = [K](const auto &configuration) {
+		return get_region_index(configuration) == get_maximal_region_index(configuration, K);
+	};
+	// Find the last partition where at least one configuration has a region index smaller than its
 	// max region index.
 	auto last_nonmax_partition =
-	  std::find_if(word.rbegin(), word.rend(), [&max_region_index](const auto &partition) {
-		  return std::any_of(partition.begin(),
-		                     partition.end(),
-		                     [&max_region_index](const auto &configuration) {
-			                     return get_region_index(configuration) != max_region_index;
-		                     });
+	  std::find_if(word.rbegin(), word.rend(), [&is_maxed](const auto &partition) {
+		  return !std::all_of(partition.begin(), partition.end(), is_maxed);
 	  });
 	// All region indexes already are the max index, nothing to increment.
 	if (last_nonmax_partition == word.rend()) {
@@ -245,7 +322,7 @@ get_time_successor(const CanonicalABWord<Location, ActionType> &word, automata::
 	std::set<ABRegionSymbol<Location, ActionType>> nonmaxed;
 	std::set<ABRegionSymbol<Location, ActionType>> maxed;
 	for (const auto &configuration : *last_nonmax_partition) {
-		if (get_region_index(configuration) == max_region_index) {
+		if (is_maxed(configuration)) {
 			maxed.insert(configuration);
 		} else {
 			nonmaxed.insert(configuration);
@@ -259,7 +336,7 @@ get_time_successor(const CanonicalABWord<Location, ActionType> &word, automata::
 	// TODO(morxa) In the latter case, we know that we have a singleton, as the maximal fractional
 	// part is 0, which is also the minimal fractional part.
 	if (!nonmaxed.empty()) {
-		res.push_back(increment_region_indexes(nonmaxed, max_region_index));
+		res.push_back(increment_region_indexes(nonmaxed, K));
 	}
 	// All the elements between last_nonmax_partition  and the last Abs_i are
 	// copied without modification.
@@ -269,7 +346,7 @@ get_time_successor(const CanonicalABWord<Location, ActionType> &word, automata::
 	if (std::prev(std::rend(word)) != last_nonmax_partition) {
 		// The first set needs to be incremented if its region indexes are even.
 		if (get_region_index(*word.begin()->begin()) % 2 == 0) {
-			res.push_back(increment_region_indexes(*word.begin(), max_region_index));
+			res.push_back(increment_region_indexes(*word.begin(), K));
 		} else {
 			res.push_back(*word.begin());
 		}
@@ -281,6 +358,7 @@ get_time_successor(const CanonicalABWord<Location, ActionType> &word, automata::
 	if (!maxed.empty()) {
 		res.push_back(std::move(maxed));
 	}
+	res = merge_saturated_ata_states(res, K);
 	assert(is_valid_canonical_word(res));
 	return res;
 }
@@ -343,12 +421,18 @@ get_canonical_word(const automata::ta::Configuration<Location> &ta_configuration
 				                                 regionSet.getRegionIndex(s.clock_valuation)};
 			  } else {
 				  const ATAState<ActionType> &s = std::get<ATAState<ActionType>>(w);
-				  return ATARegionState<ActionType>{s.location,
-				                                    regionSet.getRegionIndex(s.clock_valuation)};
+				  ATARegionState<ActionType>  region_state{s.location,
+				                                          regionSet.getRegionIndex(s.clock_valuation)};
+				  // Saturate the clock at the location's own maximal region index.
+				  region_state.region_index =
+				    std::min(region_state.region_index,
+				             get_maximal_region_index<Location, ActionType>(region_state, K));
+				  return region_state;
 			  }
 		  });
 		abs.push_back(abs_i);
 	}
+	abs = merge_saturated_ata_states(abs, K);
 	assert(is_valid_canonical_word(abs));
 	return abs;
 }
@@ -0,0 +1,311 @@
+/***************************************************************************
+ *  tree_export.h - Stream the search tree into a compact binary format
+ *
+ *  Created:   Mon 19 Oct 01:48:26 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "search_tree.h"
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace search {
+
+/** A node read from a tree export. */
+struct ExportedNode
+{
+	/** The ID of the node, unique within the export. */
+	std::uint64_t id{0};
+	/** The ID of the parent, nothing for the root. */
+	std::optional<std::uint64_t> parent;
+	/** The state of the node when it was written. */
+	NodeState state{NodeState::UNKNOWN};
+	/** The label of the node when it was written, may be updated by a later ExportedLabel. */
+	NodeLabel label{NodeLabel::UNLABELED};
+	/** The reason for the label when the node was written. */
+	LabelReason label_reason{LabelReason::UNKNOWN};
+	/** The incoming actions, each with its region increment and the printed action. */
+	std::vector<std::pair<RegionIndex, std::string>> incoming_actions;
+	/** The printed words of the node. */
+	std::vector<std::string> words;
+	/** The time spent on expanding the node, if it was measured. */
+	std::optional<std::chrono::nanoseconds> expansion_time;
+};
+
+/** A label update of a node that was written before. */
+struct ExportedLabel
+{
+	/** The ID of the node. */
+	std::uint64_t id{0};
+	/** The new label of the node. */
+	NodeLabel label{NodeLabel::UNLABELED};
+	/** The reason for the new label. */
+	LabelReason label_reason{LabelReason::UNKNOWN};
+};
+
+/** A record of a tree export. */
+using TreeExportRecord = std::variant<ExportedNode, ExportedLabel>;
+
+namespace details {
+
+/** The magic bytes at the beginning of each tree export. */
+constexpr char tree_export_magic[] = "MTLSTREE";
+/** The version of the export format. */
+constexpr std::uint64_t tree_export_version = 1;
+/** The tag of a record that defines an interned string. */
+constexpr char tree_export_string_tag = 'S';
+/** The tag of a node record. */
+constexpr char tree_export_node_tag = 'N';
+/** The tag of a label record. */
+constexpr char tree_export_label_tag = 'L';
+
+/** Write an unsigned integer as LEB128 varint.
+ * @param os The stream to write to
+ * @param value The value to write
+ */
+inline void
+write_varint(std::ostream &os, std::uint64_t value)
+{
+	while (value >= 0x80) {
+		os.put(static_cast<char>((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	os.put(static_cast<char>(value));
+}
+
+/** Read an unsigned integer encoded as LEB128 varint.
+ * @param is The stream to read from
+ * @return The read value
+ */
+std::uint64_t read_varint(std::istream &is);
+
+} // namespace details
+
+/** Write a search tree into a compact binary stream.
+ * The stream starts with a header, followed by a sequence of records. Each record starts with a
+ * one-byte tag:
+ * - 'S' defines an interned string, i.e., a printed word or action, by its ID and its bytes.
+ * - 'N' is a node with its ID, its parent's ID, its state, label, label reason, its incoming
+ *   actions, the IDs of its words, and optionally its expansion time.
+ * - 'L' updates the label and the label reason of a node written before.
+ * All integers are LEB128 varints. Each distinct word is only written once, so a large tree with
+ * many repeated words remains small. Nodes can be written incrementally during the search, e.g.,
+ * from an expansion callback. In this case, a child may be written before its parent, and the final
+ * labels must be written with write_label after the search, which only writes the labels that
+ * changed since the nodes were written. The writer is thread-safe. The writer identifies nodes by
+ * their address, so no node of the tree may be destroyed while the writer is in use.
+ * @see TreeExportReader
+ */
+template <typename Location, typename ActionType>
+class TreeExportWriter
+{
+public:
+	/** The type of the nodes to write. */
+	using Node = SearchTreeNode<Location, ActionType>;
+
+	/** Create a writer and write the header.
+	 * @param os The stream to write to, must outlive the writer
+	 */
+	explicit TreeExportWriter(std::ostream &os) : os_(os)
+	{
+		os_.write(details::tree_export_magic, sizeof(details::tree_export_magic) - 1);
+		details::write_varint(os_, details::tree_export_version);
+	}
+
+	/** Write a single node.
+	 * @param node The node to write
+	 * @param expansion_time The time spent on expanding the node, if it was measured
+	 */
+	void
+	write_node(const Node &                            node,
+	           std::optional<std::chrono::nanoseconds> expansion_time = std::nullopt)
+	{
+		std::vector<std::pair<RegionIndex, std::string>> actions;
+		for (const auto &[increment, action] : node.incoming_actions) {
+			actions.emplace_back(increment, to_string(action));
+		}
+		std::vector<std::string> words;
+		for (const auto &word : node.words) {
+			words.push_back(to_string(word));
+		}
+		const auto      label        = node.label.load();
+		const auto      label_reason = node.label_reason.load();
+		std::lock_guard lock{mutex_};
+		std::vector<std::pair<RegionIndex, std::uint64_t>> action_ids;
+		for (const auto &[increment, action] : actions) {
+			action_ids.emplace_back(increment, get_string_id(action));
+		}
+		std::vector<std::uint64_t> word_ids;
+		for (const auto &word : words) {
+			word_ids.push_back(get_string_id(word));
+		}
+		auto &entry        = get_entry(&node);
+		entry.label        = label;
+		entry.label_reason = label_reason;
+		os_.put(details::tree_export_node_tag);
+		details::write_varint(os_, entry.id);
+		details::write_varint(os_, node.parent == nullptr ? 0 : get_entry(node.parent).id + 1);
+		os_.put(static_cast<char>(node.state.load()));
+		os_.put(static_cast<char>(label));
+		os_.put(static_cast<char>(label_reason));
+		details::write_varint(os_, action_ids.size());
+		for (const auto &[increment, action_id] : action_ids) {
+			details::write_varint(os_, increment);
+			details::write_varint(os_, action_id);
+		}
+		details::write_varint(os_, word_ids.size());
+		for (const auto word_id : word_ids) {
+			details::write_varint(os_, word_id);
+		}
+		os_.put(static_cast<char>(expansion_time.has_value()));
+		if (expansion_time) {
+			details::write_varint(os_, static_cast<std::uint64_t>(expansion_time->count()));
+		}
+		++num_nodes_;
+	}
+
+	/** Write the current label of a node if it differs from the last written label of the node.
+	 * @param node The node to write the label of
+	 * @return true if the label has been written
+	 */
+	bool
+	write_label(const Node &node)
+	{
+		const auto      label        = node.label.load();
+		const auto      label_reason = node.label_reason.load();
+		std::lock_guard lock{mutex_};
+		auto &          entry = get_entry(&node);
+		if (entry.label == label && entry.label_reason == label_reason) {
+			return false;
+		}
+		entry.label        = label;
+		entry.label_reason = label_reason;
+		os_.put(details::tree_export_label_tag);
+		details::write_varint(os_, entry.id);
+		os_.put(static_cast<char>(label));
+		os_.put(static_cast<char>(label_reason));
+		return true;
+	}
+
+	/** Write all nodes of a tree in pre-order.
+	 * @param root The root of the tree to write
+	 */
+	void
+	write_tree(const Node &root)
+	{
+		// Use an explicit stack, the tree may be too deep for recursion.
+		std::vector<const Node *> stack{&root};
+		while (!stack.empty()) {
+			const Node *node = stack.back();
+			stack.pop_back();
+			write_node(*node);
+			for (auto child = node->children.rbegin(); child != node->children.rend(); ++child) {
+				stack.push_back(child->get());
+			}
+		}
+	}
+
+	/** Get the number of written node records.
+	 * @return The number of nodes written so far
+	 */
+	std::size_t
+	get_num_nodes() const
+	{
+		return num_nodes_;
+	}
+
+private:
+	template <typename T>
+	static std::string
+	to_string(const T &value)
+	{
+		std::stringstream str;
+		str << value;
+		return str.str();
+	}
+
+	/** The ID of a node and the label that was last written for it. */
+	struct NodeEntry
+	{
+		std::uint64_t id;
+		NodeLabel     label{NodeLabel::UNLABELED};
+		LabelReason   label_reason{LabelReason::UNKNOWN};
+	};
+
+	NodeEntry &
+	get_entry(const Node *node)
+	{
+		return nodes_.try_emplace(node, NodeEntry{nodes_.size()}).first->second;
+	}
+
+	std::uint64_t
+	get_string_id(const std::string &value)
+	{
+		const auto [it, inserted] = string_ids_.try_emplace(value, string_ids_.size());
+		if (inserted) {
+			os_.put(details::tree_export_string_tag);
+			details::write_varint(os_, it->second);
+			details::write_varint(os_, value.size());
+			os_.write(value.data(), static_cast<std::streamsize>(value.size()));
+		}
+		return it->second;
+	}
+
+	std::ostream &                                  os_;
+	std::mutex                                      mutex_;
+	std::unordered_map<const Node *, NodeEntry>     nodes_;
+	std::unordered_map<std::string, std::uint64_t>  string_ids_;
+	std::size_t                                     num_nodes_{0};
+};
+
+/** Read a tree export record by record.
+ * Only the interned strings are kept in memory, so even exports of very large trees can be
+ * analyzed.
+ * @see TreeExportWriter
+ */
+class TreeExportReader
+{
+public:
+	/** Create a reader and read the header.
+	 * @param is The stream to read from, must outlive the reader
+	 */
+	explicit TreeExportReader(std::istream &is);
+
+	/** Read the next node or label record.
+	 * @return The next record, or nothing if the end of the stream is reached
+	 */
+	std::optional<TreeExportRecord> next();
+
+private:
+	const std::string &get_string(std::uint64_t id) const;
+
+	std::istream &           is_;
+	std::vector<std::string> strings_;
+};
+
+} // namespace search
@@ -0,0 +1,369 @@
+/***************************************************************************
+ *  verify_controller.h - Verify a controller in closed loop with the plant
+ *
+ *  Created:   Sun 18 Oct 15:11:40 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "automata/ata.h"
+#include "automata/ta.h"
+#include "automata/ta_reachability.h"
+#include "ata_analysis.h"
+#include "canonical_word.h"
+#include "mtl/MTLFormula.h"
+#include "operators.h"
+#include "synchronous_product.h"
+#include "utilities/priority_thread_pool.h"
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace controller_synthesis {
+
+/** The result of a closed-loop verification. */
+struct VerificationResult
+{
+	/** True if no bad state is reachable and the controller covers all environment actions. */
+	bool verified{false};
+	/** The number of explored closed-loop states. */
+	std::size_t num_states{0};
+	/** The number of states that were skipped because they are dominated by a visited state. */
+	std::size_t num_pruned_states{0};
+	/** The number of reachable states that violate the specification. */
+	std::size_t num_bad_states{0};
+	/** The number of environment actions that the plant allows but the controller does not handle. */
+	std::size_t num_uncovered_actions{0};
+	/** The time spent on the verification. */
+	std::chrono::nanoseconds duration{0};
+};
+
+/** The type of an ATA that specifies the undesired behaviors. */
+template <typename ActionT>
+using SpecificationATA =
+  automata::ata::AlternatingTimedAutomaton<logic::MTLFormula<ActionT>,
+                                           logic::AtomicProposition<ActionT>>;
+
+namespace details {
+
+/** Check whether a canonical word contains the ATA sink location. */
+template <typename LocationT, typename ActionT>
+bool
+has_ata_sink(const search::CanonicalABWord<LocationT, ActionT> &word)
+{
+	const logic::MTLFormula<ActionT> sink{logic::AtomicProposition<ActionT>{"sink"}};
+	return std::any_of(std::begin(word), std::end(word), [&sink](const auto &component) {
+		return std::any_of(std::begin(component), std::end(component), [&sink](const auto &symbol) {
+			return std::holds_alternative<search::ATARegionState<ActionT>>(symbol)
+			       && std::get<search::ATARegionState<ActionT>>(symbol).formula == sink;
+		});
+	});
+}
+
+/** Get the TA part of a canonical word.
+ * If a word dominates another word, both words have the same TA part.
+ */
+template <typename LocationT, typename ActionT>
+std::set<search::TARegionState<LocationT>>
+get_ta_region_states(const search::CanonicalABWord<LocationT, ActionT> &word)
+{
+	std::set<search::TARegionState<LocationT>> res;
+	for (const auto &component : word) {
+		for (const auto &symbol : component) {
+			if (std::holds_alternative<search::TARegionState<LocationT>>(symbol)) {
+				res.insert(std::get<search::TARegionState<LocationT>>(symbol));
+			}
+		}
+	}
+	return res;
+}
+
+/** Explore the closed loop of a plant, a specification, and a controller.
+ * @see verify_controller
+ */
+template <typename LocationT, typename ActionT, typename ControllerLocationT>
+class ClosedLoopVerifier
+{
+public:
+	/** A closed-loop state, consisting of a canonical word and a controller location. */
+	using State = std::pair<search::CanonicalABWord<LocationT, ActionT>,
+	                        automata::ta::Location<ControllerLocationT>>;
+
+	/** Initialize the verifier.
+	 * @param plant The plant
+	 * @param ata The specification of undesired behaviors
+	 * @param controller The controller
+	 * @param controller_actions The actions that the controller may decide to take
+	 * @param environment_actions The actions controlled by the environment
+	 * @param K The maximal constant occurring in a clock constraint
+	 */
+	ClosedLoopVerifier(const automata::ta::TimedAutomaton<LocationT, ActionT> &          plant,
+	                   const SpecificationATA<ActionT> &                                 ata,
+	                   const automata::ta::TimedAutomaton<ControllerLocationT, ActionT> &controller,
+	                   const std::set<ActionT> &controller_actions,
+	                   const std::set<ActionT> &environment_actions,
+	                   search::RegionIndex      K)
+	: plant_(plant),
+	  ata_(ata),
+	  controller_(controller),
+	  controller_actions_(controller_actions),
+	  environment_actions_(environment_actions),
+	  K_(K),
+	  locations_reaching_final_(
+	    automata::ta::get_coreachable_locations(plant, plant.get_final_locations()))
+	{
+	}
+
+	/** Run the verification.
+	 * @param multi_threaded If true, explore the states with a thread pool
+	 * @return The result of the verification
+	 */
+	VerificationResult
+	run(bool multi_threaded)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		add_state({search::get_canonical_word(plant_.get_initial_configuration(),
+		                                      ata_.get_initial_configuration(),
+		                                      K_),
+		           controller_.get_initial_location()},
+		          0);
+		if (multi_threaded) {
+			pool_.start();
+			pool_.wait();
+		} else {
+			utilities::QueueAccess queue_access{&pool_};
+			while (!queue_access.empty()) {
+				auto job = std::get<1>(queue_access.top());
+				queue_access.pop();
+				job();
+			}
+		}
+		VerificationResult result;
+		result.num_states            = num_states_;
+		result.num_pruned_states     = num_pruned_states_;
+		result.num_bad_states        = num_bad_states_;
+		result.num_uncovered_actions = num_uncovered_actions_;
+		result.verified              = num_bad_states_ == 0 && num_uncovered_actions_ == 0;
+		result.duration              = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		  std::chrono::steady_clock::now() - start);
+		return result;
+	}
+
+private:
+	using TAPart = std::set<search::TARegionState<LocationT>>;
+
+	/** Check whether the controller does not have any outgoing transitions in the given location. */
+	bool
+	is_leaf(const automata::ta::Location<ControllerLocationT> &location) const
+	{
+		return controller_.get_transitions().count(location) == 0;
+	}
+
+	/** Add a state to the queue unless it is dominated by a visited state.
+	 * A visited state with the same controller location dominates the new state if its word is
+	 * dominated by the new word, as the new word has the same TA part and only additional ATA
+	 * obligations. In a leaf of the controller, the search stopped because of such a domination with
+	 * an ancestor, so in this case any visited state may dominate the new state.
+	 */
+	void
+	add_state(State state, long depth)
+	{
+		{
+			std::lock_guard lock{visited_mutex_};
+			auto &          visited = visited_[get_ta_region_states(state.first)];
+			const bool      leaf    = is_leaf(state.second);
+			if (std::any_of(std::begin(visited), std::end(visited), [&state, leaf](const auto &other) {
+				    return (leaf || other.second == state.second)
+				           && search::is_monotonically_dominated(other.first, state.first);
+			    })) {
+				++num_pruned_states_;
+				return;
+			}
+			visited.push_back(state);
+		}
+		pool_.add_job([this, state = std::move(state), depth] { process_state(state, depth); },
+		              -depth);
+	}
+
+	/** Get the controller transitions that are enabled for the given symbol. */
+	std::vector<const automata::ta::Transition<ControllerLocationT, ActionT> *>
+	get_enabled_transitions(const automata::ta::Location<ControllerLocationT> &location,
+	                        const ActionT &                                     symbol,
+	                        const automata::ClockSetValuation &clock_valuations) const
+	{
+		std::vector<const automata::ta::Transition<ControllerLocationT, ActionT> *> res;
+		const auto [first, last] = controller_.get_transitions().equal_range(location);
+		for (auto it = first; it != last; ++it) {
+			if (it->second.is_enabled(symbol, clock_valuations)) {
+				res.push_back(&it->second);
+			}
+		}
+		return res;
+	}
+
+	void
+	process_state(const State &state, long depth)
+	{
+		++num_states_;
+		const auto &[word, location] = state;
+		const auto candidate         = search::get_candidate(word);
+		if (plant_.is_accepting_configuration(candidate.first)
+		    && ata_.is_accepting_configuration(candidate.second)) {
+			SPDLOG_DEBUG("Closed loop reaches bad state {} in controller location {}", word, location);
+			++num_bad_states_;
+			return;
+		}
+		if (has_ata_sink(word) || search::is_hopeless(word, ata_.get_alphabet())) {
+			// The specification can no longer be violated. The search labels such nodes as good without
+			// expanding them, so the controller does not need to handle any further actions.
+			return;
+		}
+		if (locations_reaching_final_.count(candidate.first.location) == 0) {
+			// The plant can no longer reach a final location, so no bad state is reachable.
+			return;
+		}
+		const auto time_successors = search::get_time_successors(word, K_);
+		// The controller acts as soon as possible. Find the first time successor where it can act.
+		std::size_t controller_step = std::numeric_limits<std::size_t>::max();
+		std::vector<std::pair<State, long>> successors;
+		for (std::size_t step = 0; step < time_successors.size(); ++step) {
+			const auto step_candidate = search::get_candidate(time_successors[step].second);
+			for (const auto &action : controller_actions_) {
+				const auto next_words =
+				  search::get_next_canonical_words(plant_, ata_, step_candidate, action, K_);
+				if (next_words.empty()) {
+					continue;
+				}
+				for (const auto *transition :
+				     get_enabled_transitions(location, action, step_candidate.first.clock_valuations)) {
+					controller_step = step;
+					for (const auto &next_word : next_words) {
+						successors.emplace_back(State{next_word, transition->target_}, depth + 1);
+					}
+				}
+			}
+			if (controller_step == step) {
+				break;
+			}
+		}
+		// The environment may act at any time until the controller acts. If both can act in the same
+		// region, the environment may also act first, as the search gives ties to the environment.
+		for (std::size_t step = 0; step < time_successors.size() && step <= controller_step; ++step) {
+			const auto step_candidate = search::get_candidate(time_successors[step].second);
+			for (const auto &action : environment_actions_) {
+				const auto next_words =
+				  search::get_next_canonical_words(plant_, ata_, step_candidate, action, K_);
+				if (next_words.empty()) {
+					continue;
+				}
+				const auto transitions =
+				  get_enabled_transitions(location, action, step_candidate.first.clock_valuations);
+				if (transitions.empty()) {
+					SPDLOG_DEBUG("Controller location {} does not handle action {} from {}",
+					             location,
+					             action,
+					             time_successors[step].second);
+					++num_uncovered_actions_;
+					continue;
+				}
+				for (const auto *transition : transitions) {
+					for (const auto &next_word : next_words) {
+						successors.emplace_back(State{next_word, transition->target_}, depth + 1);
+					}
+				}
+			}
+		}
+		for (auto &[successor, successor_depth] : successors) {
+			add_state(std::move(successor), successor_depth);
+		}
+	}
+
+	const automata::ta::TimedAutomaton<LocationT, ActionT> &           plant_;
+	const SpecificationATA<ActionT> &                                  ata_;
+	const automata::ta::TimedAutomaton<ControllerLocationT, ActionT> &controller_;
+	const std::set<ActionT> &                                          controller_actions_;
+	const std::set<ActionT> &                                          environment_actions_;
+	const search::RegionIndex                                          K_;
+	const std::set<automata::ta::Location<LocationT>>                  locations_reaching_final_;
+	/** The visited states, indexed by the TA part of their words. */
+	std::map<TAPart, std::vector<State>> visited_;
+	std::mutex                           visited_mutex_;
+	std::atomic_size_t                   num_states_{0};
+	std::atomic_size_t                   num_pruned_states_{0};
+	std::atomic_size_t                   num_bad_states_{0};
+	std::atomic_size_t                   num_uncovered_actions_{0};
+	utilities::ThreadPool<long> pool_{utilities::ThreadPool<long>::StartOnInit::NO};
+};
+
+} // namespace details
+
+/** Verify a controller in closed loop with the plant and the specification.
+ * This explores all reachable states of the plant controlled by the controller with the same
+ * canonical words as the search, but independently of the search tree. In each state, the
+ * controller takes one of its actions as soon as possible. Until then, including the region in
+ * which the controller acts, the environment may take any of its actions that the plant allows.
+ * The controller must have a transition for each such environment action, otherwise the action is
+ * reported as uncovered. If the controller is nondeterministic, all choices are verified. The
+ * exploration stops in states in which the specification can no longer be violated or the plant
+ * can no longer reach a final location, and prunes states that are dominated by visited states.
+ * @param plant The plant
+ * @param ata The specification of undesired behaviors
+ * @param controller The controller, e.g., as created by create_controller
+ * @param controller_actions The actions that the controller may decide to take
+ * @param environment_actions The actions controlled by the environment
+ * @param K The maximal constant occurring in a clock constraint
+ * @param multi_threaded If true, explore the states with a thread pool
+ * @return The verification result including the number of explored states and the time spent
+ */
+template <typename LocationT, typename ActionT, typename ControllerLocationT>
+VerificationResult
+verify_controller(const automata::ta::TimedAutomaton<LocationT, ActionT> &           plant,
+                  const SpecificationATA<ActionT> &                                  ata,
+                  const automata::ta::TimedAutomaton<ControllerLocationT, ActionT> &controller,
+                  const std::set<ActionT> &controller_actions,
+                  const std::set<ActionT> &environment_actions,
+                  search::RegionIndex      K,
+                  bool                     multi_threaded = true)
+{
+	std::set<std::string> unknown_clocks;
+	std::set_difference(std::begin(controller.get_clocks()),
+	                    std::end(controller.get_clocks()),
+	                    std::begin(plant.get_clocks()),
+	                    std::end(plant.get_clocks()),
+	                    std::inserter(unknown_clocks, std::end(unknown_clocks)));
+	if (!unknown_clocks.empty()) {
+		throw std::invalid_argument(
+		  fmt::format("The controller uses clocks that are not in the plant: {}",
+		              fmt::join(unknown_clocks, ", ")));
+	}
+	return details::ClosedLoopVerifier<LocationT, ActionT, ControllerLocationT>(
+	         plant, ata, controller, controller_actions, environment_actions, K)
+	  .run(multi_threaded);
+}
+
+} // namespace controller_synthesis
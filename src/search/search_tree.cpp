@@ -46,4 +46,22 @@ operator<<(std::ostream &os, const search::NodeLabel &node_label)
 	return os;
 }
 
+std::ostream &
+operator<<(std::ostream &os, const search::LabelReason &label_reason)
+{
+	using search::LabelReason;
+	switch (label_reason) {
+	case LabelReason::UNKNOWN: os << "unknown"; break;
+	case LabelReason::BAD_NODE: os << "bad node"; break;
+	case LabelReason::DEAD_NODE: os << "dead node"; break;
+	case LabelReason::NO_ATA_SUCCESSOR: os << "no ATA successor"; break;
+	case LabelReason::MONOTONIC_DOMINATION: os << "monotonic domination"; break;
+	case LabelReason::NO_REACHABLE_FINAL_LOCATION: os << "no reachable final location"; break;
+	case LabelReason::NO_BAD_ENV_ACTION: os << "no bad env action"; break;
+	case LabelReason::GOOD_CONTROLLER_ACTION_FIRST: os << "good controller action first"; break;
+	case LabelReason::BAD_ENV_ACTION_FIRST: os << "bad env action first"; break;
+	}
+	return os;
+}
+
 } // namespace search
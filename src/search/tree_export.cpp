@@ -0,0 +1,159 @@
+/***************************************************************************
+ *  tree_export.cpp - Read a search tree export
+ *
+ *  Created:   Mon 19 Oct 01:48:26 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "search/tree_export.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace search {
+
+namespace details {
+
+std::uint64_t
+read_varint(std::istream &is)
+{
+	std::uint64_t value = 0;
+	for (unsigned int shift = 0; shift < 64; shift += 7) {
+		const auto byte = is.get();
+		if (byte == std::istream::traits_type::eof()) {
+			throw std::invalid_argument("Unexpected end of the tree export");
+		}
+		value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0) {
+			return value;
+		}
+	}
+	throw std::invalid_argument("Invalid varint in the tree export");
+}
+
+} // namespace details
+
+namespace {
+
+/** Read a one-byte enum value and check that it is at most max_value. */
+template <typename Enum>
+Enum
+read_enum(std::istream &is, Enum max_value)
+{
+	const auto byte = is.get();
+	if (byte == std::istream::traits_type::eof()) {
+		throw std::invalid_argument("Unexpected end of the tree export");
+	}
+	if (byte > static_cast<int>(max_value)) {
+		throw std::invalid_argument("Invalid enum value in the tree export");
+	}
+	return static_cast<Enum>(byte);
+}
+
+/** Read a string of the given size.
+ * The string grows in chunks while its bytes are read, so a corrupt size fails at the end of the
+ * stream instead of allocating the full size up front.
+ */
+std::string
+read_string(std::istream &is, std::uint64_t size)
+{
+	constexpr std::uint64_t chunk_size = 1 << 16;
+	std::string             value;
+	while (value.size() < size) {
+		const auto offset = value.size();
+		const auto chunk  = std::min(size - offset, chunk_size);
+		value.resize(offset + chunk);
+		if (!is.read(value.data() + offset, static_cast<std::streamsize>(chunk))) {
+			throw std::invalid_argument("Unexpected end of the tree export");
+		}
+	}
+	return value;
+}
+
+} // namespace
+
+TreeExportReader::TreeExportReader(std::istream &is) : is_(is)
+{
+	std::string magic(sizeof(details::tree_export_magic) - 1, '\0');
+	is_.read(magic.data(), static_cast<std::streamsize>(magic.size()));
+	if (!is_ || magic != details::tree_export_magic) {
+		throw std::invalid_argument("The stream is not a tree export");
+	}
+	if (const auto version = details::read_varint(is_); version != details::tree_export_version) {
+		throw std::invalid_argument("Unsupported tree export version " + std::to_string(version));
+	}
+}
+
+std::optional<TreeExportRecord>
+TreeExportReader::next()
+{
+	while (true) {
+		const auto tag = is_.get();
+		if (tag == std::istream::traits_type::eof()) {
+			return std::nullopt;
+		}
+		switch (tag) {
+		case details::tree_export_string_tag: {
+			const auto id    = details::read_varint(is_);
+			auto       value = read_string(is_, details::read_varint(is_));
+			if (id != strings_.size()) {
+				throw std::invalid_argument("Invalid string in the tree export");
+			}
+			strings_.push_back(std::move(value));
+			break;
+		}
+		case details::tree_export_node_tag: {
+			ExportedNode node;
+			node.id = details::read_varint(is_);
+			if (const auto parent = details::read_varint(is_); parent > 0) {
+				node.parent = parent - 1;
+			}
+			node.state        = read_enum(is_, NodeState::DEAD);
+			node.label        = read_enum(is_, NodeLabel::CANCELED);
+			node.label_reason = read_enum(is_, LabelReason::BAD_ENV_ACTION_FIRST);
+			for (auto num_actions = details::read_varint(is_); num_actions > 0; --num_actions) {
+				const auto increment = static_cast<RegionIndex>(details::read_varint(is_));
+				node.incoming_actions.emplace_back(increment, get_string(details::read_varint(is_)));
+			}
+			for (auto num_words = details::read_varint(is_); num_words > 0; --num_words) {
+				node.words.push_back(get_string(details::read_varint(is_)));
+			}
+			if (read_enum(is_, 1) != 0) {
+				node.expansion_time = std::chrono::nanoseconds(details::read_varint(is_));
+			}
+			return node;
+		}
+		case details::tree_export_label_tag: {
+			ExportedLabel label;
+			label.id           = details::read_varint(is_);
+			label.label        = read_enum(is_, NodeLabel::CANCELED);
+			label.label_reason = read_enum(is_, LabelReason::BAD_ENV_ACTION_FIRST);
+			return label;
+		}
+		default: throw std::invalid_argument("Invalid record in the tree export");
+		}
+	}
+}
+
+const std::string &
+TreeExportReader::get_string(std::uint64_t id) const
+{
+	if (id >= strings_.size()) {
+		throw std::invalid_argument("Undefined string in the tree export");
+	}
+	return strings_[id];
+}
+
+} // namespace search
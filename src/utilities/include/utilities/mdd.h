@@ -0,0 +1,332 @@
+/***************************************************************************
+ *  mdd.h - Multi-valued decision diagrams over sequences
+ *
+ *  Created:   Sun 18 Oct 20:14:08 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace utilities::mdd {
+
+/** The ID of a decision diagram node. */
+using NodeId = std::uint32_t;
+/** The value of a variable. */
+using Value = std::uint32_t;
+
+/** The node of the empty set. */
+inline constexpr NodeId false_node = 0;
+/** The node that only accepts the end of a sequence. */
+inline constexpr NodeId true_node = 1;
+/** The value that terminates each sequence. */
+inline constexpr Value end_value = std::numeric_limits<Value>::max();
+
+/** @brief A manager of multi-valued decision diagrams that represent sets of sequences.
+ * The i-th variable of a diagram is the i-th element of a sequence. Each node has a sparse list of
+ * outgoing edges sorted by their value, values without edge lead to the empty set. Each sequence is
+ * terminated by end_value, which leads to true_node. As the sequences may have different lengths,
+ * the diagrams are quasi-reduced, i.e., no variable is skipped.
+ *
+ * All nodes are hash-consed, so there is exactly one node for each set of sequences, and equal
+ * sets have the same ID. This makes each diagram the minimal deterministic automaton of its set,
+ * and sets with a shared structure share their nodes. The results of the set operations are cached.
+ *
+ * The manager is not thread-safe.
+ */
+class Manager
+{
+public:
+	/** The outgoing edges of a node, sorted by their value. */
+	using Edges = std::vector<std::pair<Value, NodeId>>;
+
+	/** Create a manager that only contains the terminal nodes. */
+	Manager() : nodes_{Edges{}, Edges{}}
+	{
+	}
+
+	/** Get the node with the given outgoing edges.
+	 * @param edges The outgoing edges with distinct values in increasing order, edges to false_node
+	 * are ignored
+	 * @return The unique node with those edges, false_node if there is no edge
+	 */
+	NodeId
+	make_node(Edges edges)
+	{
+		edges.erase(std::remove_if(std::begin(edges),
+		                           std::end(edges),
+		                           [](const auto &edge) { return edge.second == false_node; }),
+		            std::end(edges));
+		if (edges.empty()) {
+			return false_node;
+		}
+		if (std::adjacent_find(std::begin(edges),
+		                       std::end(edges),
+		                       [](const auto &first, const auto &second) {
+			                       return first.first >= second.first;
+		                       })
+		    != std::end(edges)) {
+			throw std::invalid_argument("The edges of a decision diagram node must be sorted by value");
+		}
+		if (edges.size() == 1 && edges.front() == std::make_pair(end_value, true_node)) {
+			return true_node;
+		}
+		const auto [it, is_new] = unique_table_.emplace(edges, static_cast<NodeId>(nodes_.size()));
+		if (is_new) {
+			nodes_.push_back(std::move(edges));
+		}
+		return it->second;
+	}
+
+	/** Get the diagram that contains exactly one sequence.
+	 * @param sequence The sequence, which must not contain end_value
+	 * @return The diagram of the singleton set
+	 */
+	NodeId
+	make_sequence(const std::vector<Value> &sequence)
+	{
+		NodeId node = true_node;
+		for (auto value = std::rbegin(sequence); value != std::rend(sequence); ++value) {
+			if (*value == end_value) {
+				throw std::invalid_argument("A sequence must not contain the end value");
+			}
+			node = make_node({{*value, node}});
+		}
+		return node;
+	}
+
+	/** Get the outgoing edges of a node.
+	 * @param node The node
+	 * @return The edges of the node, sorted by their value
+	 */
+	const Edges &
+	get_edges(NodeId node) const
+	{
+		if (node == true_node) {
+			return true_edges_;
+		}
+		return nodes_.at(node);
+	}
+
+	/** Compute the union of two sets. */
+	NodeId
+	unite(NodeId first, NodeId second)
+	{
+		if (first == second || second == false_node) {
+			return first;
+		}
+		if (first == false_node) {
+			return second;
+		}
+		return apply(&union_cache_, std::min(first, second), std::max(first, second), true, true);
+	}
+
+	/** Compute the intersection of two sets. */
+	NodeId
+	intersect(NodeId first, NodeId second)
+	{
+		if (first == second) {
+			return first;
+		}
+		if (first == false_node || second == false_node) {
+			return false_node;
+		}
+		return apply(
+		  &intersection_cache_, std::min(first, second), std::max(first, second), false, false);
+	}
+
+	/** Compute the set difference of two sets. */
+	NodeId
+	subtract(NodeId first, NodeId second)
+	{
+		if (first == second || first == false_node) {
+			return false_node;
+		}
+		if (second == false_node) {
+			return first;
+		}
+		return apply(&difference_cache_, first, second, true, false);
+	}
+
+	/** Check whether a sequence is contained in a set. */
+	bool
+	contains(NodeId node, const std::vector<Value> &sequence) const
+	{
+		for (const auto value : sequence) {
+			node = get_child(node, value);
+		}
+		return get_child(node, end_value) == true_node;
+	}
+
+	/** Count the sequences in a set. */
+	std::size_t
+	count(NodeId node) const
+	{
+		std::map<NodeId, std::size_t> counts{{false_node, 0}, {true_node, 1}};
+		return count(node, &counts);
+	}
+
+	/** Get the number of nodes of a diagram, including the terminal nodes it reaches. */
+	std::size_t
+	get_size(NodeId node) const
+	{
+		std::vector<NodeId> stack{node};
+		std::vector<bool>   visited(nodes_.size(), false);
+		std::size_t         size = 0;
+		while (!stack.empty()) {
+			const auto current = stack.back();
+			stack.pop_back();
+			if (visited[current]) {
+				continue;
+			}
+			visited[current] = true;
+			++size;
+			for (const auto &[value, child] : get_edges(current)) {
+				stack.push_back(child);
+			}
+		}
+		return size;
+	}
+
+	/** Get all sequences of a set.
+	 * The sequences are ordered by their values, where each sequence comes after its extensions.
+	 */
+	std::vector<std::vector<Value>>
+	get_sequences(NodeId node) const
+	{
+		std::vector<std::vector<Value>> res;
+		std::vector<Value>              prefix;
+		collect_sequences(node, &prefix, &res);
+		return res;
+	}
+
+	/** Get the number of nodes managed by this manager, including the terminal nodes. */
+	std::size_t
+	get_num_nodes() const
+	{
+		return nodes_.size();
+	}
+
+private:
+	NodeId
+	get_child(NodeId node, Value value) const
+	{
+		const auto &edges = get_edges(node);
+		const auto  it =
+		  std::lower_bound(std::begin(edges), std::end(edges), std::make_pair(value, NodeId{0}));
+		if (it == std::end(edges) || it->first != value) {
+			return false_node;
+		}
+		return it->second;
+	}
+
+	/** Combine two sets value by value.
+	 * @param cache The cache of the operation
+	 * @param keep_first Whether to keep the edges that only occur in the first set
+	 * @param keep_second Whether to keep the edges that only occur in the second set
+	 */
+	NodeId
+	apply(std::map<std::pair<NodeId, NodeId>, NodeId> *cache,
+	      NodeId                                       first,
+	      NodeId                                       second,
+	      bool                                         keep_first,
+	      bool                                         keep_second)
+	{
+		if (const auto it = cache->find({first, second}); it != std::end(*cache)) {
+			return it->second;
+		}
+		// Copy the edges, as creating nodes may invalidate references into nodes_.
+		const Edges first_edges  = get_edges(first);
+		const Edges second_edges = get_edges(second);
+		Edges       edges;
+		auto        it1 = std::begin(first_edges);
+		auto        it2 = std::begin(second_edges);
+		while (it1 != std::end(first_edges) || it2 != std::end(second_edges)) {
+			if (it2 == std::end(second_edges)
+			    || (it1 != std::end(first_edges) && it1->first < it2->first)) {
+				if (keep_first) {
+					edges.push_back(*it1);
+				}
+				++it1;
+			} else if (it1 == std::end(first_edges) || it2->first < it1->first) {
+				if (keep_second) {
+					edges.push_back(*it2);
+				}
+				++it2;
+			} else {
+				NodeId child;
+				if (keep_first && keep_second) {
+					child = unite(it1->second, it2->second);
+				} else if (keep_first) {
+					child = subtract(it1->second, it2->second);
+				} else {
+					child = intersect(it1->second, it2->second);
+				}
+				edges.emplace_back(it1->first, child);
+				++it1;
+				++it2;
+			}
+		}
+		const auto res = make_node(std::move(edges));
+		cache->emplace(std::make_pair(first, second), res);
+		return res;
+	}
+
+	std::size_t
+	count(NodeId node, std::map<NodeId, std::size_t> *counts) const
+	{
+		if (const auto it = counts->find(node); it != std::end(*counts)) {
+			return it->second;
+		}
+		std::size_t res = 0;
+		for (const auto &[value, child] : get_edges(node)) {
+			res += count(child, counts);
+		}
+		counts->emplace(node, res);
+		return res;
+	}
+
+	void
+	collect_sequences(NodeId                           node,
+	                  std::vector<Value> *             prefix,
+	                  std::vector<std::vector<Value>> *sequences) const
+	{
+		for (const auto &[value, child] : get_edges(node)) {
+			if (value == end_value) {
+				sequences->push_back(*prefix);
+				continue;
+			}
+			prefix->push_back(value);
+			collect_sequences(child, prefix, sequences);
+			prefix->pop_back();
+		}
+	}
+
+	const Edges                                 true_edges_{{end_value, true_node}};
+	std::vector<Edges>                          nodes_;
+	std::map<Edges, NodeId>                     unique_table_;
+	std::map<std::pair<NodeId, NodeId>, NodeId> union_cache_;
+	std::map<std::pair<NodeId, NodeId>, NodeId> intersection_cache_;
+	std::map<std::pair<NodeId, NodeId>, NodeId> difference_cache_;
+};
+
+} // namespace utilities::mdd
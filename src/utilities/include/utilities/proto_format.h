@@ -0,0 +1,55 @@
+/***************************************************************************
+ *  proto_format.h - Determine the serialization format of proto files
+ *
+ *  Created:   Sun 18 Oct 22:41:09 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include <filesystem>
+
+namespace utilities {
+
+/** The serialization format of a proto file. */
+enum class ProtoFormat {
+	/** Determine the format from the file extension. */
+	AUTO,
+	/** The human-readable text format, e.g., pbtxt. */
+	TEXT,
+	/** The binary wire format. */
+	BINARY,
+};
+
+/** Get the format of a proto file.
+ * @param path The path of the file
+ * @param format The requested format, AUTO to determine it from the extension
+ * @return BINARY if the format is BINARY, or if it is AUTO and the file ends with .pb or .bin;
+ * TEXT otherwise
+ */
+inline ProtoFormat
+get_proto_format(const std::filesystem::path &path, ProtoFormat format = ProtoFormat::AUTO)
+{
+	if (format != ProtoFormat::AUTO) {
+		return format;
+	}
+	const auto extension = path.extension();
+	if (extension == ".pb" || extension == ".bin") {
+		return ProtoFormat::BINARY;
+	}
+	return ProtoFormat::TEXT;
+}
+
+} // namespace utilities
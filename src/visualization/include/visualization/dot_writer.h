@@ -0,0 +1,238 @@
+/***************************************************************************
+ *  dot_writer.h - Stream search trees and timed automata as dot text
+ *
+ *  Created:   Mon 19 Oct 02:41:57 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include <automata/ta.h>
+#include <fmt/format.h>
+#include <search/search_tree.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace visualization {
+
+/** Options to limit the size of a streamed dot graph. A limit of 0 means unlimited. */
+struct DotOptions
+{
+	/** Only write nodes up to this depth, deeper sub-trees are collapsed into a single node. */
+	std::size_t max_depth{0};
+	/** Only write this many children of each node, evenly sampled, and summarize the others. */
+	std::size_t max_children{0};
+	/** Truncate node and edge labels to this number of characters. */
+	std::size_t max_label_length{0};
+	/** Skip nodes that have been canceled. */
+	bool skip_canceled{false};
+};
+
+namespace details {
+
+/** Truncate and escape a label so it can be used as quoted dot string.
+ * @param label The label to escape
+ * @param max_length The maximal number of characters of the label, 0 for unlimited
+ * @return The escaped label
+ */
+inline std::string
+escape_dot_label(const std::string &label, std::size_t max_length = 0)
+{
+	const bool  truncate = max_length > 0 && label.size() > max_length;
+	std::string res;
+	res.reserve(label.size() + 2);
+	for (const char c : truncate ? label.substr(0, max_length) : label) {
+		switch (c) {
+		case '"': res += "\\\""; break;
+		case '\\': res += "\\\\"; break;
+		case '\n': res += "\\n"; break;
+		default: res += c;
+		}
+	}
+	if (truncate) {
+		res += "...";
+	}
+	return res;
+}
+
+/** Count the nodes of a sub-tree without recursion.
+ * @param node The root of the sub-tree
+ * @return The number of nodes in the sub-tree, including the node itself
+ */
+template <typename LocationT, typename ActionT>
+std::size_t
+count_subtree_nodes(const search::SearchTreeNode<LocationT, ActionT> &node)
+{
+	std::size_t                                                     count = 0;
+	std::vector<const search::SearchTreeNode<LocationT, ActionT> *> stack{&node};
+	while (!stack.empty()) {
+		const auto *current = stack.back();
+		stack.pop_back();
+		++count;
+		for (const auto &child : current->children) {
+			stack.push_back(child.get());
+		}
+	}
+	return count;
+}
+
+/** Get the label of a search tree node, consisting of its label reason, its incoming actions, and
+ * its words, each on its own line. */
+template <typename LocationT, typename ActionT>
+std::string
+get_search_node_label(const search::SearchTreeNode<LocationT, ActionT> &node)
+{
+	std::stringstream str;
+	str << node.label_reason;
+	for (const auto &[increment, action] : node.incoming_actions) {
+		str << "\n(" << increment << ", " << action << ")";
+	}
+	for (const auto &word : node.words) {
+		str << "\n" << word;
+	}
+	return str.str();
+}
+
+} // namespace details
+
+/** @brief Write a search tree as dot graph while traversing it.
+ * In contrast to search_tree_to_graphviz, this does not build a graph in memory, but writes each
+ * node and edge as soon as it is visited, so it also works for very large trees. The options limit
+ * the size of the output: Sub-trees below the maximal depth are collapsed into a single node that
+ * shows the number of collapsed nodes. If a node has more children than allowed, only an evenly
+ * spaced sample of them is written, and the others are summarized in a single node.
+ * @param os The stream to write to
+ * @param root The root node of the tree
+ * @param options The options to limit the size of the graph
+ * @return The number of written search tree nodes, not counting summary nodes
+ */
+template <typename LocationT, typename ActionT>
+std::size_t
+write_search_tree_dot(std::ostream &                                      os,
+                      const search::SearchTreeNode<LocationT, ActionT> &root,
+                      const DotOptions &                                  options = {})
+{
+	using Node = search::SearchTreeNode<LocationT, ActionT>;
+	os << "digraph {\n  rankdir=LR;\n  node [shape=box];\n";
+	std::size_t num_nodes = 0;
+	std::size_t next_id   = 0;
+	// Each entry is a node along with its depth and the ID of its parent node in the graph.
+	std::vector<std::tuple<const Node *, std::size_t, std::size_t>> stack{{&root, 0, 0}};
+	while (!stack.empty()) {
+		const auto [node, depth, parent_id] = stack.back();
+		stack.pop_back();
+		if (options.skip_canceled && node->label == search::NodeLabel::CANCELED) {
+			continue;
+		}
+		const std::size_t id = next_id++;
+		++num_nodes;
+		os << "  n" << id << " [label=\""
+		   << details::escape_dot_label(details::get_search_node_label(*node),
+		                                options.max_label_length)
+		   << "\"";
+		if (node->label == search::NodeLabel::TOP) {
+			os << ", color=green";
+		} else if (node->label == search::NodeLabel::BOTTOM) {
+			os << ", color=red";
+		}
+		os << "];\n";
+		if (node != &root) {
+			os << "  n" << parent_id << " -> n" << id << ";\n";
+		}
+		const auto &children = node->children;
+		if (children.empty()) {
+			continue;
+		}
+		if (options.max_depth > 0 && depth >= options.max_depth) {
+			std::size_t collapsed = 0;
+			for (const auto &child : children) {
+				collapsed += details::count_subtree_nodes(*child);
+			}
+			const std::size_t summary_id = next_id++;
+			os << "  n" << summary_id << " [label=\"" << collapsed
+			   << " collapsed nodes\", shape=ellipse, style=dashed];\n";
+			os << "  n" << id << " -> n" << summary_id << " [style=dashed];\n";
+			continue;
+		}
+		const std::size_t num_sampled = options.max_children > 0
+		                                  ? std::min(options.max_children, children.size())
+		                                  : children.size();
+		if (num_sampled < children.size()) {
+			const std::size_t summary_id = next_id++;
+			os << "  n" << summary_id << " [label=\"" << children.size() - num_sampled
+			   << " more children\", shape=ellipse, style=dashed];\n";
+			os << "  n" << id << " -> n" << summary_id << " [style=dashed];\n";
+		}
+		// Push in reverse order so the children are written in their original order.
+		for (std::size_t i = num_sampled; i > 0; --i) {
+			const std::size_t index = (i - 1) * children.size() / num_sampled;
+			stack.emplace_back(children[index].get(), depth + 1, id);
+		}
+	}
+	os << "}\n";
+	return num_nodes;
+}
+
+/** @brief Write a timed automaton as dot graph without building it in memory.
+ * @param os The stream to write to
+ * @param ta The timed automaton to write
+ * @param show_node_labels If false, draw locations as points without labels
+ * @param options The options, only the label length applies to automata
+ */
+template <typename LocationT, typename ActionT>
+void
+write_ta_dot(std::ostream &                                          os,
+             const automata::ta::TimedAutomaton<LocationT, ActionT> &ta,
+             bool                                                    show_node_labels = true,
+             const DotOptions &                                      options          = {})
+{
+	os << "digraph {\n";
+	if (!show_node_labels) {
+		os << "  node [shape=point];\n";
+	}
+	os << "  init [label=\"\", shape=none];\n";
+	std::map<automata::ta::Location<LocationT>, std::size_t> ids;
+	for (const auto &location : ta.get_locations()) {
+		const std::size_t id = ids.size();
+		ids.emplace(location, id);
+		std::stringstream str;
+		str << location;
+		os << "  n" << id << " [label=\""
+		   << details::escape_dot_label(str.str(), options.max_label_length) << "\"";
+		if (ta.get_final_locations().count(location) > 0) {
+			os << ", peripheries=2";
+		}
+		os << "];\n";
+	}
+	os << "  init -> n" << ids.at(ta.get_initial_location()) << ";\n";
+	for (const auto &[source, transition] : ta.get_transitions()) {
+		std::stringstream edge;
+		edge << " " << transition.symbol_ << " \n " << transition.clock_constraints_ << " \n "
+		     << fmt::format("{{{}}}", fmt::join(transition.clock_resets_, ", ")) << " ";
+		os << "  n" << ids.at(transition.source_) << " -> n" << ids.at(transition.target_)
+		   << " [label=\"" << details::escape_dot_label(edge.str(), options.max_label_length)
+		   << "\"];\n";
+	}
+	os << "}\n";
+}
+
+} // namespace visualization
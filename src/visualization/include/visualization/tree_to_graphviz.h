@@ -64,23 +64,12 @@ add_search_node_to_graph(const search::SearchTreeNode<LocationT, ActionT> *searc
 		  fmt::format("({}, {})", incoming_action.first, incoming_action.second));
 	}
 
-	std::string label_reason;
-	switch (search_node->label_reason) {
-	case LabelReason::UNKNOWN: label_reason = "unknown"; break;
-	case LabelReason::BAD_NODE: label_reason = "bad node"; break;
-	case LabelReason::DEAD_NODE: label_reason = "dead node"; break;
-	case LabelReason::NO_ATA_SUCCESSOR: label_reason = "no ATA successor"; break;
-	case LabelReason::MONOTONIC_DOMINATION: label_reason = "monotonic domination"; break;
-	case LabelReason::NO_BAD_ENV_ACTION: label_reason = "no bad env action"; break;
-	case LabelReason::GOOD_CONTROLLER_ACTION_FIRST:
-		label_reason = "good controller action first";
-		break;
-	case LabelReason::BAD_ENV_ACTION_FIRST: label_reason = "bad env action first"; break;
-	}
+	std::stringstream label_reason;
+	label_reason << search_node->label_reason;
 	// Split the incoming actions into node sections.
 	// Put the incoming actions into their own group (with {}) to separate the from the words.
 	utilities::graphviz::Node node{graph->add_node(fmt::format("{{{}}}|{{{}}}|{}",
-	                                                           label_reason,
+	                                                           label_reason.str(),
 	                                                           fmt::join(incoming_action_labels, "|"),
 	                                                           fmt::join(words_labels, "|")))};
 	// Set the node color according to its label.
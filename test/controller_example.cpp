@@ -0,0 +1,78 @@
+/***************************************************************************
+ *  controller_example.cpp - A small control problem for controller export tests
+ *
+ *  Created:   Sun 18 Oct 16:48:19 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "controller_example.h"
+
+#include "automata/ta_minimization.h"
+#include "mtl/MTLFormula.h"
+#include "mtl_ata_translation/translator.h"
+#include "search/search.h"
+
+#include <stdexcept>
+
+using automata::AtomicClockConstraintT;
+using automata::Time;
+using Location   = automata::ta::Location<std::string>;
+using TA         = automata::ta::TimedAutomaton<std::string, std::string>;
+using Transition = automata::ta::Transition<std::string, std::string>;
+using F          = logic::MTLFormula<std::string>;
+using AP         = logic::AtomicProposition<std::string>;
+
+TA
+create_example_plant()
+{
+	const Location idle{"idle"};
+	const Location busy{"busy"};
+	const Location failed{"failed"};
+	return TA{{idle, busy, failed},
+	          {"start", "finish", "fail"},
+	          idle,
+	          {idle, busy, failed},
+	          {"x"},
+	          {Transition{idle, "start", busy, {}, {"x"}},
+	           Transition{busy,
+	                      "finish",
+	                      idle,
+	                      {{"x", AtomicClockConstraintT<std::greater_equal<Time>>(1)}},
+	                      {"x"}},
+	           Transition{
+	             idle, "fail", failed, {{"x", AtomicClockConstraintT<std::greater<Time>>(1)}}}}};
+}
+
+std::set<std::string>
+get_example_controller_actions()
+{
+	return {"start"};
+}
+
+automata::ta::TimedAutomaton<controller_synthesis::ControllerLocation, std::string>
+create_example_controller()
+{
+	const auto plant = create_example_plant();
+	auto       ata   = mtl_ata_translation::translate(logic::finally(F{AP{"fail"}}),
+	                                              {AP{"start"}, AP{"finish"}, AP{"fail"}});
+	search::TreeSearch<std::string, std::string> search{
+	  &plant, &ata, get_example_controller_actions(), {"finish", "fail"}, 1, true, false};
+	search.build_tree(false);
+	if (search.get_root()->label != search::NodeLabel::TOP) {
+		throw std::logic_error("The example plant cannot be controlled");
+	}
+	return automata::ta::minimize(
+	  controller_synthesis::create_compact_controller(search.get_root(), 1));
+}
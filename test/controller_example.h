@@ -0,0 +1,39 @@
+/***************************************************************************
+ *  controller_example.h - A small control problem for controller export tests
+ *
+ *  Created:   Sun 18 Oct 16:48:19 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#pragma once
+
+#include "automata/ta.h"
+#include "search/create_controller.h"
+
+#include <set>
+#include <string>
+
+/** Create a machine that fails if it stays idle for more than one time unit.
+ * The controller may start the machine, the environment finishes the job after at least one time
+ * unit. Both reset the clock x.
+ */
+automata::ta::TimedAutomaton<std::string, std::string> create_example_plant();
+
+/** The actions of the example plant that are controlled by the controller. */
+std::set<std::string> get_example_controller_actions();
+
+/** Synthesize a minimized controller for the example plant that avoids failures. */
+automata::ta::TimedAutomaton<controller_synthesis::ControllerLocation, std::string>
+create_example_controller();
@@ -0,0 +1,39 @@
+/***************************************************************************
+ *  generate_example_controller.cpp - Generate C++ code for the example controller
+ *
+ *  Created:   Sun 18 Oct 16:55:02 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "controller_example.h"
+#include "controller_synthesis/cpp_export.h"
+#include "controller_synthesis/decision_table.h"
+
+#include <fstream>
+#include <iostream>
+
+int
+main(int argc, char *argv[])
+{
+	if (argc != 2) {
+		std::cerr << "Usage: " << argv[0] << " <output header>\n";
+		return 1;
+	}
+	const auto table = controller_synthesis::create_decision_table(
+	  create_example_controller(), get_example_controller_actions(), 4);
+	std::ofstream fs(argv[1]);
+	controller_synthesis::export_to_cpp(table, fs, "example_controller");
+	return 0;
+}
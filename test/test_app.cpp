@@ -18,9 +18,17 @@
  */
 
 #include "app/app.h"
+#include "app/server.h"
+#include "automata/ta.pb.h"
+#include "mtl/mtl.pb.h"
+#include "search/tree_export.h"
+
+#include <fmt/format.h>
 
 #include <catch2/catch_test_macros.hpp>
 #include <filesystem>
+#include <fstream>
+#include <sstream>
 
 TEST_CASE("Launch the main application", "[app]")
 {
@@ -61,6 +69,377 @@ TEST_CASE("Launch the main application", "[app]")
 	std::filesystem::remove(tree_dot_graph);
 }
 
+TEST_CASE("Launch the main application with a deterministic monitor", "[app][monitor]")
+{
+	const std::filesystem::path test_data_dir = std::filesystem::current_path() / "data" / "simple";
+	const std::filesystem::path plant_path    = test_data_dir / "plant.pbtxt";
+	const std::filesystem::path spec_path     = test_data_dir / "spec.pbtxt";
+	const std::filesystem::path controller_proto_path = test_data_dir / "monitor_controller.pbtxt";
+	const std::filesystem::path controller_cpp_path   = test_data_dir / "monitor_controller.h";
+	constexpr const int         argc                  = 15;
+	const std::array<const char *, argc> argv{"app",
+	                                          "--plant",
+	                                          plant_path.c_str(),
+	                                          "--spec",
+	                                          spec_path.c_str(),
+	                                          "-c",
+	                                          "c",
+	                                          "--monitor",
+	                                          "-o",
+	                                          controller_proto_path.c_str(),
+	                                          "--minimize-controller",
+	                                          "--stream-controller",
+	                                          "--verify",
+	                                          "--output-cpp",
+	                                          controller_cpp_path.c_str()};
+	app::Launcher                        launcher{argc, argv.data()};
+	launcher.run();
+	CHECK(std::filesystem::exists(controller_proto_path));
+	std::filesystem::remove(controller_proto_path);
+	CHECK(std::filesystem::exists(controller_cpp_path));
+	std::filesystem::remove(controller_cpp_path);
+}
+
+TEST_CASE("Launch the main application with digital clocks", "[app][digital]")
+{
+	const std::filesystem::path test_data_dir = std::filesystem::current_path() / "data" / "simple";
+	const std::filesystem::path plant_path    = test_data_dir / "plant.pbtxt";
+	const std::filesystem::path spec_path     = test_data_dir / "spec.pbtxt";
+	const std::filesystem::path controller_proto_path = test_data_dir / "digital_controller.pbtxt";
+	constexpr const int         argc                  = 11;
+	// The plant has a strict guard, so the app falls back to regions and verifies the controller.
+	const std::array<const char *, argc> argv{"app",
+	                                          "--plant",
+	                                          plant_path.c_str(),
+	                                          "--spec",
+	                                          spec_path.c_str(),
+	                                          "-c",
+	                                          "c",
+	                                          "--digital-clocks",
+	                                          "--verify",
+	                                          "-o",
+	                                          controller_proto_path.c_str()};
+	app::Launcher                        launcher{argc, argv.data()};
+	launcher.run();
+	CHECK(launcher.get_engine() == app::Launcher::Engine::REGIONS);
+	CHECK(std::filesystem::exists(controller_proto_path));
+	std::filesystem::remove(controller_proto_path);
+
+	// With closed guards, the digital clock engine is used and its controller is verified in dense
+	// time.
+	const std::filesystem::path closed_plant_path = test_data_dir / "closed_plant.pbtxt";
+	auto                        closed_argv       = argv;
+	closed_argv[2]                                = closed_plant_path.c_str();
+	app::Launcher closed_launcher{argc, closed_argv.data()};
+	closed_launcher.run();
+	CHECK(closed_launcher.get_engine() == app::Launcher::Engine::DIGITAL_CLOCKS);
+	CHECK(std::filesystem::exists(controller_proto_path));
+	std::filesystem::remove(controller_proto_path);
+
+	// The environment may reset a clock at a fractional time, which the controller of the digital
+	// clock engine does not handle. Even without --verify, the dense time check detects this and the
+	// controller of the region engine is written instead.
+	const std::filesystem::path fallback_plant_path = test_data_dir / "digital_fallback_plant.pbtxt";
+	const std::array<const char *, argc - 1> fallback_argv{"app",
+	                                                       "--plant",
+	                                                       fallback_plant_path.c_str(),
+	                                                       "--spec",
+	                                                       spec_path.c_str(),
+	                                                       "-c",
+	                                                       "c",
+	                                                       "--digital-clocks",
+	                                                       "-o",
+	                                                       controller_proto_path.c_str()};
+	app::Launcher                           fallback_launcher{argc - 1, fallback_argv.data()};
+	fallback_launcher.run();
+	CHECK(fallback_launcher.get_engine() == app::Launcher::Engine::REGIONS);
+	CHECK(std::filesystem::exists(controller_proto_path));
+	std::filesystem::remove(controller_proto_path);
+}
+
+TEST_CASE("Launch the main application with a minimized and sliced plant", "[app]")
+{
+	const std::filesystem::path test_data_dir = std::filesystem::current_path() / "data" / "simple";
+	const std::filesystem::path plant_path    = test_data_dir / "plant.pbtxt";
+	const std::filesystem::path spec_path     = test_data_dir / "spec.pbtxt";
+	const std::filesystem::path controller_proto_path =
+	  test_data_dir / "minimized_plant_controller.pbtxt";
+	constexpr const int                  argc = 12;
+	const std::array<const char *, argc> argv{"app",
+	                                          "--plant",
+	                                          plant_path.c_str(),
+	                                          "--spec",
+	                                          spec_path.c_str(),
+	                                          "-c",
+	                                          "c",
+	                                          "--minimize-plant",
+	                                          "--slice-plant",
+	                                          "--verify",
+	                                          "-o",
+	                                          controller_proto_path.c_str()};
+	app::Launcher                        launcher{argc, argv.data()};
+	launcher.run();
+	CHECK(std::filesystem::exists(controller_proto_path));
+	std::filesystem::remove(controller_proto_path);
+}
+
+TEST_CASE("Launch the main application with normalized constants", "[app][normalization]")
+{
+	const std::filesystem::path test_data_dir = std::filesystem::current_path() / "data" / "simple";
+	const std::filesystem::path plant_path    = test_data_dir / "plant.pbtxt";
+	const std::filesystem::path spec_path     = test_data_dir / "spec.pbtxt";
+	const std::filesystem::path controller_proto_path =
+	  test_data_dir / "normalized_controller.pbtxt";
+	constexpr const int                  argc = 11;
+	const std::array<const char *, argc> argv{"app",
+	                                          "--plant",
+	                                          plant_path.c_str(),
+	                                          "--spec",
+	                                          spec_path.c_str(),
+	                                          "-c",
+	                                          "c",
+	                                          "--normalize-constants",
+	                                          "--verify",
+	                                          "-o",
+	                                          controller_proto_path.c_str()};
+	app::Launcher                        launcher{argc, argv.data()};
+	launcher.run();
+	CHECK(std::filesystem::exists(controller_proto_path));
+	std::filesystem::remove(controller_proto_path);
+}
+
+TEST_CASE("Reject constants that cannot be normalized", "[app][normalization]")
+{
+	const std::filesystem::path test_data_dir = std::filesystem::current_path() / "data" / "simple";
+	const std::filesystem::path plant_path    = test_data_dir / "plant.pbtxt";
+	const std::filesystem::path spec_path     = test_data_dir / "fractional_spec.pbtxt";
+	constexpr const int         argc          = 8;
+	const std::array<const char *, argc> argv{"app",
+	                                          "--plant",
+	                                          plant_path.c_str(),
+	                                          "--spec",
+	                                          spec_path.c_str(),
+	                                          "-c",
+	                                          "c",
+	                                          "--normalize-constants"};
+	// A normalized time unit is half an input time unit, so the controller could not be rescaled.
+	app::Launcher launcher{argc, argv.data()};
+	CHECK_THROWS_AS(launcher.run(), std::invalid_argument);
+}
+
+TEST_CASE("Launch the main application to analyze partitions", "[app][partitions]")
+{
+	const std::filesystem::path test_data_dir = std::filesystem::current_path() / "data" / "simple";
+	const std::filesystem::path plant_path    = test_data_dir / "plant.pbtxt";
+	const std::filesystem::path spec_path     = test_data_dir / "spec.pbtxt";
+	constexpr const int         argc          = 10;
+	const std::array<const char *, argc> argv{"app",
+	                                          "--plant",
+	                                          plant_path.c_str(),
+	                                          "--spec",
+	                                          spec_path.c_str(),
+	                                          "--controllable-partition",
+	                                          "c",
+	                                          "--controllable-partition",
+	                                          "c,e",
+	                                          "--find-minimal-controller-actions"};
+	app::Launcher                        launcher{argc, argv.data()};
+	CHECK_NOTHROW(launcher.run());
+}
+
+TEST_CASE("Launch the main application with binary protos", "[app][proto]")
+{
+	const std::filesystem::path test_data_dir = std::filesystem::current_path() / "data" / "simple";
+	const std::filesystem::path plant_path    = test_data_dir / "plant.pb";
+	const std::filesystem::path spec_path     = test_data_dir / "spec.pb";
+	const std::filesystem::path controller_proto_path = test_data_dir / "binary_controller.pbtxt";
+	automata::ta::proto::ProductAutomaton plant;
+	app::read_proto_from_file(test_data_dir / "plant.pbtxt", &plant);
+	app::write_proto_to_file(plant_path, plant);
+	logic::proto::MTLFormula spec;
+	app::read_proto_from_file(test_data_dir / "spec.pbtxt", &spec);
+	app::write_proto_to_file(spec_path, spec);
+	// The binary file cannot be parsed as text.
+	CHECK_THROWS_AS(app::read_proto_from_file(plant_path, &plant, app::ProtoFormat::TEXT),
+	                std::invalid_argument);
+	CHECK_NOTHROW(app::read_proto_from_file(plant_path, &plant));
+
+	constexpr const int                  argc = 9;
+	const std::array<const char *, argc> argv{"app",
+	                                          "--plant",
+	                                          plant_path.c_str(),
+	                                          "--spec",
+	                                          spec_path.c_str(),
+	                                          "-c",
+	                                          "c",
+	                                          "-o",
+	                                          controller_proto_path.c_str()};
+	app::Launcher                        launcher{argc, argv.data()};
+	launcher.run();
+	REQUIRE(std::filesystem::exists(controller_proto_path));
+	// The controller is written in the text format because of its extension.
+	automata::ta::proto::TimedAutomaton controller;
+	CHECK_NOTHROW(
+	  app::read_proto_from_file(controller_proto_path, &controller, app::ProtoFormat::TEXT));
+	CHECK(!controller.locations().empty());
+	std::filesystem::remove(controller_proto_path);
+	std::filesystem::remove(plant_path);
+	std::filesystem::remove(spec_path);
+}
+
+TEST_CASE("Launch the main application with a tree export", "[app][export]")
+{
+	const std::filesystem::path test_data_dir = std::filesystem::current_path() / "data" / "simple";
+	const std::filesystem::path plant_path    = test_data_dir / "plant.pbtxt";
+	const std::filesystem::path spec_path     = test_data_dir / "spec.pbtxt";
+	const std::filesystem::path tree_path     = test_data_dir / "tree.bin";
+	constexpr const int         argc          = 9;
+	const std::array<const char *, argc> argv{"app",
+	                                          "--plant",
+	                                          plant_path.c_str(),
+	                                          "--spec",
+	                                          spec_path.c_str(),
+	                                          "-c",
+	                                          "c",
+	                                          "--export-tree",
+	                                          tree_path.c_str()};
+	app::Launcher                        launcher{argc, argv.data()};
+	launcher.run();
+	REQUIRE(std::filesystem::exists(tree_path));
+	{
+		std::ifstream            fs(tree_path, std::ios::binary);
+		search::TreeExportReader reader{fs};
+		std::size_t              num_nodes = 0;
+		while (const auto record = reader.next()) {
+			num_nodes += std::holds_alternative<search::ExportedNode>(*record);
+		}
+		CHECK(num_nodes > 0);
+	}
+	std::filesystem::remove(tree_path);
+	// Streaming the controller frees parts of the tree, so it cannot be combined with the export.
+	const std::array<const char *, argc + 1> stream_argv{"app",
+	                                                     "--plant",
+	                                                     plant_path.c_str(),
+	                                                     "--spec",
+	                                                     spec_path.c_str(),
+	                                                     "-c",
+	                                                     "c",
+	                                                     "--export-tree",
+	                                                     tree_path.c_str(),
+	                                                     "--stream-controller"};
+	CHECK_THROWS_AS(app::Launcher(argc + 1, stream_argv.data()), std::invalid_argument);
+}
+
+TEST_CASE("Launch the main application with streamed dot graphs", "[app][dot]")
+{
+	const std::filesystem::path test_data_dir = std::filesystem::current_path() / "data" / "simple";
+	const std::filesystem::path plant_path    = test_data_dir / "plant.pbtxt";
+	const std::filesystem::path spec_path     = test_data_dir / "spec.pbtxt";
+	const std::filesystem::path plant_dot_path      = test_data_dir / "plant.dot";
+	const std::filesystem::path tree_dot_path       = test_data_dir / "tree.dot";
+	const std::filesystem::path controller_dot_path = test_data_dir / "controller.dot";
+	constexpr const int                  argc = 17;
+	const std::array<const char *, argc> argv{"app",
+	                                          "--plant",
+	                                          plant_path.c_str(),
+	                                          "--spec",
+	                                          spec_path.c_str(),
+	                                          "-c",
+	                                          "c",
+	                                          "--visualize-plant",
+	                                          plant_dot_path.c_str(),
+	                                          "--visualize-search-tree",
+	                                          tree_dot_path.c_str(),
+	                                          "--visualize-controller",
+	                                          controller_dot_path.c_str(),
+	                                          "--dot-max-depth",
+	                                          "2",
+	                                          "--dot-max-label-length",
+	                                          "40"};
+	app::Launcher                        launcher{argc, argv.data()};
+	launcher.run();
+	for (const auto &path : {plant_dot_path, tree_dot_path, controller_dot_path}) {
+		CAPTURE(path);
+		CHECK(std::filesystem::exists(path));
+		std::filesystem::remove(path);
+	}
+}
+
+TEST_CASE("Launch the main application with an artifact cache", "[app][cache]")
+{
+	const std::filesystem::path test_data_dir = std::filesystem::current_path() / "data" / "simple";
+	const std::filesystem::path plant_path    = test_data_dir / "plant.pbtxt";
+	const std::filesystem::path spec_path     = test_data_dir / "spec.pbtxt";
+	const std::filesystem::path cache_dir     = test_data_dir / "cache";
+	const std::filesystem::path controller_proto_path = test_data_dir / "cached_controller.pbtxt";
+	std::filesystem::remove_all(cache_dir);
+	constexpr const int                  argc = 12;
+	const std::array<const char *, argc> argv{"app",
+	                                          "--plant",
+	                                          plant_path.c_str(),
+	                                          "--spec",
+	                                          spec_path.c_str(),
+	                                          "-c",
+	                                          "c",
+	                                          "--cache-dir",
+	                                          cache_dir.c_str(),
+	                                          "--verify",
+	                                          "-o",
+	                                          controller_proto_path.c_str()};
+	// The first run fills the cache, the second run reads the plant and the ATA from it.
+	for (int i = 0; i < 2; ++i) {
+		CAPTURE(i);
+		app::Launcher launcher{argc, argv.data()};
+		launcher.run();
+		CHECK(std::filesystem::exists(controller_proto_path));
+		std::filesystem::remove(controller_proto_path);
+		const auto num_entries = std::distance(std::filesystem::directory_iterator(cache_dir),
+		                                       std::filesystem::directory_iterator{});
+		CHECK(num_entries == 1);
+	}
+	std::filesystem::remove_all(cache_dir);
+}
+
+TEST_CASE("Serve synthesis requests", "[app][server]")
+{
+	const std::filesystem::path test_data_dir = std::filesystem::current_path() / "data" / "simple";
+	const std::filesystem::path plant_path    = test_data_dir / "plant.pbtxt";
+	const std::filesystem::path spec_path     = test_data_dir / "spec.pbtxt";
+	const std::filesystem::path controller_proto_path = test_data_dir / "served_controller.pbtxt";
+	const auto request = fmt::format("--plant '{}' --spec '{}' -c c --verify -o '{}'",
+	                                 plant_path.c_str(),
+	                                 spec_path.c_str(),
+	                                 controller_proto_path.c_str());
+	std::stringstream input;
+	input << "# Synthesize the same controller twice\n"
+	      << request << "\n"
+	      << "\n"
+	      << "  " << request << "\n"
+	      << "--plant nonexistent.pbtxt --spec nonexistent.pbtxt\n"
+	      << "--help\n"
+	      << "--server\n"
+	      << "quit\n"
+	      << request << "\n";
+	std::stringstream output;
+	app::Server       server{input, output};
+	CHECK(server.run() == 5);
+	// Both valid requests use the same plant and specification, so they share the cache entry.
+	CHECK(server.get_memory_cache().size() == 1);
+	CHECK(std::filesystem::exists(controller_proto_path));
+	std::filesystem::remove(controller_proto_path);
+	std::vector<std::string> responses;
+	for (std::string line; std::getline(output, line);) {
+		responses.push_back(line);
+	}
+	REQUIRE(responses.size() == 5);
+	CHECK(responses[0].rfind("ok 1 ", 0) == 0);
+	CHECK(responses[1].rfind("ok 2 ", 0) == 0);
+	CHECK(responses[2].rfind("error 3 ", 0) == 0);
+	// Neither the help message nor a nested server may write to the output.
+	CHECK(responses[3].rfind("error 4 ", 0) == 0);
+	CHECK(responses[4].rfind("error 5 ", 0) == 0);
+}
+
 TEST_CASE("Running the app with invalid input", "[app]")
 {
 	{
@@ -69,6 +448,15 @@ TEST_CASE("Running the app with invalid input", "[app]")
 		// Showing the help should not throw.
 		CHECK_NOTHROW(app::Launcher{argc, argv}.run());
 	}
+	{
+		constexpr int     argc       = 2;
+		const char *const argv[argc] = {"app", "--server"};
+		// The server does not need a plant or a specification, but the launcher cannot run it.
+		app::Launcher launcher{argc, argv};
+		CHECK(launcher.is_server_requested());
+		CHECK(!launcher.is_help_requested());
+		CHECK_THROWS_AS(launcher.run(), std::invalid_argument);
+	}
 	{
 		const char *const argv[1] = {"app"};
 		CHECK_THROWS(app::Launcher{1, argv});
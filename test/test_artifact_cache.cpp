@@ -0,0 +1,189 @@
+/***************************************************************************
+ *  test_artifact_cache.cpp - Test the on-disk cache of the plant and the ATA
+ *
+ *  Created:   Mon 19 Oct 03:51:18 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "app/artifact_cache.h"
+#include "automata/ta_product.h"
+#include "mtl/MTLFormula.h"
+#include "mtl_ata_translation/translator.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+
+namespace {
+
+using TATransition = automata::ta::Transition<std::string, std::string>;
+using TA           = automata::ta::TimedAutomaton<std::string, std::string>;
+using AP           = logic::AtomicProposition<std::string>;
+using Location     = automata::ta::Location<std::string>;
+using automata::AtomicClockConstraintT;
+using utilities::arithmetic::BoundType;
+
+app::ProductAutomaton
+create_plant()
+{
+	TA ta1{{"a", "b"}, Location{"l0"}, {Location{"l1"}}};
+	ta1.add_clock("x");
+	ta1.add_transition(TATransition(Location{"l0"},
+	                                "a",
+	                                Location{"l0"},
+	                                {{"x", AtomicClockConstraintT<std::greater<automata::Time>>(1)}},
+	                                {"x"}));
+	ta1.add_transition(TATransition(Location{"l0"},
+	                                "b",
+	                                Location{"l1"},
+	                                {{"x", AtomicClockConstraintT<std::less<automata::Time>>(2)}}));
+	TA ta2{{"c"}, Location{"m0"}, {Location{"m0"}}};
+	ta2.add_clock("y");
+	ta2.add_transition(TATransition(Location{"m0"},
+	                                "c",
+	                                Location{"m0"},
+	                                {{"y", AtomicClockConstraintT<std::equal_to<automata::Time>>(3)}},
+	                                {"y"}));
+	return automata::ta::get_product<std::string, std::string>({ta1, ta2});
+}
+
+app::SpecificationATA
+create_ata()
+{
+	const logic::MTLFormula<std::string> a{AP("a")};
+	const logic::MTLFormula<std::string> b{AP("b")};
+	const logic::MTLFormula<std::string> c{AP("c")};
+	const logic::TimeInterval            bounded{1, BoundType::STRICT, 2, BoundType::WEAK};
+	const logic::TimeInterval            unbounded{2, BoundType::WEAK, 0, BoundType::INFTY};
+	const auto spec = a.until(b, bounded) || (!c).dual_until(a && b, unbounded);
+	return mtl_ata_translation::translate(spec, {AP{"a"}, AP{"b"}, AP{"c"}});
+}
+
+template <typename T>
+std::string
+to_string(const T &value)
+{
+	std::stringstream str;
+	str << value;
+	return str.str();
+}
+
+TEST_CASE("Hash data with FNV-1a", "[app][cache]")
+{
+	CHECK(app::fnv1a_hash("") == 0xcbf29ce484222325ULL);
+	CHECK(app::fnv1a_hash("a") == 0xaf63dc4c8601ec8cULL);
+	CHECK(app::fnv1a_hash("foobar") == 0x85944171f73967e8ULL);
+	CHECK(app::fnv1a_hash("bar", app::fnv1a_hash("foo")) == app::fnv1a_hash("foobar"));
+}
+
+TEST_CASE("Write and read a product automaton", "[app][cache]")
+{
+	const auto        plant = create_plant();
+	std::stringstream stream;
+	app::write_product_automaton(stream, plant);
+	const auto read_plant = app::read_product_automaton(stream);
+	CHECK(read_plant.get_locations() == plant.get_locations());
+	CHECK(read_plant.get_alphabet() == plant.get_alphabet());
+	CHECK(read_plant.get_initial_location() == plant.get_initial_location());
+	CHECK(read_plant.get_final_locations() == plant.get_final_locations());
+	CHECK(read_plant.get_clocks() == plant.get_clocks());
+	CHECK(read_plant.get_transitions() == plant.get_transitions());
+}
+
+TEST_CASE("Write and read a specification ATA", "[app][cache]")
+{
+	const auto        ata = create_ata();
+	std::stringstream stream;
+	app::write_specification_ata(stream, ata);
+	const auto read_ata = app::read_specification_ata(stream);
+	CHECK(to_string(read_ata) == to_string(ata));
+	CHECK(read_ata.get_sink_location() == ata.get_sink_location());
+	for (const automata::TimedWord &word : std::vector<automata::TimedWord>{
+	       {{"a", 0}, {"b", 1.5}}, {{"a", 0}, {"b", 0.5}}, {{"c", 0}, {"a", 1}, {"b", 3}}}) {
+		CHECK(read_ata.accepts_word(word) == ata.accepts_word(word));
+	}
+}
+
+TEST_CASE("Reject truncated cache data", "[app][cache]")
+{
+	std::stringstream stream;
+	app::write_specification_ata(stream, create_ata());
+	const auto        data = stream.str();
+	std::stringstream truncated{data.substr(0, data.size() / 2)};
+	CHECK_THROWS_AS(app::read_specification_ata(truncated), std::invalid_argument);
+	std::stringstream empty;
+	CHECK_THROWS_AS(app::read_product_automaton(empty), std::invalid_argument);
+}
+
+TEST_CASE("Reject oversized counts and lengths in cache data", "[app][cache]")
+{
+	// A varint of 2^63, far beyond the size of the data.
+	const std::string huge{"\x80\x80\x80\x80\x80\x80\x80\x80\x80\x01", 10};
+	// The number of symbols.
+	std::stringstream huge_count{huge};
+	CHECK_THROWS_AS(app::read_product_automaton(huge_count), std::invalid_argument);
+	// The length of the first symbol.
+	std::stringstream huge_length{"\x01" + huge};
+	CHECK_THROWS_AS(app::read_product_automaton(huge_length), std::invalid_argument);
+	std::stringstream huge_ata_length{"\x01" + huge};
+	CHECK_THROWS_AS(app::read_specification_ata(huge_ata_length), std::invalid_argument);
+	// The number of components of the only location, after the empty symbol and clock tables.
+	std::stringstream huge_components{std::string{"\x00\x00\x01", 3} + huge};
+	CHECK_THROWS_AS(app::read_product_automaton(huge_components), std::invalid_argument);
+}
+
+TEST_CASE("Store and load a cache entry", "[app][cache]")
+{
+	const auto cache_dir = std::filesystem::temp_directory_path() / "mtlsyn_test_artifact_cache";
+	std::filesystem::remove_all(cache_dir);
+	const app::ArtifactCache cache{cache_dir, "inputs"};
+	CHECK(cache.get_path().parent_path() == cache_dir);
+	std::ifstream missing;
+	CHECK(!cache.open(missing));
+
+	const auto plant = create_plant();
+	const auto ata   = create_ata();
+	cache.store(plant, ata);
+	CHECK(std::filesystem::exists(cache.get_path()));
+	std::ifstream is;
+	REQUIRE(cache.open(is));
+	CHECK(app::read_product_automaton(is).get_transitions() == plant.get_transitions());
+	CHECK(to_string(app::read_specification_ata(is)) == to_string(ata));
+	// Other inputs do not hit the entry.
+	const app::ArtifactCache other{cache_dir, "other inputs"};
+	std::ifstream            other_stream;
+	CHECK(!other.open(other_stream));
+	// Simulate a hash collision, the entry is not used because its inputs differ.
+	std::filesystem::copy_file(cache.get_path(), other.get_path());
+	CHECK(!other.open(other_stream));
+	std::filesystem::remove_all(cache_dir);
+}
+
+TEST_CASE("Get the inputs of a cache entry", "[app][cache]")
+{
+	const std::filesystem::path data_dir = std::filesystem::current_path() / "data" / "simple";
+	const auto                  plant    = data_dir / "plant.pbtxt";
+	const auto                  spec     = data_dir / "spec.pbtxt";
+	CHECK(!app::get_build_stamp().empty());
+	CHECK(app::get_build_stamp() == app::get_build_stamp());
+	const auto inputs = app::get_cache_inputs(plant, spec, "options");
+	CHECK(inputs == app::get_cache_inputs(plant, spec, "options"));
+	CHECK(inputs != app::get_cache_inputs(plant, spec, "other options"));
+	CHECK(inputs != app::get_cache_inputs(spec, plant, "options"));
+	CHECK(inputs.find(app::get_build_stamp()) != std::string::npos);
+	CHECK_THROWS_AS(app::get_cache_inputs(data_dir / "missing.pbtxt", spec, "options"),
+	                std::invalid_argument);
+}
+
+} // namespace
@@ -0,0 +1,157 @@
+/***************************************************************************
+ *  test_cegar.cpp - Test the synthesis with abstraction refinement
+ *
+ *  Created:   Sun 18 Oct 21:24:10 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "automata/ta.h"
+#include "controller_example.h"
+#include "mtl/MTLFormula.h"
+#include "mtl_ata_translation/translator.h"
+#include "search/cegar.h"
+#include "search/search.h"
+#include "search/verify_controller.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace {
+
+using TA         = automata::ta::TimedAutomaton<std::string, std::string>;
+using Transition = automata::ta::Transition<std::string, std::string>;
+using Location   = automata::ta::Location<std::string>;
+using F          = logic::MTLFormula<std::string>;
+using AP         = logic::AtomicProposition<std::string>;
+using automata::AtomicClockConstraintT;
+using automata::Time;
+using search::NodeLabel;
+
+TEST_CASE("Abstract a plant by relaxing the environment's guards", "[search][cegar]")
+{
+	TA ta{{Location{"l0"}, Location{"l1"}},
+	      {"a", "b"},
+	      Location{"l0"},
+	      {Location{"l1"}},
+	      {"x", "y", "z"},
+	      {Transition{Location{"l0"},
+	                  "a",
+	                  Location{"l1"},
+	                  {{"x", AtomicClockConstraintT<std::less<Time>>(1)},
+	                   {"y", AtomicClockConstraintT<std::greater<Time>>(2)}},
+	                  {"x", "y"}},
+	       Transition{Location{"l1"},
+	                  "b",
+	                  Location{"l0"},
+	                  {{"z", AtomicClockConstraintT<std::less<Time>>(3)}},
+	                  {"y"}}}};
+	// Only a is an environment action, so the guard on z is kept.
+	const auto abstract =
+	  controller_synthesis::details::abstract_plant(ta, {"x"}, std::set<std::string>{"a"});
+	CHECK(abstract.get_clocks() == std::set<std::string>{"x", "z"});
+	CHECK(abstract.get_locations() == ta.get_locations());
+	CHECK(abstract.get_final_locations() == ta.get_final_locations());
+	REQUIRE(abstract.get_transitions().size() == 2);
+	for (const auto &[source, transition] : abstract.get_transitions()) {
+		for (const auto &[clock, constraint] : transition.get_guards()) {
+			CHECK(clock == (transition.symbol_ == "a" ? "x" : "z"));
+		}
+		CHECK(transition.clock_resets_.count("y") == 0);
+	}
+	CHECK(controller_synthesis::details::get_guarded_clocks(ta, std::set<std::string>{"a"})
+	      == std::set<std::string>{"x", "y"});
+	CHECK(controller_synthesis::details::get_guarded_clocks(ta, std::set<std::string>{"b"})
+	      == std::set<std::string>{"z"});
+}
+
+TEST_CASE("Synthesize a controller with abstraction refinement", "[search][cegar]")
+{
+	const bool multi_threaded = GENERATE(false, true);
+
+	SECTION("The example plant does not need any clock")
+	{
+		auto plant = create_example_plant();
+		auto ata   = mtl_ata_translation::translate(logic::finally(F{AP{"fail"}}),
+		                                            {AP{"start"}, AP{"finish"}, AP{"fail"}});
+		const auto result = controller_synthesis::synthesize_with_cegar(
+		  plant, &ata, get_example_controller_actions(), {"finish", "fail"}, 1, {}, multi_threaded);
+		REQUIRE(result.label == NodeLabel::TOP);
+		REQUIRE(result.controller);
+		// The controller starts the machine before any time passes, so the first abstraction is
+		// sufficient.
+		CHECK(result.tracked_clocks == std::vector<std::set<std::string>>{{}});
+		CHECK(result.num_spurious_counter_strategies == 0);
+		CHECK(controller_synthesis::verify_controller(
+		        plant, ata, *result.controller, get_example_controller_actions(), {"finish", "fail"}, 1)
+		        .verified);
+	}
+
+	SECTION("Only the clocks of relaxed guards are tracked")
+	{
+		// The controller must repeatedly reset x with c before the environment can act with e, but it
+		// may only do so once x reaches 1. The clock y does not influence the game.
+		TA ta{{Location{"l0"}, Location{"l1"}},
+		      {"c", "e"},
+		      Location{"l0"},
+		      {Location{"l0"}, Location{"l1"}},
+		      {"x", "y"},
+		      {Transition{Location{"l0"},
+		                  "c",
+		                  Location{"l0"},
+		                  {{"x", AtomicClockConstraintT<std::greater_equal<Time>>(1)}},
+		                  {"x", "y"}},
+		       Transition{Location{"l0"},
+		                  "e",
+		                  Location{"l1"},
+		                  {{"x", AtomicClockConstraintT<std::greater<Time>>(1)}}},
+		       Transition{Location{"l1"}, "e", Location{"l1"}}}};
+		auto ata = mtl_ata_translation::translate(finally(F{AP{"e"}}), {AP{"c"}, AP{"e"}});
+		const auto result =
+		  controller_synthesis::synthesize_with_cegar(ta, &ata, {"c"}, {"e"}, 1, {}, multi_threaded);
+		REQUIRE(result.label == NodeLabel::TOP);
+		REQUIRE(result.controller);
+		// Without x, the environment may act with e at any time. The controller's guard on x is never
+		// relaxed and y does not occur in any guard, so it is dropped in every abstraction.
+		CHECK(result.tracked_clocks == std::vector<std::set<std::string>>{{}, {"x"}});
+		CHECK(result.num_spurious_counter_strategies == 1);
+		CHECK(controller_synthesis::verify_controller(ta, ata, *result.controller, {"c"}, {"e"}, 1)
+		        .verified);
+		search::TreeSearch<std::string, std::string> search{&ta, &ata, {"c"}, {"e"}, 1, true, true};
+		search.build_tree(false);
+		CHECK(search.get_root()->label == NodeLabel::TOP);
+	}
+}
+
+TEST_CASE("Detect a losing game with abstraction refinement", "[search][cegar]")
+{
+	TA ta{{"e", "c"}, Location{"l0"}, {Location{"l0"}, Location{"l1"}}};
+	ta.add_clock("x");
+	ta.add_transition(Transition(Location{"l0"}, "e", Location{"l0"}));
+	ta.add_transition(Transition(Location{"l1"}, "c", Location{"l1"}));
+	ta.add_transition(Transition(Location{"l0"},
+	                             "c",
+	                             Location{"l1"},
+	                             {{"x", AtomicClockConstraintT<std::greater<Time>>(1)}}));
+	auto ata = mtl_ata_translation::translate(F::TRUE().until(F{AP{"e"}}), {AP{"e"}, AP{"c"}});
+	const auto result =
+	  controller_synthesis::synthesize_with_cegar(ta, &ata, {"c"}, {"e"}, 2, {}, false);
+	CHECK(result.label == NodeLabel::BOTTOM);
+	CHECK(!result.controller);
+	// The environment's action is unguarded, so the first abstraction is already concrete.
+	CHECK(result.tracked_clocks == std::vector<std::set<std::string>>{{}});
+	CHECK(result.num_spurious_counter_strategies == 0);
+}
+
+} // namespace
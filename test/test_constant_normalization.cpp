@@ -0,0 +1,137 @@
+/***************************************************************************
+ *  test_constant_normalization.cpp - Test rescaling the constants of a synthesis problem
+ *
+ *  Created:   Mon 19 Oct 00:31:12 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "automata/automata.h"
+#include "automata/ta.h"
+#include "mtl/MTLFormula.h"
+#include "search/constant_normalization.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+using TA         = automata::ta::TimedAutomaton<std::string, std::string>;
+using Transition = automata::ta::Transition<std::string, std::string>;
+using Location   = automata::ta::Location<std::string>;
+using Formula    = logic::MTLFormula<std::string>;
+using AP         = logic::AtomicProposition<std::string>;
+using automata::AtomicClockConstraintT;
+using automata::Time;
+using utilities::arithmetic::BoundType;
+
+TA
+create_plant(automata::Endpoint lower, automata::Endpoint upper)
+{
+	TA ta{{"a", "b"}, Location{"l0"}, {Location{"l1"}}};
+	ta.add_clock("x");
+	ta.add_transition(Transition{Location{"l0"},
+	                             "a",
+	                             Location{"l1"},
+	                             {{"x", AtomicClockConstraintT<std::greater<Time>>(lower)}},
+	                             {"x"}});
+	ta.add_transition(Transition{Location{"l1"},
+	                             "b",
+	                             Location{"l0"},
+	                             {{"x", AtomicClockConstraintT<std::less_equal<Time>>(upper)}}});
+	return ta;
+}
+
+std::multiset<automata::Endpoint>
+get_comparands(const TA &ta)
+{
+	std::multiset<automata::Endpoint> res;
+	for (const auto &[source, transition] : ta.get_transitions()) {
+		for (const auto &[clock, constraint] : transition.get_guards()) {
+			res.insert(std::visit([](const auto &atomic) { return atomic.get_comparand(); }, constraint));
+		}
+	}
+	return res;
+}
+
+TEST_CASE("Normalize the constants of a plant and a specification", "[search][normalization]")
+{
+	const Formula a{AP{"a"}};
+	const Formula b{AP{"b"}};
+	const auto    plant = create_plant(5, 10);
+	const auto    spec  = a.until(b, logic::TimeInterval{0, BoundType::WEAK, 15, BoundType::STRICT});
+
+	const auto normalization = search::get_constant_normalization(plant, spec);
+	CHECK(normalization.multiplier == 1);
+	CHECK(normalization.divisor == 5);
+
+	const auto normalized_plant = search::normalize(plant, normalization);
+	CHECK(get_comparands(normalized_plant) == std::multiset<automata::Endpoint>{1, 2});
+	CHECK(normalized_plant.get_locations() == plant.get_locations());
+	CHECK(normalized_plant.get_clocks() == plant.get_clocks());
+	CHECK(search::normalize(spec, normalization)
+	      == a.until(b, logic::TimeInterval{0, BoundType::WEAK, 3, BoundType::STRICT}));
+
+	CHECK(search::has_integral_time_unit(normalization));
+	CHECK(get_comparands(search::denormalize(normalized_plant, normalization))
+	      == get_comparands(plant));
+}
+
+TEST_CASE("Normalize fractional interval bounds", "[search][normalization]")
+{
+	const Formula a{AP{"a"}};
+	const Formula b{AP{"b"}};
+	const auto    plant = create_plant(1, 2);
+	const auto    spec  = a.until(b, logic::TimeInterval{0.5, BoundType::WEAK, 2, BoundType::WEAK});
+
+	const auto normalization = search::get_constant_normalization(plant, spec);
+	CHECK(normalization.multiplier == 2);
+	CHECK(normalization.divisor == 1);
+	CHECK(get_comparands(search::normalize(plant, normalization))
+	      == std::multiset<automata::Endpoint>{2, 4});
+	CHECK(search::normalize(spec, normalization)
+	      == a.until(b, logic::TimeInterval{1, BoundType::WEAK, 4, BoundType::WEAK}));
+
+	// One time unit of the normalized problem is half a time unit of the original problem.
+	CHECK(!search::has_integral_time_unit(normalization));
+	CHECK_THROWS_AS(search::denormalize(search::normalize(plant, normalization), normalization),
+	                std::invalid_argument);
+}
+
+TEST_CASE("Reject normalizations that overflow", "[search][normalization]")
+{
+	CHECK(search::details::checked_lcm(6, 4) == 12);
+	CHECK(search::details::checked_lcm(1, 7) == 7);
+	CHECK_THROWS_AS(search::details::checked_lcm(4294967291U, 2), std::overflow_error);
+
+	const Formula a{AP{"a"}};
+	const Formula b{AP{"b"}};
+	// The plant's constant does not fit into an endpoint after multiplying it with 2.
+	const auto plant = create_plant(4000000000U, 1);
+	const auto spec  = a.until(b, logic::TimeInterval{0.5, BoundType::WEAK, 2, BoundType::WEAK});
+	CHECK_THROWS_AS(search::get_constant_normalization(plant, spec), std::overflow_error);
+}
+
+TEST_CASE("Normalize a problem without constants", "[search][normalization]")
+{
+	TA ta{{"a"}, Location{"l0"}, {Location{"l0"}}};
+	ta.add_transition(Transition{Location{"l0"}, "a", Location{"l0"}});
+	const Formula spec{AP{"a"}};
+	const auto    normalization = search::get_constant_normalization(ta, spec);
+	CHECK(normalization.multiplier == 1);
+	CHECK(normalization.divisor == 1);
+	CHECK(search::normalize(spec, normalization) == spec);
+	CHECK_THROWS_AS(search::details::get_denominator(0.1234567), std::invalid_argument);
+}
+
+} // namespace
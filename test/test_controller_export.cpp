@@ -0,0 +1,274 @@
+/***************************************************************************
+ *  test_controller_export.cpp - Test decision tables and generated controllers
+ *
+ *  Created:   Sun 18 Oct 17:02:51 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "automata/automata.h"
+#include "automata/ta.h"
+#include "controller_example.h"
+#include "controller_synthesis/cpp_export.h"
+#include "controller_synthesis/decision_table.h"
+// Generated from the example controller during the build.
+#include "example_controller.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <sstream>
+
+namespace {
+
+using TA         = automata::ta::TimedAutomaton<std::string, std::string>;
+using Transition = automata::ta::Transition<std::string, std::string>;
+using Location   = automata::ta::Location<std::string>;
+using automata::AtomicClockConstraintT;
+using automata::Time;
+using controller_synthesis::Tick;
+using controller_synthesis::unbounded_tick;
+
+TEST_CASE("Create a decision table from a controller", "[controller][codegen]")
+{
+	TA ta{{Location{"l0"}, Location{"l1"}},
+	      {"c", "e"},
+	      Location{"l0"},
+	      {},
+	      {"x", "y"},
+	      {Transition{Location{"l0"},
+	                  "c",
+	                  Location{"l1"},
+	                  {{"x", AtomicClockConstraintT<std::less<Time>>(1)}}},
+	       Transition{Location{"l0"},
+	                  "c",
+	                  Location{"l0"},
+	                  {{"x", AtomicClockConstraintT<std::greater_equal<Time>>(1)},
+	                   {"y", AtomicClockConstraintT<std::equal_to<Time>>(2)}},
+	                  {"x"}},
+	       Transition{Location{"l0"},
+	                  "e",
+	                  Location{"l1"},
+	                  {{"y", AtomicClockConstraintT<std::greater<Time>>(1)}}},
+	       Transition{Location{"l1"},
+	                  "c",
+	                  Location{"l0"},
+	                  {{"x", AtomicClockConstraintT<std::greater<Time>>(1)},
+	                   {"x", AtomicClockConstraintT<std::less<Time>>(1)}}}}};
+	const auto table = controller_synthesis::create_decision_table(ta, {"c"}, 2);
+	CHECK(table.locations == std::vector<std::string>{"l0", "l1"});
+	CHECK(table.actions == std::vector<std::string>{"c", "e"});
+	CHECK(table.controller_actions == std::vector<bool>{true, false});
+	CHECK(table.clocks == std::vector<std::string>{"x", "y"});
+	CHECK(table.initial_location == 0);
+	// The unsatisfiable transition of l1 is dropped.
+	CHECK(table.location_offsets == std::vector<std::uint32_t>{0, 3, 3});
+	CHECK(table.controller_row_ends == std::vector<std::uint32_t>{2, 3});
+	// The rows of l0 have three different lower bounds on y, but only two on x.
+	CHECK(table.primary_clocks[0] == 1);
+	CHECK(table.lower_bounds == std::vector<Tick>{0, 0, 2, 4, 0, 3});
+	CHECK(table.upper_bounds
+	      == std::vector<Tick>{1, unbounded_tick, unbounded_tick, 4, unbounded_tick, unbounded_tick});
+	CHECK(table.row_actions == std::vector<controller_synthesis::ActionId>{0, 0, 1});
+	CHECK(table.row_targets == std::vector<controller_synthesis::LocationId>{1, 0, 1});
+	CHECK(table.row_resets == std::vector<std::uint64_t>{0, 1, 0});
+	// The first row does not bound the primary clock y.
+	CHECK(table.primary_upper_maxima
+	      == std::vector<Tick>{unbounded_tick, unbounded_tick, unbounded_tick});
+
+	CHECK(controller_synthesis::find_controller_row(table, 0, {0, 0}) == 0);
+	CHECK(controller_synthesis::find_controller_row(table, 0, {1, 4}) == 0);
+	CHECK(controller_synthesis::find_controller_row(table, 0, {3, 4}) == 1);
+	CHECK(controller_synthesis::find_controller_row(table, 0, {3, 5}) == std::nullopt);
+	CHECK(controller_synthesis::find_controller_row(table, 1, {0, 0}) == std::nullopt);
+	CHECK(controller_synthesis::find_row(table, 0, 1, {0, 3}) == 2);
+	CHECK(controller_synthesis::find_row(table, 0, 1, {0, 2}) == std::nullopt);
+	CHECK(controller_synthesis::find_row(table, 0, 0, {3, 4}) == 1);
+	CHECK_THROWS_AS(controller_synthesis::find_controller_row(table, 0, {0}),
+	                std::invalid_argument);
+	CHECK_THROWS_AS(controller_synthesis::create_decision_table(ta, {"c"}, 0),
+	                std::invalid_argument);
+
+	std::stringstream code;
+	controller_synthesis::export_to_cpp(table, code, "test_controller");
+	CHECK(code.str().find("namespace test_controller {") != std::string::npos);
+	CHECK(code.str().find("enum class Action : std::uint32_t {\n\tc,\n\te,\n};")
+	      != std::string::npos);
+	CHECK(code.str().find("Row{{{2, 4}}, {{unbounded, 4}}, Action::c, Location::L0, 0x1}")
+	      != std::string::npos);
+}
+
+TEST_CASE("Find rows with many overlapping guards", "[controller][codegen]")
+{
+	// All guards x < i have the lower bound 0, so the binary search does not skip any row.
+	constexpr int           num_rows = 100;
+	std::vector<Transition> transitions;
+	for (int i = 1; i <= num_rows; ++i) {
+		transitions.push_back(Transition{
+		  Location{"l0"}, "c", Location{"l0"}, {{"x", AtomicClockConstraintT<std::less<Time>>(i)}}});
+	}
+	const TA   ta{{Location{"l0"}}, {"c"}, Location{"l0"}, {}, {"x"}, transitions};
+	const auto table = controller_synthesis::create_decision_table(ta, {"c"}, 2);
+	REQUIRE(table.get_num_rows() == num_rows);
+	for (std::size_t row = 0; row < num_rows; ++row) {
+		// The guard x < row + 1 allows up to 2 * row + 1 ticks.
+		CHECK(table.primary_upper_maxima[row] == 2 * row + 1);
+	}
+	CHECK(controller_synthesis::find_controller_row(table, 0, {0}) == num_rows - 1);
+	CHECK(controller_synthesis::find_controller_row(table, 0, {2 * num_rows - 1}) == num_rows - 1);
+	// The running maximum of the last row is below the clock value, so the scan stops at once.
+	CHECK(controller_synthesis::find_controller_row(table, 0, {2 * num_rows}) == std::nullopt);
+
+	std::stringstream code;
+	controller_synthesis::export_to_cpp(table, code, "test_controller");
+	CHECK(code.str().find("primary_upper_maxima{{1, 3, 5,") != std::string::npos);
+}
+
+TEST_CASE("Name the actions of a generated controller", "[controller][codegen]")
+{
+	// Sorted by their names, the actions get the IDs 0, 1, and 2. The controller does not need any
+	// clock.
+	TA ta{{Location{"l0"}},
+	      {"A1", "a b", "class"},
+	      Location{"l0"},
+	      {},
+	      {},
+	      {Transition{Location{"l0"}, "A1", Location{"l0"}},
+	       Transition{Location{"l0"}, "a b", Location{"l0"}},
+	       Transition{Location{"l0"}, "class", Location{"l0"}}}};
+	const auto table = controller_synthesis::create_decision_table(ta, {"A1", "a b", "class"}, 2);
+	REQUIRE(table.actions == std::vector<std::string>{"A1", "a b", "class"});
+	std::stringstream code;
+	controller_synthesis::export_to_cpp(table, code, "test_controller");
+	// Neither "a b" nor "class" is an identifier. If "A1" was kept, it would collide with the
+	// fallback of "a b".
+	CHECK(code.str().find("enum class Action : std::uint32_t {\n\tA0,\n\tA1,\n\tA2,\n};")
+	      != std::string::npos);
+	CHECK(code.str().find("\"a b\"") != std::string::npos);
+}
+
+TEST_CASE("Replay the generated controller against the plant", "[controller][codegen]")
+{
+	namespace generated = example_controller;
+	const auto plant      = create_example_plant();
+	const auto controller = create_example_controller();
+	const auto table      = controller_synthesis::create_decision_table(
+    controller, get_example_controller_actions(), generated::ticks_per_time_unit);
+	REQUIRE(generated::rows.size() == table.get_num_rows());
+	REQUIRE(generated::location_names.size() == controller.get_locations().size());
+	REQUIRE(generated::num_clocks == plant.get_clocks().size());
+	const std::vector<automata::ta::Location<controller_synthesis::ControllerLocation>>
+	  controller_locations(std::begin(controller.get_locations()),
+	                       std::end(controller.get_locations()));
+	const std::vector<std::string> clocks(std::begin(plant.get_clocks()),
+	                                      std::end(plant.get_clocks()));
+	const auto get_valuation = [&clocks](const std::array<Tick, generated::num_clocks> &ticks) {
+		automata::ClockSetValuation valuation;
+		for (std::size_t clock = 0; clock < clocks.size(); ++clock) {
+			valuation.emplace(clocks[clock],
+			                  static_cast<Time>(ticks[clock]) / generated::ticks_per_time_unit);
+		}
+		return valuation;
+	};
+
+	std::mt19937 rng{42};
+	for (int run = 0; run < 100; ++run) {
+		auto                                   plant_location      = plant.get_initial_location();
+		auto                                   controller_location = generated::initial_location;
+		std::array<Tick, generated::num_clocks> ticks{};
+		for (int step = 0; step < 30; ++step) {
+			const auto index       = static_cast<std::uint32_t>(controller_location);
+			const auto valuation   = get_valuation(ticks);
+			const auto ta_location = controller_locations[index];
+			CAPTURE(run, step, ta_location, ticks);
+			REQUIRE(plant_location != Location{"failed"});
+			if (generated::location_offsets[index] == generated::location_offsets[index + 1]) {
+				// A leaf of the search tree, which repeats a situation that has been visited before.
+				break;
+			}
+			// The generated code agrees with the decision table ...
+			const auto *row = generated::next_transition(controller_location, ticks);
+			const auto  expected_row = controller_synthesis::find_controller_row(
+			  table, index, {std::begin(ticks), std::end(ticks)});
+			REQUIRE((row != nullptr) == expected_row.has_value());
+			if (row != nullptr) {
+				CHECK(static_cast<std::size_t>(row - generated::rows.data()) == *expected_row);
+			}
+			// ... and with the controller TA.
+			const auto [first, last] = controller.get_transitions().equal_range(ta_location);
+			CHECK((row != nullptr) == std::any_of(first, last, [&valuation](const auto &transition) {
+				      return transition.second.symbol_ == "start"
+				             && transition.second.is_enabled("start", valuation);
+			      }));
+			std::vector<Transition> plant_transitions;
+			for (const auto &[source, transition] : plant.get_transitions()) {
+				if (source == plant_location
+				    && transition.is_enabled(transition.symbol_, get_valuation(ticks))) {
+					plant_transitions.push_back(transition);
+				}
+			}
+			std::vector<Transition> environment_transitions;
+			std::copy_if(std::begin(plant_transitions),
+			             std::end(plant_transitions),
+			             std::back_inserter(environment_transitions),
+			             [](const auto &transition) { return transition.symbol_ != "start"; });
+			// The controller acts as soon as possible, unless the environment is faster.
+			std::optional<Transition> taken;
+			if (!environment_transitions.empty() && rng() % 3 == 0) {
+				taken = environment_transitions[rng() % environment_transitions.size()];
+			} else if (row != nullptr) {
+				const std::string action =
+				  generated::action_names[static_cast<std::uint32_t>(row->action)];
+				for (const auto &transition : plant_transitions) {
+					if (transition.symbol_ == action) {
+						taken = transition;
+					}
+				}
+				// The controller only selects actions that the plant allows.
+				REQUIRE(taken);
+			}
+			if (!taken) {
+				const Tick delay = 1 + rng() % generated::ticks_per_time_unit;
+				for (auto &tick : ticks) {
+					tick += delay;
+				}
+				continue;
+			}
+			const auto action = std::distance(
+			  std::begin(generated::action_names),
+			  std::find_if(std::begin(generated::action_names),
+			               std::end(generated::action_names),
+			               [&taken](const char *name) { return taken->symbol_ == name; }));
+			const auto *successor =
+			  generated::get_transition(controller_location, generated::Action(action), ticks);
+			// The controller knows how to continue after each action.
+			REQUIRE(successor != nullptr);
+			CHECK(std::any_of(first, last, [&](const auto &transition) {
+				return transition.second.symbol_ == taken->symbol_
+				       && transition.second.target_
+				            == controller_locations[static_cast<std::uint32_t>(successor->target)]
+				       && transition.second.is_enabled(taken->symbol_, valuation);
+			}));
+			plant_location      = taken->target_;
+			controller_location = successor->target;
+			// The guards of the controller refer to the clocks of the plant.
+			for (std::size_t clock = 0; clock < clocks.size(); ++clock) {
+				if (taken->clock_resets_.count(clocks[clock]) > 0) {
+					ticks[clock] = 0;
+				}
+			}
+		}
+	}
+}
+
+} // namespace
@@ -0,0 +1,161 @@
+/***************************************************************************
+ *  test_controller_runtime.cpp - Test the controller runtime
+ *
+ *  Created:   Sun 18 Oct 19:05:40 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "automata/automata.h"
+#include "automata/ta.h"
+#include "automata/ta_proto.h"
+#include "controller_example.h"
+#include "controller_synthesis/decision_table.h"
+#include "controller_synthesis/runtime.h"
+#include "controller_synthesis/runtime_proto.h"
+
+#include <google/protobuf/text_format.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+using TA         = automata::ta::TimedAutomaton<std::string, std::string>;
+using Transition = automata::ta::Transition<std::string, std::string>;
+using Location   = automata::ta::Location<std::string>;
+using automata::AtomicClockConstraintT;
+using automata::Time;
+using controller_synthesis::ControllerRuntime;
+using controller_synthesis::unbounded_tick;
+
+TEST_CASE("Execute a controller with the runtime", "[controller][runtime]")
+{
+	TA ta{{Location{"l0"}, Location{"l1"}},
+	      {"c", "e"},
+	      Location{"l0"},
+	      {},
+	      {"x", "y"},
+	      {Transition{Location{"l0"},
+	                  "c",
+	                  Location{"l1"},
+	                  {{"x", AtomicClockConstraintT<std::less<Time>>(1)},
+	                   {"y", AtomicClockConstraintT<std::less_equal<Time>>(2)}}},
+	       Transition{Location{"l0"},
+	                  "e",
+	                  Location{"l0"},
+	                  {{"y", AtomicClockConstraintT<std::greater<Time>>(1)}},
+	                  {"y"}},
+	       Transition{Location{"l1"}, "e", Location{"l0"}}}};
+	ControllerRuntime runtime{controller_synthesis::create_decision_table(ta, {"c"}, 4)};
+	const auto        c = runtime.get_action_id("c").value();
+	const auto        e = runtime.get_action_id("e").value();
+	CHECK(!runtime.get_action_id("f"));
+	CHECK(runtime.get_clock_mask({"x", "y"}) == 0b11);
+	CHECK_THROWS_AS(runtime.get_clock_mask({"z"}), std::invalid_argument);
+
+	// x < 1 is satisfied until tick 3.
+	auto decision = runtime.get_allowed_action(1);
+	REQUIRE(decision);
+	CHECK(decision->action == c);
+	CHECK(decision->until == 3);
+	CHECK(!runtime.get_allowed_action(4));
+	// The environment resets y at time 1.25, the plant resets x.
+	CHECK(!runtime.handle_event(e, 4));
+	CHECK(runtime.handle_event(e, 5, runtime.get_clock_mask({"x"})));
+	CHECK(runtime.get_location() == 0);
+	// Now, x = 0.25 and y = 0, so x < 1 is the tighter bound.
+	decision = runtime.get_allowed_action(6);
+	REQUIRE(decision);
+	CHECK(decision->until == 8);
+	CHECK(runtime.handle_event(c, 7));
+	CHECK(runtime.get_location() == 1);
+	CHECK(!runtime.get_allowed_action(7));
+	CHECK_THROWS_AS(runtime.get_allowed_action(6), std::invalid_argument);
+	runtime.reset(10);
+	CHECK(runtime.get_location() == 0);
+	CHECK(runtime.get_allowed_action(10)->until == 13);
+}
+
+TEST_CASE("Load a controller proto into the runtime", "[controller][runtime]")
+{
+	const auto controller = create_example_controller();
+	const auto proto      = automata::ta::ta_to_proto(controller);
+	for (const bool binary : {true, false}) {
+		// The format is determined from the extension.
+		const auto path = std::filesystem::temp_directory_path()
+		                  / (binary ? "runtime_controller.pb" : "runtime_controller.pbtxt");
+		{
+			std::ofstream fs(path);
+			if (binary) {
+				fs << proto.SerializeAsString();
+			} else {
+				std::string text;
+				google::protobuf::TextFormat::PrintToString(proto, &text);
+				fs << text;
+			}
+		}
+		auto runtime =
+		  controller_synthesis::load_controller_runtime(path, get_example_controller_actions(), 4);
+		CHECK(runtime.get_table().locations.size() == controller.get_locations().size());
+		const auto start  = runtime.get_action_id("start").value();
+		const auto finish = runtime.get_action_id("finish").value();
+		const auto x      = runtime.get_clock_mask({"x"});
+		auto       decision = runtime.get_allowed_action(0);
+		REQUIRE(decision);
+		CHECK(decision->action == start);
+		CHECK(decision->until == unbounded_tick);
+		CHECK(runtime.handle_event(start, 0, x));
+		CHECK(!runtime.get_allowed_action(2));
+		CHECK(!runtime.handle_event(finish, 3, x));
+		CHECK(runtime.handle_event(finish, 4, x));
+		decision = runtime.get_allowed_action(4);
+		REQUIRE(decision);
+		CHECK(decision->action == start);
+		// The file is not parsed in the other format.
+		CHECK_THROWS_AS(
+		  controller_synthesis::load_controller_runtime(path,
+		                                                get_example_controller_actions(),
+		                                                4,
+		                                                binary ? utilities::ProtoFormat::TEXT
+		                                                       : utilities::ProtoFormat::BINARY),
+		  std::invalid_argument);
+		std::filesystem::remove(path);
+		CHECK_THROWS_AS(controller_synthesis::load_controller_runtime(path, {}),
+		                std::invalid_argument);
+	}
+}
+
+TEST_CASE("Controller runtime benchmark", "[.benchmark][controller][runtime]")
+{
+	ControllerRuntime runtime{controller_synthesis::create_decision_table(
+	  create_example_controller(), get_example_controller_actions(), 1000)};
+	const auto start  = runtime.get_action_id("start").value();
+	const auto finish = runtime.get_action_id("finish").value();
+	const auto x      = runtime.get_clock_mask({"x"});
+	BENCHMARK("Query the allowed action")
+	{
+		return runtime.get_allowed_action(0);
+	};
+	BENCHMARK("Run a start/finish cycle")
+	{
+		runtime.reset(0);
+		runtime.handle_event(start, 0, x);
+		return runtime.handle_event(finish, 1000, x);
+	};
+}
+
+} // namespace
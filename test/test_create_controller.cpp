@@ -19,15 +19,18 @@
 
 #include "automata/automata.h"
 #include "automata/ta.h"
+#include "automata/ta_minimization.h"
 #include "automata/ta_product.h"
 #include "automata/ta_regions.h"
 #include "mtl/MTLFormula.h"
 #include "mtl_ata_translation/translator.h"
 #include "railroad.h"
 #include "search/canonical_word.h"
+#include "search/controller_stream.h"
 #include "search/create_controller.h"
 #include "search/search.h"
 #include "search/search_tree.h"
+#include "search/verify_controller.h"
 
 #include <spdlog/fmt/ostr.h>
 #include <spdlog/spdlog.h>
@@ -85,6 +88,81 @@ TEST_CASE("Create a simple controller", "[controller]")
 	CHECK(search.get_root()->label == search::NodeLabel::TOP);
 }
 
+TEST_CASE("Create a compact controller with integer locations", "[controller]")
+{
+	TA ta{{Location{"l0"}},
+	      {"c", "e"},
+	      Location{"l0"},
+	      {Location{"l0"}},
+	      {"cc", "ce"},
+	      {Transition{Location{"l0"}, "c", Location{"l0"}, {}, {"cc"}},
+	       Transition{Location{"l0"},
+	                  "e",
+	                  Location{"l0"},
+	                  {{"ce", automata::AtomicClockConstraintT<std::greater<automata::Time>>{1}}},
+	                  {"ce"}}}};
+	auto ata = mtl_ata_translation::translate(finally(F{AP{"e"}}), {AP{"c"}, AP{"e"}});
+	search::TreeSearch<std::string, std::string> search(&ta, &ata, {"c"}, {"e"}, 1, true, false);
+	search.build_tree(false);
+	REQUIRE(search.get_root()->label == search::NodeLabel::TOP);
+	const auto controller = create_controller(search.get_root(), 1);
+	std::map<controller_synthesis::ControllerLocation,
+	         std::set<search::CanonicalABWord<std::string, std::string>>>
+	  location_words;
+	const auto compact_controller =
+	  controller_synthesis::create_compact_controller(search.get_root(), 1, &location_words);
+	CAPTURE(compact_controller);
+	CHECK(compact_controller.get_initial_location()
+	      == automata::ta::Location<controller_synthesis::ControllerLocation>{0});
+	CHECK(location_words.at(0) == search.get_root()->words);
+	CHECK(location_words.size() == compact_controller.get_locations().size());
+	CHECK(compact_controller.get_locations().size() == controller.get_locations().size());
+	CHECK(compact_controller.get_final_locations().size()
+	      == controller.get_final_locations().size());
+	CHECK(compact_controller.get_alphabet() == controller.get_alphabet());
+	CHECK(compact_controller.get_clocks() == controller.get_clocks());
+	// Each transition of the compact controller corresponds to a transition of the controller.
+	REQUIRE(compact_controller.get_transitions().size() == controller.get_transitions().size());
+	for (const auto &[source, transition] : compact_controller.get_transitions()) {
+		using WordLocation =
+		  automata::ta::Location<std::set<search::CanonicalABWord<std::string, std::string>>>;
+		const automata::ta::Transition<std::set<search::CanonicalABWord<std::string, std::string>>,
+		                               std::string>
+		  expected{WordLocation{location_words.at(source.get())},
+		           transition.symbol_,
+		           WordLocation{location_words.at(transition.target_.get())},
+		           transition.get_guards(),
+		           transition.clock_resets_};
+		const auto range = controller.get_transitions().equal_range(expected.source_);
+		CHECK(std::any_of(range.first, range.second, [&expected](const auto &entry) {
+			return entry.second == expected;
+		}));
+	}
+	// Without a side table, the controller is the same.
+	CHECK(controller_synthesis::create_compact_controller(search.get_root(), 1).get_transitions()
+	      == compact_controller.get_transitions());
+	// Computing the transitions sequentially results in the same controller with the same IDs.
+	decltype(location_words) *no_location_words = nullptr;
+	CHECK(controller_synthesis::create_compact_controller(
+	        search.get_root(), 1, no_location_words, false)
+	        .get_transitions()
+	      == compact_controller.get_transitions());
+	CHECK(create_controller(search.get_root(), 1, false).get_transitions()
+	      == controller.get_transitions());
+	// Minimizing the controller keeps the initial location and does not increase its size.
+	const auto minimized_controller = automata::ta::minimize(compact_controller);
+	CAPTURE(minimized_controller);
+	CHECK(minimized_controller.get_initial_location() == compact_controller.get_initial_location());
+	CHECK(minimized_controller.get_locations().size() <= compact_controller.get_locations().size());
+	CHECK(minimized_controller.get_transitions().size()
+	      <= compact_controller.get_transitions().size());
+	CHECK(minimized_controller.get_alphabet() == compact_controller.get_alphabet());
+	for (const auto &word : std::vector<automata::TimedWord>{
+	       {{"c", 0}}, {{"c", 0}, {"c", 1}}, {{"c", 0.5}, {"c", 1}, {"c", 2.5}}, {{"c", 2}}}) {
+		CHECK(minimized_controller.accepts_word(word) == compact_controller.accepts_word(word));
+	}
+}
+
 TEST_CASE("Controller time bounds", "[.railroad][controller]")
 {
 	spdlog::set_level(spdlog::level::debug);
@@ -158,6 +236,229 @@ TEST_CASE("Controller can decide to do nothing", "[controller]")
 	CHECK(controller.get_transitions().empty());
 }
 
+TEST_CASE("Verify controllers in closed loop", "[controller][verification]")
+{
+	TA ta{{Location{"l0"}},
+	      {"c", "e"},
+	      Location{"l0"},
+	      {Location{"l0"}},
+	      {"cc", "ce"},
+	      {Transition{Location{"l0"}, "c", Location{"l0"}, {}, {"cc"}},
+	       Transition{Location{"l0"},
+	                  "e",
+	                  Location{"l0"},
+	                  {{"ce", automata::AtomicClockConstraintT<std::greater<automata::Time>>{1}}},
+	                  {"ce"}}}};
+	auto ata = mtl_ata_translation::translate(finally(F{AP{"e"}}), {AP{"c"}, AP{"e"}});
+	search::TreeSearch<std::string, std::string> search(&ta, &ata, {"c"}, {"e"}, 1, true, false);
+	search.build_tree(false);
+	REQUIRE(search.get_root()->label == NodeLabel::TOP);
+	const bool multi_threaded = GENERATE(false, true);
+	using controller_synthesis::verify_controller;
+	const auto controller         = create_controller(search.get_root(), 1);
+	const auto compact_controller =
+	  controller_synthesis::create_compact_controller(search.get_root(), 1);
+	const auto result = verify_controller(ta, ata, controller, {"c"}, {"e"}, 1, multi_threaded);
+	CHECK(result.verified);
+	CHECK(result.num_states > 0);
+	CHECK(result.num_bad_states == 0);
+	CHECK(result.num_uncovered_actions == 0);
+	CHECK(verify_controller(ta, ata, compact_controller, {"c"}, {"e"}, 1, multi_threaded).verified);
+	CHECK(verify_controller(
+	        ta, ata, automata::ta::minimize(compact_controller), {"c"}, {"e"}, 1, multi_threaded)
+	        .verified);
+
+	using ControllerLocation = automata::ta::Location<controller_synthesis::ControllerLocation>;
+	using ControllerTransition =
+	  automata::ta::Transition<controller_synthesis::ControllerLocation, std::string>;
+	// A controller that never acts does not handle the environment action.
+	const automata::ta::TimedAutomaton<controller_synthesis::ControllerLocation, std::string>
+	              idle_controller{{"c", "e"}, ControllerLocation{0}, {ControllerLocation{0}}};
+	const auto idle_result =
+	  verify_controller(ta, ata, idle_controller, {"c"}, {"e"}, 1, multi_threaded);
+	CHECK(!idle_result.verified);
+	CHECK(idle_result.num_uncovered_actions > 0);
+	// A controller that follows the environment but never resets the clock allows the violation.
+	automata::ta::TimedAutomaton<controller_synthesis::ControllerLocation, std::string>
+	  passive_controller{{"c", "e"}, ControllerLocation{0}, {ControllerLocation{0}}};
+	passive_controller.add_transition(
+	  ControllerTransition{ControllerLocation{0}, "e", ControllerLocation{0}});
+	const auto passive_result =
+	  verify_controller(ta, ata, passive_controller, {"c"}, {"e"}, 1, multi_threaded);
+	CHECK(!passive_result.verified);
+	CHECK(passive_result.num_bad_states > 0);
+	// The controller must only use clocks of the plant.
+	auto other_controller = passive_controller;
+	other_controller.add_clock("y");
+	CHECK_THROWS_AS(verify_controller(ta, ata, other_controller, {"c"}, {"e"}, 1),
+	                std::invalid_argument);
+}
+
+TEST_CASE("Environment wins ties in the closed-loop verification", "[controller][verification]")
+{
+	TA ta{{Location{"l0"}},
+	      {"c", "e"},
+	      Location{"l0"},
+	      {Location{"l0"}},
+	      {"x"},
+	      {Transition{Location{"l0"}, "c", Location{"l0"}},
+	       Transition{Location{"l0"}, "e", Location{"l0"}}}};
+	auto ata = mtl_ata_translation::translate(finally(F{AP{"e"}}), {AP{"c"}, AP{"e"}});
+	search::TreeSearch<std::string, std::string> search(&ta, &ata, {"c"}, {"e"}, 1, true, false);
+	search.build_tree(false);
+	REQUIRE(search.get_root()->label == NodeLabel::BOTTOM);
+	using ControllerLocation = automata::ta::Location<controller_synthesis::ControllerLocation>;
+	using ControllerTransition =
+	  automata::ta::Transition<controller_synthesis::ControllerLocation, std::string>;
+	// The controller always acts immediately, but the environment may act in the same region.
+	automata::ta::TimedAutomaton<controller_synthesis::ControllerLocation, std::string> controller{
+	  {"c", "e"}, ControllerLocation{0}, {ControllerLocation{0}}};
+	controller.add_transition(
+	  ControllerTransition{ControllerLocation{0}, "c", ControllerLocation{0}});
+	controller.add_transition(
+	  ControllerTransition{ControllerLocation{0}, "e", ControllerLocation{0}});
+	const bool multi_threaded = GENERATE(false, true);
+	const auto result =
+	  controller_synthesis::verify_controller(ta, ata, controller, {"c"}, {"e"}, 1, multi_threaded);
+	CHECK(!result.verified);
+	CHECK(result.num_bad_states > 0);
+	// Without a transition for the environment action, the action is uncovered.
+	automata::ta::TimedAutomaton<controller_synthesis::ControllerLocation, std::string>
+	  eager_controller{{"c", "e"}, ControllerLocation{0}, {ControllerLocation{0}}};
+	eager_controller.add_transition(
+	  ControllerTransition{ControllerLocation{0}, "c", ControllerLocation{0}});
+	const auto eager_result = controller_synthesis::verify_controller(
+	  ta, ata, eager_controller, {"c"}, {"e"}, 1, multi_threaded);
+	CHECK(!eager_result.verified);
+	CHECK(eager_result.num_uncovered_actions > 0);
+}
+
+TEST_CASE("Stop the closed-loop verification in hopeless states", "[controller][verification]")
+{
+	TA ta{{Location{"l0"}},
+	      {"a", "c"},
+	      Location{"l0"},
+	      {Location{"l0"}},
+	      {"x"},
+	      {Transition{Location{"l0"}, "a", Location{"l0"}, {}, {"x"}},
+	       Transition{Location{"l0"},
+	                  "c",
+	                  Location{"l0"},
+	                  {{"x", automata::AtomicClockConstraintT<std::greater<automata::Time>>{1}}}}}};
+	auto ata = mtl_ata_translation::translate(finally(F{AP{"c"}}, logic::TimeInterval(0, 1)),
+	                                          {AP{"a"}, AP{"c"}});
+	search::TreeSearch<std::string, std::string> search(&ta, &ata, {"c"}, {"a"}, 1, true, false);
+	search.build_tree(false);
+	REQUIRE(search.get_root()->label == NodeLabel::TOP);
+	// Once the until location has passed its upper bound, the search does not expand the node, and so
+	// the controller does not handle the environment action afterwards.
+	const auto result = controller_synthesis::verify_controller(
+	  ta, ata, create_controller(search.get_root(), 1), {"c"}, {"a"}, 1, GENERATE(false, true));
+	CHECK(result.verified);
+	CHECK(result.num_bad_states == 0);
+	CHECK(result.num_uncovered_actions == 0);
+}
+
+TEST_CASE("Stream a controller during the search", "[controller][railroad]")
+{
+	using Words = std::set<search::CanonicalABWord<std::vector<std::string>, std::string>>;
+	using ControllerTransition =
+	  std::tuple<Words, std::string, Words, std::multimap<std::string, automata::ClockConstraint>>;
+	const auto &[plant, spec, controller_actions, environment_actions] = create_crossing_problem({2});
+	std::set<AP> actions;
+	for (const auto &action : controller_actions) {
+		actions.insert(AP{action});
+	}
+	for (const auto &action : environment_actions) {
+		actions.insert(AP{action});
+	}
+	auto       ata = mtl_ata_translation::translate(spec, actions);
+	const auto K = static_cast<search::RegionIndex>(
+	  std::max(plant.get_largest_constant(), spec.get_largest_constant()));
+	// Translate each transition into the canonical words of its source and target, as the streamed
+	// controller may number its locations differently.
+	const auto get_transitions = [](const auto &controller, const auto &location_words) {
+		std::set<ControllerTransition> res;
+		for (const auto &[source, transition] : controller.get_transitions()) {
+			res.emplace(location_words.at(source.get()),
+			            transition.symbol_,
+			            location_words.at(transition.target_.get()),
+			            transition.get_guards());
+		}
+		return res;
+	};
+
+	SECTION("Single-threaded search with freeing of emitted nodes")
+	{
+		// The emitted nodes are freed, so compare with the controller from a second search.
+		search::TreeSearch<std::vector<std::string>, std::string> reference_search{
+		  &plant, &ata, controller_actions, environment_actions, K, true, true};
+		reference_search.build_tree(false);
+		REQUIRE(reference_search.get_root()->label == NodeLabel::TOP);
+		std::map<controller_synthesis::ControllerLocation, Words> reference_words;
+		const auto reference_controller = controller_synthesis::create_compact_controller(
+		  reference_search.get_root(), K, &reference_words);
+		search::TreeSearch<std::vector<std::string>, std::string> search{
+		  &plant, &ata, controller_actions, environment_actions, K, true, true};
+		std::map<controller_synthesis::ControllerLocation, Words> words;
+		controller_synthesis::ControllerStream<std::vector<std::string>, std::string> stream{
+		  search.get_root(), K, true, &words};
+		std::size_t emitted_during_search = 0;
+		search.set_expansion_callback([&stream, &emitted_during_search](auto *node) {
+			emitted_during_search += stream.update(node);
+		});
+		while (search.step()) {}
+		const auto &controller = stream.finish();
+		CHECK(stream.is_complete());
+		CHECK(emitted_during_search == stream.get_num_emitted_nodes());
+		CHECK(stream.get_num_freed_nodes() > 0);
+		CHECK(stream.get_num_destroyed_nodes() > 0);
+		CHECK(search.get_size() + stream.get_num_destroyed_nodes() == reference_search.get_size());
+		// The whole controller has been emitted, so the words of the root have been freed.
+		CHECK(search.get_root()->words.empty());
+		CHECK(controller.get_locations().size() >= reference_controller.get_locations().size());
+		CHECK(get_transitions(controller, words)
+		      == get_transitions(reference_controller, reference_words));
+	}
+
+	SECTION("Multi-threaded search")
+	{
+		search::TreeSearch<std::vector<std::string>, std::string> search{
+		  &plant, &ata, controller_actions, environment_actions, K, true, true};
+		std::map<controller_synthesis::ControllerLocation, Words> stream_words;
+		controller_synthesis::ControllerStream<std::vector<std::string>, std::string> stream{
+		  search.get_root(), K, false, &stream_words};
+		search.set_expansion_callback([&stream](auto *node) { stream.update(node); });
+		search.build_tree(true);
+		REQUIRE(search.get_root()->label == NodeLabel::TOP);
+		const auto &controller = stream.finish();
+		CHECK(stream.get_num_freed_nodes() == 0);
+		CHECK(stream.get_num_destroyed_nodes() == 0);
+		// The tree is still available, compare with the controller created from the tree.
+		std::map<controller_synthesis::ControllerLocation, Words> words;
+		const auto tree_controller =
+		  controller_synthesis::create_compact_controller(search.get_root(), K, &words);
+		CHECK(controller.get_locations().size() == tree_controller.get_locations().size());
+		CHECK(get_transitions(controller, stream_words) == get_transitions(tree_controller, words));
+	}
+
+	SECTION("No controller if the environment controls all actions")
+	{
+		std::set<std::string> all_actions = environment_actions;
+		all_actions.insert(std::begin(controller_actions), std::end(controller_actions));
+		search::TreeSearch<std::vector<std::string>, std::string> search{
+		  &plant, &ata, {}, all_actions, K, true, true};
+		controller_synthesis::ControllerStream<std::vector<std::string>, std::string> stream{
+		  search.get_root(), K, true};
+		while (search.step()) {
+			stream.update();
+		}
+		REQUIRE(search.get_root()->label == NodeLabel::BOTTOM);
+		CHECK(!stream.is_complete());
+		CHECK_THROWS_AS(stream.finish(), std::invalid_argument);
+	}
+}
+
 TEST_CASE("Compute clock constraints from outgoing actions", "[controller]")
 {
 	using controller_synthesis::details::get_constraints_from_outgoing_actions;
@@ -187,6 +488,14 @@ TEST_CASE("Compute clock constraints from outgoing actions", "[controller]")
 	           {"c1", automata::AtomicClockConstraintT<std::less_equal<automata::Time>>{1}},
 	           {"c2", automata::AtomicClockConstraintT<std::greater_equal<automata::Time>>{1}},
 	           {"c2", automata::AtomicClockConstraintT<std::less<automata::Time>>{2}}}}});
+	// Looking up time successors in the precomputed chain is the same as computing them directly.
+	const search::CanonicalABWord<std::string, std::string> word(
+	  {{TARegionState{Location{"s0"}, "c1", 0}}, {TARegionState{Location{"s0"}, "c2", 1}}});
+	const auto time_successors = search::get_time_successors(word, 3);
+	for (search::RegionIndex n = 0; n < 12; ++n) {
+		CHECK(controller_synthesis::details::get_nth_time_successor(time_successors, n)
+		      == search::get_nth_time_successor(word, n, 3));
+	}
 }
 
 } // namespace
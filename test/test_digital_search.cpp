@@ -0,0 +1,165 @@
+/***************************************************************************
+ *  test_digital_search.cpp - Test the search with digital clocks
+ *
+ *  Created:   Sun 18 Oct 22:17:05 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "automata/ta.h"
+#include "automata/ta_product.h"
+#include "mtl/MTLFormula.h"
+#include "mtl_ata_translation/translator.h"
+#include "railroad.h"
+#include "search/digital_search.h"
+#include "search/search.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace {
+
+using TA         = automata::ta::TimedAutomaton<std::string, std::string>;
+using Transition = automata::ta::Transition<std::string, std::string>;
+using Location   = automata::ta::Location<std::string>;
+using F          = logic::MTLFormula<std::string>;
+using AP         = logic::AtomicProposition<std::string>;
+using automata::AtomicClockConstraintT;
+using automata::Time;
+using search::NodeLabel;
+using TARegionState   = search::TARegionState<std::string>;
+using CanonicalABWord = search::CanonicalABWord<std::string, std::string>;
+using utilities::arithmetic::BoundType;
+
+/** A machine that must be started within two time units, the job takes at least one time unit. */
+TA
+create_closed_plant()
+{
+	const Location idle{"idle"};
+	const Location busy{"busy"};
+	const Location failed{"failed"};
+	return TA{{idle, busy, failed},
+	          {"start", "finish", "fail"},
+	          idle,
+	          {idle, busy, failed},
+	          {"x"},
+	          {Transition{idle, "start", busy, {}, {"x"}},
+	           Transition{busy,
+	                      "finish",
+	                      idle,
+	                      {{"x", AtomicClockConstraintT<std::greater_equal<Time>>(1)}},
+	                      {"x"}},
+	           Transition{idle,
+	                      "fail",
+	                      failed,
+	                      {{"x", AtomicClockConstraintT<std::greater_equal<Time>>(2)}}}}};
+}
+
+TEST_CASE("Check whether digital clocks are sound", "[search][digital]")
+{
+	const auto plant = create_closed_plant();
+	CHECK(search::digital_clocks_are_sound(plant, logic::finally(F{AP{"fail"}})));
+	CHECK(search::digital_clocks_are_sound(
+	  plant, logic::finally(F{AP{"fail"}}, logic::TimeInterval{1, 3})));
+	CHECK(!search::digital_clocks_are_sound(
+	  plant,
+	  logic::finally(F{AP{"fail"}}, logic::TimeInterval{1, BoundType::STRICT, 3, BoundType::WEAK})));
+	CHECK(!search::digital_clocks_are_sound(
+	  plant,
+	  logic::globally(F{AP{"start"}},
+	                  logic::TimeInterval{1, BoundType::WEAK, 1, BoundType::INFTY})
+	    || F{AP{"fail"}}.dual_until(F{AP{"start"}},
+	                                logic::TimeInterval{0, BoundType::WEAK, 2, BoundType::STRICT})));
+	TA strict_plant{{"a"}, Location{"l0"}, {Location{"l0"}}};
+	strict_plant.add_clock("x");
+	strict_plant.add_transition(Transition{
+	  Location{"l0"}, "a", Location{"l0"}, {{"x", AtomicClockConstraintT<std::less<Time>>(1)}}});
+	CHECK(!search::digital_clocks_are_sound(strict_plant, logic::finally(F{AP{"a"}})));
+}
+
+TEST_CASE("Digital time successors", "[search][digital]")
+{
+	const CanonicalABWord word{{TARegionState{Location{"l0"}, "x", 0},
+	                            TARegionState{Location{"l0"}, "y", 2}}};
+	const auto successors = search::details::get_digital_time_successors(word, 2);
+	CHECK(successors
+	      == std::vector<std::pair<search::RegionIndex, CanonicalABWord>>{
+	        {0, word},
+	        {2, {{TARegionState{Location{"l0"}, "x", 2}, TARegionState{Location{"l0"}, "y", 4}}}},
+	        {4,
+	         {{TARegionState{Location{"l0"}, "x", 4}}, {TARegionState{Location{"l0"}, "y", 5}}}},
+	        {6, {{TARegionState{Location{"l0"}, "x", 5}, TARegionState{Location{"l0"}, "y", 5}}}}});
+	// A word that only consists of saturated symbols is its own time successor.
+	CHECK(search::details::get_digital_time_successors(successors.back().second, 2).size() == 1);
+}
+
+TEST_CASE("Search with digital clocks", "[search][digital]")
+{
+	const auto plant = create_closed_plant();
+	auto       ata   = mtl_ata_translation::translate(logic::finally(F{AP{"fail"}}),
+	                                            {AP{"start"}, AP{"finish"}, AP{"fail"}});
+	const bool multi_threaded = GENERATE(false, true);
+	search::DigitalTreeSearch<std::string, std::string> digital_search{
+	  &plant, &ata, {"start"}, {"finish", "fail"}, 2, true, true};
+	digital_search.build_tree(multi_threaded);
+	search::TreeSearch<std::string, std::string> region_search{
+	  &plant, &ata, {"start"}, {"finish", "fail"}, 2, true, true};
+	region_search.build_tree(multi_threaded);
+	CHECK(digital_search.get_root()->label == NodeLabel::TOP);
+	CHECK(digital_search.get_root()->label == region_search.get_root()->label);
+	// No node contains a fractional clock value.
+	std::vector<const search::SearchTreeNode<std::string, std::string> *> stack{
+	  digital_search.get_root()};
+	while (!stack.empty()) {
+		const auto *node = stack.back();
+		stack.pop_back();
+		for (const auto &word : node->words) {
+			for (const auto &[increment, action] : node->incoming_actions) {
+				CHECK(increment % 2 == 0);
+			}
+			CHECK(word == search::details::get_digital_word(word, 2));
+		}
+		for (const auto &child : node->children) {
+			stack.push_back(child.get());
+		}
+	}
+}
+
+TEST_CASE("Search the railroad crossing with digital clocks", "[search][digital][railroad]")
+{
+	const auto &[plant, spec, controller_actions, environment_actions] = create_crossing_problem({2});
+	REQUIRE(search::digital_clocks_are_sound(plant, spec));
+	std::set<AP> actions;
+	std::set_union(std::begin(controller_actions),
+	               std::end(controller_actions),
+	               std::begin(environment_actions),
+	               std::end(environment_actions),
+	               std::inserter(actions, std::end(actions)));
+	auto       ata = mtl_ata_translation::translate(spec, actions);
+	const auto K   = static_cast<search::RegionIndex>(
+	  std::max(plant.get_largest_constant(), spec.get_largest_constant()));
+	search::DigitalTreeSearch<std::vector<std::string>, std::string> digital_search{
+	  &plant, &ata, controller_actions, environment_actions, K, true, true};
+	digital_search.build_tree();
+	search::TreeSearch<std::vector<std::string>, std::string> region_search{
+	  &plant, &ata, controller_actions, environment_actions, K, true, true};
+	region_search.build_tree();
+	CHECK(digital_search.get_root()->label == NodeLabel::TOP);
+	CHECK(digital_search.get_root()->label == region_search.get_root()->label);
+	INFO("Digital tree: " << digital_search.get_size() << ", region tree: "
+	                      << region_search.get_size());
+	CHECK(digital_search.get_size() < region_search.get_size());
+}
+
+} // namespace
@@ -0,0 +1,143 @@
+/***************************************************************************
+ *  test_dot_writer.cpp - Test streaming search trees and TAs as dot text
+ *
+ *  Created:   Mon 19 Oct 03:02:35 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "mtl/MTLFormula.h"
+#include "mtl_ata_translation/translator.h"
+#include "search/search.h"
+#include "visualization/dot_writer.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+
+namespace {
+
+using TreeSearch   = search::TreeSearch<std::string, std::string>;
+using TATransition = automata::ta::Transition<std::string, std::string>;
+using TA           = automata::ta::TimedAutomaton<std::string, std::string>;
+using AP           = logic::AtomicProposition<std::string>;
+using Location     = automata::ta::Location<std::string>;
+using automata::AtomicClockConstraintT;
+
+TA
+create_plant()
+{
+	TA ta{{"a", "b"}, Location{"l0"}, {Location{"l1"}}};
+	ta.add_clock("x");
+	ta.add_transition(TATransition(Location{"l0"},
+	                               "a",
+	                               Location{"l0"},
+	                               {{"x", AtomicClockConstraintT<std::greater<automata::Time>>(1)}},
+	                               {"x"}));
+	ta.add_transition(TATransition(Location{"l0"},
+	                               "b",
+	                               Location{"l1"},
+	                               {{"x", AtomicClockConstraintT<std::less<automata::Time>>(1)}}));
+	return ta;
+}
+
+std::size_t
+count(const std::string &text, const std::string &pattern)
+{
+	std::size_t res = 0;
+	for (auto pos = text.find(pattern); pos != std::string::npos;
+	     pos      = text.find(pattern, pos + pattern.size())) {
+		++res;
+	}
+	return res;
+}
+
+TEST_CASE("Stream a timed automaton as dot graph", "[visualization][dot]")
+{
+	std::stringstream str;
+	visualization::write_ta_dot(str, create_plant());
+	const auto dot = str.str();
+	CHECK(dot.rfind("digraph {", 0) == 0);
+	CHECK(dot.find("  n0 [label=\"l0\"];") != std::string::npos);
+	CHECK(dot.find("  n1 [label=\"l1\", peripheries=2];") != std::string::npos);
+	CHECK(dot.find("  init -> n0;") != std::string::npos);
+	CHECK(count(dot, "->") == 3);
+	// Line breaks in the edge labels are escaped.
+	CHECK(dot.find(" a \\n") != std::string::npos);
+
+	std::stringstream points;
+	visualization::write_ta_dot(points, create_plant(), false);
+	CHECK(points.str().find("node [shape=point];") != std::string::npos);
+}
+
+TEST_CASE("Stream a search tree as dot graph", "[visualization][dot]")
+{
+	const auto                           ta = create_plant();
+	const logic::MTLFormula<std::string> a{AP("a")};
+	const logic::MTLFormula<std::string> b{AP("b")};
+	auto       ata = mtl_ata_translation::translate(a.until(b), {AP{"a"}, AP{"b"}});
+	TreeSearch search{&ta, &ata, {"a"}, {"b"}, 1};
+	search.build_tree(false);
+	search.label();
+	const auto size = search.get_size();
+	REQUIRE(size > 3);
+
+	SECTION("Write the complete tree")
+	{
+		std::stringstream str;
+		CHECK(visualization::write_search_tree_dot(str, *search.get_root()) == size);
+		const auto dot = str.str();
+		CHECK(count(dot, "[label=") == size);
+		CHECK(count(dot, "->") == size - 1);
+		CHECK(dot.find("collapsed") == std::string::npos);
+	}
+	SECTION("Collapse deep sub-trees")
+	{
+		std::stringstream str;
+		const auto        num_nodes = visualization::write_search_tree_dot(
+		  str, *search.get_root(), visualization::DotOptions{1, 0, 0, false});
+		CHECK(num_nodes == 1 + search.get_root()->children.size());
+		const auto dot = str.str();
+		CHECK(dot.find("collapsed nodes") != std::string::npos);
+	}
+	SECTION("Sample children")
+	{
+		std::stringstream str;
+		const auto        num_nodes = visualization::write_search_tree_dot(
+		  str, *search.get_root(), visualization::DotOptions{1, 1, 0, false});
+		CHECK(num_nodes == 2);
+		const auto dot = str.str();
+		CHECK(dot.find(std::to_string(search.get_root()->children.size() - 1) + " more children")
+		      != std::string::npos);
+	}
+	SECTION("Truncate labels")
+	{
+		std::stringstream str;
+		visualization::write_search_tree_dot(str,
+		                                     *search.get_root(),
+		                                     visualization::DotOptions{0, 0, 5, false});
+		const auto dot = str.str();
+		CHECK(count(dot, "...\"") == size);
+	}
+}
+
+TEST_CASE("Escape dot labels", "[visualization][dot]")
+{
+	using visualization::details::escape_dot_label;
+	CHECK(escape_dot_label("a\"b\\c\nd") == "a\\\"b\\\\c\\nd");
+	CHECK(escape_dot_label("abcdef", 3) == "abc...");
+	CHECK(escape_dot_label("abc", 3) == "abc");
+}
+
+} // namespace
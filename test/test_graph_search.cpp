@@ -0,0 +1,128 @@
+/***************************************************************************
+ *  test_graph_search.cpp - Test the fixpoint solver on the game graph
+ *
+ *  Created:   Sun 18 Oct 19:02:33 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "automata/ta.h"
+#include "automata/ta_product.h"
+#include "mtl/MTLFormula.h"
+#include "mtl_ata_translation/translator.h"
+#include "railroad.h"
+#include "search/graph_search.h"
+#include "search/search.h"
+#include "search/verify_controller.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace {
+
+using TA         = automata::ta::TimedAutomaton<std::string, std::string>;
+using Transition = automata::ta::Transition<std::string, std::string>;
+using Location   = automata::ta::Location<std::string>;
+using F          = logic::MTLFormula<std::string>;
+using AP         = logic::AtomicProposition<std::string>;
+using automata::AtomicClockConstraintT;
+using search::NodeLabel;
+
+TEST_CASE("Solve a cyclic plant on the game graph", "[search][graph]")
+{
+	// The environment may only act with e once ce exceeds 1. The controller's action c only resets
+	// cc, but the controller prevents e by acting with c before any time passes. This does not change
+	// the configuration, thus the plant cycles forever in l0.
+	TA ta{{Location{"l0"}},
+	      {"c", "e"},
+	      Location{"l0"},
+	      {Location{"l0"}},
+	      {"cc", "ce"},
+	      {Transition{Location{"l0"}, "c", Location{"l0"}, {}, {"cc"}},
+	       Transition{Location{"l0"},
+	                  "e",
+	                  Location{"l0"},
+	                  {{"ce", AtomicClockConstraintT<std::greater<automata::Time>>{1}}},
+	                  {"ce"}}}};
+	auto ata = mtl_ata_translation::translate(finally(F{AP{"e"}}), {AP{"c"}, AP{"e"}});
+	const bool multi_threaded = GENERATE(false, true);
+	search::GraphSearch<std::string, std::string> graph_search{&ta, &ata, {"c"}, {"e"}, 1};
+	graph_search.build_graph(multi_threaded);
+	graph_search.label(multi_threaded);
+	search::TreeSearch<std::string, std::string> tree_search{&ta, &ata, {"c"}, {"e"}, 1};
+	tree_search.build_tree(false);
+	tree_search.label();
+	CHECK(graph_search.get_root().label == tree_search.get_root()->label);
+	REQUIRE(graph_search.get_root().label == NodeLabel::TOP);
+	CHECK(graph_search.get_size() <= tree_search.get_size());
+	// Every node except the root has a predecessor.
+	const auto &nodes = graph_search.get_nodes();
+	for (std::size_t id = 1; id < nodes.size(); ++id) {
+		CHECK(!nodes[id].predecessors.empty());
+	}
+
+	const auto controller = controller_synthesis::create_compact_controller(graph_search);
+	CHECK(controller.get_initial_location() == automata::ta::Location<std::size_t>{0});
+	// The controller is cyclic, so each location has an outgoing transition.
+	for (const auto &location : controller.get_locations()) {
+		CHECK(controller.get_transitions().count(location) > 0);
+	}
+	const auto result =
+	  controller_synthesis::verify_controller(ta, ata, controller, {"c"}, {"e"}, 1, multi_threaded);
+	CHECK(result.verified);
+}
+
+TEST_CASE("Detect a losing game on the game graph", "[search][graph]")
+{
+	TA ta{{"e", "c"}, Location{"l0"}, {Location{"l0"}, Location{"l1"}}};
+	ta.add_clock("x");
+	ta.add_transition(Transition(Location{"l0"}, "e", Location{"l0"}));
+	ta.add_transition(Transition(Location{"l1"}, "c", Location{"l1"}));
+	ta.add_transition(Transition(Location{"l0"},
+	                             "c",
+	                             Location{"l1"},
+	                             {{"x", AtomicClockConstraintT<std::greater<automata::Time>>(1)}}));
+	auto ata = mtl_ata_translation::translate(F::TRUE().until(F{AP{"e"}}), {AP{"e"}, AP{"c"}});
+	search::GraphSearch<std::string, std::string> search{&ta, &ata, {"c"}, {"e"}, 2};
+	search.build_graph();
+	search.label();
+	CHECK(search.get_root().label == NodeLabel::BOTTOM);
+	CHECK_THROWS_AS(controller_synthesis::create_compact_controller(search), std::invalid_argument);
+}
+
+TEST_CASE("Solve the railroad crossing on the game graph", "[search][graph][railroad]")
+{
+	const auto &[plant, spec, controller_actions, environment_actions] = create_crossing_problem({2});
+	std::set<AP> actions;
+	std::set_union(std::begin(controller_actions),
+	               std::end(controller_actions),
+	               std::begin(environment_actions),
+	               std::end(environment_actions),
+	               std::inserter(actions, std::end(actions)));
+	auto       ata = mtl_ata_translation::translate(spec, actions);
+	const auto K = static_cast<search::RegionIndex>(
+	  std::max(plant.get_largest_constant(), spec.get_largest_constant()));
+	search::GraphSearch<std::vector<std::string>, std::string> search{
+	  &plant, &ata, controller_actions, environment_actions, K};
+	search.build_graph();
+	search.label();
+	INFO("Graph size: " << search.get_size());
+	REQUIRE(search.get_root().label == NodeLabel::TOP);
+	const auto controller = controller_synthesis::create_compact_controller(search);
+	CHECK(controller_synthesis::verify_controller(
+	        plant, ata, controller, controller_actions, environment_actions, K)
+	        .verified);
+}
+
+} // namespace
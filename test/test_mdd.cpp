@@ -0,0 +1,63 @@
+/***************************************************************************
+ *  test_mdd.cpp - Test multi-valued decision diagrams
+ *
+ *  Created:   Sun 18 Oct 20:14:08 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "utilities/mdd.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+using utilities::mdd::false_node;
+using utilities::mdd::Manager;
+using utilities::mdd::true_node;
+using Sequences = std::vector<std::vector<utilities::mdd::Value>>;
+
+TEST_CASE("Decision diagram set operations", "[mdd]")
+{
+	Manager    manager;
+	const auto a   = manager.make_sequence({1, 2, 3});
+	const auto b   = manager.make_sequence({1, 4, 3});
+	const auto c   = manager.make_sequence({2});
+	const auto ab  = manager.unite(a, b);
+	const auto abc = manager.unite(ab, c);
+	CHECK(manager.make_sequence({}) == true_node);
+	CHECK(manager.count(false_node) == 0);
+	CHECK(manager.count(true_node) == 1);
+	CHECK(manager.count(abc) == 3);
+	CHECK(manager.get_sequences(abc) == Sequences{{1, 2, 3}, {1, 4, 3}, {2}});
+	CHECK(manager.contains(abc, {1, 4, 3}));
+	CHECK(!manager.contains(abc, {1, 4}));
+	CHECK(!manager.contains(abc, {1, 4, 3, 5}));
+	// Equal sets are represented by the same node, independent of their construction.
+	CHECK(manager.unite(c, manager.unite(b, a)) == abc);
+	CHECK(manager.unite(abc, a) == abc);
+	CHECK(manager.intersect(abc, manager.unite(a, manager.make_sequence({5}))) == a);
+	CHECK(manager.subtract(abc, c) == ab);
+	CHECK(manager.subtract(ab, abc) == false_node);
+	CHECK(manager.intersect(a, c) == false_node);
+	// Sequences of different lengths can share a prefix.
+	const auto prefix = manager.unite(manager.make_sequence({1, 2}), a);
+	CHECK(manager.get_sequences(prefix) == Sequences{{1, 2, 3}, {1, 2}});
+	// The common suffix 3 of a and b is shared.
+	CHECK(manager.get_size(ab) == 4);
+	CHECK_THROWS_AS(manager.make_sequence({1, utilities::mdd::end_value}), std::invalid_argument);
+	CHECK_THROWS_AS(manager.make_node({{2, true_node}, {1, true_node}}), std::invalid_argument);
+}
+
+} // namespace
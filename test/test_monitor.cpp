@@ -0,0 +1,153 @@
+/***************************************************************************
+ *  test_monitor.cpp - Test the deterministic monitor construction
+ *
+ *  Created:   Sun 18 Oct 11:20:45 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "automata/ta.h"
+#include "automata/ta_product.h"
+#include "mtl/MTLFormula.h"
+#include "mtl_ata_translation/monitor.h"
+#include "mtl_ata_translation/translator.h"
+#include "search/monitor_search.h"
+#include "search/search.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <vector>
+
+namespace {
+
+using AP           = logic::AtomicProposition<std::string>;
+using MTLFormula   = logic::MTLFormula<std::string>;
+using TA           = automata::ta::TimedAutomaton<std::string, std::string>;
+using TATransition = automata::ta::Transition<std::string, std::string>;
+using Location     = automata::ta::Location<std::string>;
+using automata::AtomicClockConstraintT;
+using logic::TimeInterval;
+using utilities::arithmetic::BoundType;
+
+/** Enumerate all timed words up to the given length with time stamps in {0, 0.5, ..., max_time}. */
+std::vector<automata::TimedWord>
+get_timed_words(const std::set<std::string> &alphabet, std::size_t length, double max_time)
+{
+	std::vector<automata::TimedWord> res;
+	std::vector<automata::TimedWord> current;
+	for (const auto &symbol : alphabet) {
+		current.push_back({{symbol, 0}});
+	}
+	for (std::size_t i = 1; i < length; ++i) {
+		res.insert(std::end(res), std::begin(current), std::end(current));
+		std::vector<automata::TimedWord> next;
+		for (const auto &word : current) {
+			for (double time = word.back().second; time <= max_time; time += 0.5) {
+				for (const auto &symbol : alphabet) {
+					auto new_word = word;
+					new_word.emplace_back(symbol, time);
+					next.push_back(new_word);
+				}
+			}
+		}
+		current = std::move(next);
+	}
+	res.insert(std::end(res), std::begin(current), std::end(current));
+	return res;
+}
+
+TEST_CASE("Detect the monitorable MTL fragment", "[monitor]")
+{
+	const MTLFormula a{AP{"a"}};
+	const MTLFormula b{AP{"b"}};
+	CHECK(mtl_ata_translation::is_monitorable(
+	  logic::finally(a, TimeInterval{1, BoundType::WEAK, 3, BoundType::STRICT})));
+	CHECK(mtl_ata_translation::is_monitorable(logic::finally(a && !b)));
+	CHECK(mtl_ata_translation::is_monitorable(
+	  logic::finally(a, TimeInterval{1, BoundType::WEAK, 3, BoundType::STRICT})
+	  || logic::finally(b, TimeInterval{2, BoundType::STRICT, 2, BoundType::INFTY})));
+	CHECK(!mtl_ata_translation::is_monitorable(a.until(b)));
+	CHECK(!mtl_ata_translation::is_monitorable(logic::globally(a)));
+	CHECK(!mtl_ata_translation::is_monitorable(logic::finally(logic::finally(a))));
+	CHECK(!mtl_ata_translation::is_monitorable(
+	  logic::finally(a, TimeInterval{0.5, BoundType::WEAK, 3, BoundType::WEAK})));
+	CHECK_THROWS_AS(mtl_ata_translation::translate_to_monitor(a.until(b)), std::invalid_argument);
+}
+
+TEST_CASE("The monitor accepts the same language as the ATA", "[monitor]")
+{
+	const MTLFormula a{AP{"a"}};
+	const MTLFormula b{AP{"b"}};
+	const MTLFormula c{AP{"c"}};
+	const std::set<AP> alphabet{AP{"a"}, AP{"b"}, AP{"c"}};
+	const auto         spec = GENERATE_REF(
+    logic::finally(a, TimeInterval{1, BoundType::WEAK, 2, BoundType::STRICT}),
+    logic::finally(a || b, TimeInterval{1, BoundType::STRICT, 1, BoundType::INFTY}),
+    logic::finally(!a, TimeInterval{1, BoundType::WEAK, 1, BoundType::WEAK}),
+    logic::finally(a, TimeInterval{0, BoundType::WEAK, 1, BoundType::STRICT})
+      || logic::finally(b && !c, TimeInterval{2, BoundType::WEAK, 3, BoundType::WEAK}));
+	const auto monitor = mtl_ata_translation::translate_to_monitor(spec, alphabet);
+	const auto ata     = mtl_ata_translation::translate(spec, alphabet);
+	INFO("Specification: " << spec);
+	INFO("Monitor: " << monitor);
+	for (const auto &word : get_timed_words({"a", "b", "c"}, 3, 3.5)) {
+		INFO("Word: " << word.size() << " symbols, last at " << word.back().second);
+		CHECK(monitor.accepts_word(word) == ata.accepts_word(word));
+	}
+}
+
+TEST_CASE("Search with a deterministic monitor", "[monitor][search]")
+{
+	TA ta{{"c", "e"}, Location{"l0"}, {Location{"l0"}}};
+	ta.add_clock("x");
+	ta.add_transition(TATransition{Location{"l0"}, "c", Location{"l0"}, {}, {"x"}});
+	ta.add_transition(
+	  TATransition{Location{"l0"},
+	               "e",
+	               Location{"l0"},
+	               {{"x", AtomicClockConstraintT<std::greater_equal<automata::Time>>(2)}}});
+	const auto       plant = automata::ta::get_product<std::string, std::string>({ta});
+	const MTLFormula e{AP{"e"}};
+	const auto       spec = GENERATE_REF(
+    logic::finally(e),
+    logic::finally(e, TimeInterval{0, BoundType::WEAK, 1, BoundType::WEAK}),
+    logic::finally(e, TimeInterval{3, BoundType::WEAK, 3, BoundType::INFTY}));
+	const std::set<AP> alphabet{AP{"c"}, AP{"e"}};
+	auto               ata     = mtl_ata_translation::translate(spec, alphabet);
+	const auto         monitor = mtl_ata_translation::translate_to_monitor(spec, alphabet);
+	const auto         K =
+	  static_cast<search::RegionIndex>(std::max(plant.get_largest_constant(), spec.get_largest_constant()));
+	const auto controller_actions = GENERATE(std::set<std::string>{"c"}, std::set<std::string>{});
+	std::set<std::string> environment_actions{"e"};
+	if (controller_actions.empty()) {
+		environment_actions.insert("c");
+	}
+	search::TreeSearch<std::vector<std::string>, std::string> ata_search{
+	  &plant, &ata, controller_actions, environment_actions, K};
+	search::MonitorTreeSearch<std::string, std::string> monitor_search{
+	  plant, monitor, controller_actions, environment_actions, K};
+	ata_search.build_tree(false);
+	ata_search.label();
+	monitor_search.build_tree(false);
+	monitor_search.label();
+	INFO("Specification: " << spec);
+	CHECK(monitor_search.get_root()->label == ata_search.get_root()->label);
+	CHECK(monitor_search.get_monitored_plant().get_clocks() == std::set<std::string>{"x", "monitor"});
+	if (spec == logic::finally(e) && !controller_actions.empty()) {
+		// The controller can always reset the clock before the environment may act.
+		CHECK(monitor_search.get_root()->label == search::NodeLabel::TOP);
+	}
+}
+
+} // namespace
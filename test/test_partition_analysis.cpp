@@ -0,0 +1,105 @@
+/***************************************************************************
+ *  test_partition_analysis.cpp - Test labeling a search tree for many partitions
+ *
+ *  Created:   Mon 19 Oct 01:10:43 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "mtl/MTLFormula.h"
+#include "mtl_ata_translation/translator.h"
+#include "search/partition_analysis.h"
+#include "search/search.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+using TreeSearch   = search::TreeSearch<std::string, std::string>;
+using TATransition = automata::ta::Transition<std::string, std::string>;
+using TA           = automata::ta::TimedAutomaton<std::string, std::string>;
+using AP           = logic::AtomicProposition<std::string>;
+using Location     = automata::ta::Location<std::string>;
+using automata::AtomicClockConstraintT;
+using search::NodeLabel;
+using utilities::arithmetic::BoundType;
+
+TEST_CASE("Find the controllable partitions of a plant", "[search][partitions]")
+{
+	TA ta{{"a", "b"}, Location{"l0"}, {Location{"l0"}, Location{"l1"}}};
+	ta.add_clock("x");
+	ta.add_transition(TATransition(Location{"l0"}, "a", Location{"l0"}));
+	ta.add_transition(TATransition(Location{"l0"}, "b", Location{"l1"}));
+	ta.add_transition(TATransition(Location{"l1"}, "a", Location{"l1"}));
+	ta.add_transition(TATransition(Location{"l1"}, "b", Location{"l1"}));
+	const logic::MTLFormula<std::string> b{AP("b")};
+	// The action b is undesired after the first action, so the controller wins iff it controls b.
+	auto       ata = mtl_ata_translation::translate(logic::finally(b), {AP{"a"}, AP{"b"}});
+	TreeSearch search{&ta, &ata, {}, {"a", "b"}, 1};
+	search.build_tree(false);
+	const auto &root    = *search.get_root();
+	const auto &actions = ta.get_alphabet();
+
+	CHECK(!search::is_controllable(root, actions, {}));
+	CHECK(!search::is_controllable(root, actions, {"a"}));
+	CHECK(search::is_controllable(root, actions, {"b"}));
+	CHECK(search::is_controllable(root, actions, {"a", "b"}));
+	for (const bool multi_threaded : {false, true}) {
+		const std::vector<std::set<std::string>> partitions{{}, {"a"}, {"b"}, {"a", "b"}};
+		CHECK(search::get_controllable_partitions(root, actions, partitions, multi_threaded)
+		      == std::vector<bool>{false, false, true, true});
+	}
+	CHECK(search::find_minimal_controller_actions(root, actions)
+	      == std::optional<std::set<std::string>>{{"b"}});
+	CHECK(search::find_minimal_controller_actions(root, actions, {"a"})
+	      == std::optional<std::set<std::string>>{{"a", "b"}});
+	CHECK_THROWS_AS(search::find_minimal_controller_actions(root, actions, {"c"}),
+	                std::invalid_argument);
+	// The tree is not modified by the analysis.
+	CHECK(root.label == NodeLabel::UNLABELED);
+}
+
+TEST_CASE("Partition labels agree with the tree labels", "[search][partitions]")
+{
+	TA ta{{"a", "b"}, Location{"l0"}, {Location{"l0"}, Location{"l1"}, Location{"l2"}}};
+	ta.add_clock("x");
+	ta.add_transition(TATransition(Location{"l0"},
+	                               "a",
+	                               Location{"l0"},
+	                               {{"x", AtomicClockConstraintT<std::greater<automata::Time>>(1)}},
+	                               {"x"}));
+	ta.add_transition(TATransition(Location{"l0"},
+	                               "b",
+	                               Location{"l1"},
+	                               {{"x", AtomicClockConstraintT<std::less<automata::Time>>(1)}}));
+	ta.add_transition(TATransition(Location{"l2"}, "b", Location{"l1"}));
+	const logic::MTLFormula<std::string> a{AP("a")};
+	const logic::MTLFormula<std::string> b{AP("b")};
+	const auto spec = a.until(b, logic::TimeInterval{2, BoundType::WEAK, 2, BoundType::INFTY});
+	auto       ata  = mtl_ata_translation::translate(spec, {AP{"a"}, AP{"b"}});
+	for (const auto &controller_actions : std::vector<std::set<std::string>>{{"a"}, {"b"}}) {
+		CAPTURE(controller_actions);
+		const std::set<std::string> environment_actions =
+		  controller_actions.count("a") > 0 ? std::set<std::string>{"b"} : std::set<std::string>{"a"};
+		TreeSearch search{&ta, &ata, controller_actions, environment_actions, 2};
+		search.build_tree(false);
+		search.label();
+		CHECK(search::compute_label(*search.get_root(), controller_actions, environment_actions)
+		      == search.get_root()->label);
+		CHECK(search::is_controllable(*search.get_root(), ta.get_alphabet(), controller_actions)
+		      == (search.get_root()->label == NodeLabel::TOP));
+	}
+}
+
+} // namespace
@@ -32,6 +32,7 @@
 #include "search/search.h"
 #include "search/search_tree.h"
 #include "search/synchronous_product.h"
+#include "search/verify_controller.h"
 #include "visualization/ta_to_graphviz.h"
 #include "visualization/tree_to_graphviz.h"
 
@@ -100,7 +101,14 @@ TEST_CASE("Railroad", "[railroad]")
 	TreeSearch         search{
     &plant, &ata, controller_actions, environment_actions, K, true, true, generate_heuristic()};
 	search.build_tree(true);
-	CHECK(search.get_root()->label == NodeLabel::TOP);
+	REQUIRE(search.get_root()->label == NodeLabel::TOP);
+	const auto controller          = controller_synthesis::create_controller(search.get_root(), K);
+	const auto verification_result = controller_synthesis::verify_controller(
+	  plant, ata, controller, controller_actions, environment_actions, K);
+	INFO("Explored " << verification_result.num_states << " states, found "
+	                 << verification_result.num_bad_states << " bad states and "
+	                 << verification_result.num_uncovered_actions << " uncovered actions");
+	CHECK(verification_result.verified);
 #ifdef HAVE_VISUALIZATION
 	visualization::search_tree_to_graphviz(*search.get_root(), true)
 	  .render_to_file(fmt::format("railroad{}.svg", num_crossings));
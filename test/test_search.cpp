@@ -24,6 +24,7 @@
 
 #include "mtl/MTLFormula.h"
 #include "mtl_ata_translation/translator.h"
+#include "search/ata_analysis.h"
 #include "search/search.h"
 #include "search/search_tree.h"
 #include "search/synchronous_product.h"
@@ -127,10 +128,9 @@ TEST_CASE("Search in an ABConfiguration tree", "[search]")
 			        {{TARegionState{Location{"l0"}, "x", 0}}, {ATARegionState{spec, 5}}})});
 			CHECK(children[0]->incoming_actions
 			      == std::set<std::pair<RegionIndex, std::string>>{{3, "a"}, {4, "a"}, {5, "a"}});
+			// The successor with the ATA sink location is hopeless and therefore dropped.
 			CHECK(children[1]->words
-			      == std::set{CanonicalABWord({{TARegionState{Location{"l1"}, "x", 0}}}),
-			                  CanonicalABWord({{TARegionState{Location{"l1"}, "x", 0},
-			                                    ATARegionState{logic::MTLFormula{AP{"sink"}}, 0}}})});
+			      == std::set{CanonicalABWord({{TARegionState{Location{"l1"}, "x", 0}}})});
 			CHECK(children[1]->incoming_actions
 			      == std::set<std::pair<RegionIndex, std::string>>{{0, "b"}});
 			CHECK(children[2]->words
@@ -572,6 +572,38 @@ TEST_CASE("Search on a specification that gets unsatisfiable", "[search]")
 	CHECK(search.get_root()->label == NodeLabel::TOP);
 }
 
+TEST_CASE("Label nodes that cannot reach a final location", "[search]")
+{
+	// Once the controller moves to l2, the plant can never reach the final location l1.
+	TA ta{{Location{"l0"}, Location{"l1"}, Location{"l2"}},
+	      {"c", "e"},
+	      Location{"l0"},
+	      {Location{"l1"}},
+	      {"x"},
+	      {TATransition(Location{"l0"}, "c", Location{"l2"}),
+	       TATransition(Location{"l0"},
+	                    "e",
+	                    Location{"l1"},
+	                    {{"x", AtomicClockConstraintT<std::greater<automata::Time>>(1)}}),
+	       TATransition(Location{"l2"}, "e", Location{"l2"})}};
+	auto ata = mtl_ata_translation::translate(logic::finally(logic::MTLFormula{AP{"e"}}),
+	                                          {AP{"c"}, AP{"e"}});
+	TreeSearch search{&ta, &ata, {"c"}, {"e"}, 1, true};
+	search.build_tree(false);
+	INFO("Tree:\n" << search::node_to_string(*search.get_root(), true));
+	CHECK(search.get_root()->label == NodeLabel::TOP);
+	const auto &children = search.get_root()->children;
+	const auto  safe_child =
+	  std::find_if(std::begin(children), std::end(children), [](const auto &child) {
+		  return child->incoming_actions.count({0, "c"}) > 0;
+	  });
+	REQUIRE(safe_child != std::end(children));
+	CHECK((*safe_child)->label_reason == search::LabelReason::NO_REACHABLE_FINAL_LOCATION);
+	CHECK((*safe_child)->children.empty());
+	CHECK(search.is_safe_node(safe_child->get()));
+	CHECK(!search.is_safe_node(search.get_root()));
+}
+
 TEST_CASE("Check a node for unsatisfiable ATA configurations", "[search]")
 {
 	using Node = search::SearchTreeNode<std::string, std::string>;
@@ -589,4 +621,104 @@ TEST_CASE("Check a node for unsatisfiable ATA configurations", "[search]")
 	        CanonicalABWord({{TARegionState{Location{"l0"}, "x", 0}, ATARegionState{a, 0}}})}}));
 }
 
+TEST_CASE("Detect hopeless ATA states", "[search]")
+{
+	using Formula = logic::MTLFormula<std::string>;
+	using logic::TimeInterval;
+	using utilities::arithmetic::BoundType;
+	const std::set<AP> alphabet{AP{"a"}, AP{"b"}};
+	const Formula      a{AP{"a"}};
+	const Formula      b{AP{"b"}};
+	const Formula      c{AP{"c"}};
+	const auto         bounded = Formula::TRUE().until(a, TimeInterval(0, 2));
+	const auto         strict =
+	  Formula::TRUE().until(a, TimeInterval(0, BoundType::WEAK, 2, BoundType::STRICT));
+	const auto unbounded = Formula::TRUE().until(a);
+	const auto empty =
+	  Formula::TRUE().until(a, TimeInterval(1, BoundType::STRICT, 1, BoundType::WEAK));
+	// c is not in the alphabet and thus can never be read.
+	const auto    unreadable = Formula::TRUE().until(c);
+	const auto    nested     = Formula::TRUE().until(b && unreadable);
+	const auto    dual       = Formula::FALSE().dual_until(a, TimeInterval(0, 2));
+	const Formula sink{AP{"sink"}};
+
+	CHECK(search::can_reach_accepting_configuration(bounded, alphabet));
+	CHECK(search::can_reach_accepting_configuration(unbounded, alphabet));
+	CHECK(search::can_reach_accepting_configuration(dual, alphabet));
+	CHECK(search::can_reach_accepting_configuration(Formula{AP{"l0"}}, alphabet));
+	CHECK(search::can_reach_accepting_configuration(unreadable, {AP{"a"}, AP{"c"}}));
+	CHECK(!search::can_reach_accepting_configuration(empty, alphabet));
+	CHECK(!search::can_reach_accepting_configuration(unreadable, alphabet));
+	CHECK(!search::can_reach_accepting_configuration(nested, alphabet));
+	CHECK(!search::can_reach_accepting_configuration(sink, alphabet));
+
+	CHECK(!search::is_hopeless(ATARegionState{bounded, 4}, alphabet));
+	CHECK(search::is_hopeless(ATARegionState{bounded, 5}, alphabet));
+	CHECK(!search::is_hopeless(ATARegionState{strict, 3}, alphabet));
+	CHECK(search::is_hopeless(ATARegionState{strict, 4}, alphabet));
+	// The last region that satisfies the upper bound depends on the bound type and on whether the
+	// bound is an integer.
+	const auto weak = [&a](double upper) {
+		return Formula::TRUE().until(a, TimeInterval(0, BoundType::WEAK, upper, BoundType::WEAK));
+	};
+	const auto strict_at = [&a](double upper) {
+		return Formula::TRUE().until(a, TimeInterval(0, BoundType::WEAK, upper, BoundType::STRICT));
+	};
+	CHECK(!search::is_hopeless(ATARegionState{weak(1), 2}, alphabet));
+	CHECK(search::is_hopeless(ATARegionState{weak(1), 3}, alphabet));
+	CHECK(!search::is_hopeless(ATARegionState{strict_at(1), 1}, alphabet));
+	CHECK(search::is_hopeless(ATARegionState{strict_at(1), 2}, alphabet));
+	CHECK(!search::is_hopeless(ATARegionState{weak(1.5), 3}, alphabet));
+	CHECK(search::is_hopeless(ATARegionState{weak(1.5), 4}, alphabet));
+	CHECK(!search::is_hopeless(ATARegionState{strict_at(1.5), 3}, alphabet));
+	CHECK(search::is_hopeless(ATARegionState{strict_at(1.5), 4}, alphabet));
+	CHECK(!search::is_hopeless(ATARegionState{unbounded, 5}, alphabet));
+	CHECK(!search::is_hopeless(ATARegionState{dual, 5}, alphabet));
+	CHECK(search::is_hopeless(ATARegionState{unreadable, 0}, alphabet));
+
+	CHECK(!search::is_hopeless(CanonicalABWord({{TARegionState{Location{"l0"}, "x", 0}},
+	                                            {ATARegionState{bounded, 3}}}),
+	                           alphabet));
+	CHECK(search::is_hopeless(
+	  CanonicalABWord({{TARegionState{Location{"l0"}, "x", 0}},
+	                   {ATARegionState{bounded, 3}, ATARegionState{bounded, 5}}}),
+	  alphabet));
+}
+
+TEST_CASE("Label nodes whose ATA configurations are hopeless", "[search]")
+{
+	// After c, the environment may only do e once more than one time unit has passed, so the
+	// specification can no longer be satisfied.
+	TA ta{{Location{"l0"}, Location{"l1"}},
+	      {"c", "e"},
+	      Location{"l0"},
+	      {Location{"l0"}, Location{"l1"}},
+	      {"x"},
+	      {TATransition(Location{"l0"}, "c", Location{"l1"}, {}, {"x"}),
+	       TATransition(Location{"l1"},
+	                    "e",
+	                    Location{"l1"},
+	                    {{"x", AtomicClockConstraintT<std::greater<automata::Time>>(1)}})}};
+	auto ata = mtl_ata_translation::translate(
+	  logic::finally(logic::MTLFormula{AP{"e"}}, logic::TimeInterval(0, 1)), {AP{"c"}, AP{"e"}});
+	TreeSearch search{&ta, &ata, {"c"}, {"e"}, 1, true};
+	search.build_tree(false);
+	INFO("Tree:\n" << search::node_to_string(*search.get_root(), true));
+	CHECK(search.get_root()->label == NodeLabel::TOP);
+	bool found_hopeless_node = false;
+	for (auto &node : *search.get_root()) {
+		// Nodes only contain hopeless words if all their words are hopeless.
+		if (search.is_hopeless_node(&node)) {
+			found_hopeless_node = true;
+			CHECK(node.label_reason == search::LabelReason::NO_ATA_SUCCESSOR);
+			CHECK(node.children.empty());
+		} else {
+			for (const auto &word : node.words) {
+				CHECK(!search::is_hopeless(word, ata.get_alphabet()));
+			}
+		}
+	}
+	CHECK(found_hopeless_node);
+}
+
 } // namespace
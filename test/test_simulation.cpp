@@ -0,0 +1,135 @@
+/***************************************************************************
+ *  test_simulation.cpp - Test the Monte Carlo simulation of controllers
+ *
+ *  Created:   Sun 18 Oct 16:05:12 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "automata/ta.h"
+#include "controller_example.h"
+#include "controller_synthesis/simulation.h"
+#include "mtl/MTLFormula.h"
+#include "mtl_ata_translation/monitor.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+using TA         = automata::ta::TimedAutomaton<std::string, std::string>;
+using Transition = automata::ta::Transition<std::string, std::string>;
+using Location   = automata::ta::Location<std::string>;
+using F          = logic::MTLFormula<std::string>;
+using AP         = logic::AtomicProposition<std::string>;
+using automata::AtomicClockConstraintT;
+using automata::Time;
+using controller_synthesis::ActionId;
+
+ActionId
+get_action_id(const controller_synthesis::SimulationSystem &system, const std::string &action)
+{
+	return static_cast<ActionId>(
+	  std::distance(std::begin(system.actions),
+	                std::find(std::begin(system.actions), std::end(system.actions), action)));
+}
+
+TEST_CASE("Simulate the example plant", "[controller][simulation]")
+{
+	const auto plant   = create_example_plant();
+	const auto monitor = mtl_ata_translation::translate_to_monitor(
+	  logic::finally(F{AP{"fail"}}), {AP{"start"}, AP{"finish"}, AP{"fail"}});
+	auto system =
+	  controller_synthesis::create_simulation_system(plant, get_example_controller_actions());
+	controller_synthesis::add_simulation_monitor(&system, monitor);
+	CHECK(system.clocks == std::vector<std::string>{"x", "monitor"});
+	controller_synthesis::SimulationOptions options;
+	options.num_runs = 500;
+
+	SECTION("Without controller, the plant eventually fails")
+	{
+		const auto statistics = controller_synthesis::simulate(system, options);
+		CHECK(statistics.num_runs == 500);
+		CHECK(statistics.num_violations > 0);
+		CHECK(statistics.num_uncovered_actions == 0);
+		CHECK(statistics.action_counts[get_action_id(system, "fail")] >= statistics.num_violations);
+		// The plant can only fail if x > 1, i.e., after at least 3 ticks.
+		REQUIRE(statistics.min_violation_time);
+		CHECK(*statistics.min_violation_time >= 3);
+		CHECK(*statistics.mean_violation_time >= *statistics.min_violation_time);
+		CHECK(*statistics.max_violation_time <= options.time_horizon);
+		// The same seed results in the same executions.
+		const auto repeated = controller_synthesis::simulate(system, options);
+		CHECK(repeated.num_violations == statistics.num_violations);
+		CHECK(repeated.num_steps == statistics.num_steps);
+		CHECK(repeated.action_counts == statistics.action_counts);
+	}
+
+	SECTION("The synthesized controller prevents all failures")
+	{
+		controller_synthesis::add_simulation_controller(&system, create_example_controller());
+		const auto statistics = controller_synthesis::simulate(system, options);
+		CHECK(statistics.num_violations == 0);
+		CHECK(statistics.num_uncovered_actions == 0);
+		CHECK(!statistics.min_violation_time);
+		CHECK(statistics.get_violation_rate() == 0);
+		CHECK(statistics.action_counts[get_action_id(system, "fail")] == 0);
+		// The controller starts the machine twice and then reaches a leaf of the search tree.
+		CHECK(statistics.num_controller_leaves == options.num_runs);
+		CHECK(statistics.action_counts[get_action_id(system, "start")] == 2 * options.num_runs);
+		CHECK(statistics.action_counts[get_action_id(system, "finish")] == options.num_runs);
+	}
+
+	SECTION("Actions that the controller does not handle are detected")
+	{
+		TA idle_controller{{"start", "finish", "fail"}, Location{"c0"}, {Location{"c0"}}};
+		idle_controller.add_clock("x");
+		idle_controller.add_transition(Transition{Location{"c0"}, "finish", Location{"c0"}});
+		controller_synthesis::add_simulation_controller(&system, idle_controller);
+		const auto statistics = controller_synthesis::simulate(system, options);
+		CHECK(statistics.num_violations == 0);
+		CHECK(statistics.num_uncovered_actions == options.num_runs);
+		CHECK(statistics.action_counts[get_action_id(system, "start")] == 0);
+	}
+
+	SECTION("A violation by the action into a controller leaf is detected")
+	{
+		// The first action is never a violation, so start the machine once before it may fail.
+		TA passive_controller{{"start", "finish", "fail"}, Location{"c0"}, {Location{"c3"}}};
+		passive_controller.add_location(Location{"c1"});
+		passive_controller.add_location(Location{"c2"});
+		passive_controller.add_location(Location{"c3"});
+		passive_controller.add_transition(Transition{Location{"c0"}, "start", Location{"c1"}});
+		passive_controller.add_transition(Transition{Location{"c1"}, "finish", Location{"c2"}});
+		passive_controller.add_transition(Transition{Location{"c2"}, "fail", Location{"c3"}});
+		controller_synthesis::add_simulation_controller(&system, passive_controller);
+		const auto statistics = controller_synthesis::simulate(system, options);
+		CHECK(statistics.num_controller_leaves == options.num_runs);
+		CHECK(statistics.num_violations == options.num_runs);
+	}
+
+	SECTION("The controller must only use clocks of the plant")
+	{
+		TA controller{{"start"}, Location{"c0"}, {Location{"c0"}}};
+		controller.add_clock("y");
+		controller.add_transition(
+		  Transition{Location{"c0"},
+		             "start",
+		             Location{"c0"},
+		             {{"y", AtomicClockConstraintT<std::less<Time>>(1)}}});
+		CHECK_THROWS_AS(controller_synthesis::add_simulation_controller(&system, controller),
+		                std::invalid_argument);
+	}
+}
+
+} // namespace
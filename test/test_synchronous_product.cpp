@@ -107,6 +107,42 @@ TEST_CASE("Get a canonical word of a more complex state", "[canonical_word]")
 	}
 }
 
+TEST_CASE("ATA states saturate at the bounds of their own location", "[canonical_word]")
+{
+	using utilities::arithmetic::BoundType;
+	const logic::MTLFormula a{logic::AtomicProposition<std::string>{"a"}};
+	const logic::MTLFormula b{logic::AtomicProposition<std::string>{"b"}};
+	const auto until = a.until(b, logic::TimeInterval{0, BoundType::WEAK, 1, BoundType::WEAK});
+	const automata::ta::Configuration<std::string> ta_configuration{Location{"s"}, {{"c", 0.2}}};
+	const auto w1 = get_canonical_word<std::string, std::string>(ta_configuration,
+	                                                             {{until, 1.3}},
+	                                                             5);
+	const auto w2 = get_canonical_word<std::string, std::string>(ta_configuration,
+	                                                             {{until, 3.7}},
+	                                                             5);
+	// Both clock values are beyond the bound of the until, thus the two words are the same.
+	CHECK(w1 == w2);
+	CHECK(w1
+	      == CanonicalABWord{{TARegionState{Location{"s"}, "c", 1}}, {ATARegionState{until, 3}}});
+	// An ATA state in a location without interval still saturates at the global bound.
+	CHECK(get_canonical_word<std::string, std::string>(ta_configuration, {{a, 1.3}}, 5)
+	      != get_canonical_word<std::string, std::string>(ta_configuration, {{a, 3.7}}, 5));
+	// The time successors of the TA clock do not change the saturated ATA state.
+	CHECK(get_time_successor(w1, 5)
+	      == CanonicalABWord{{TARegionState{Location{"s"}, "c", 2}}, {ATARegionState{until, 3}}});
+	CHECK(get_nth_time_successor(w1, 20, 5)
+	      == CanonicalABWord{{TARegionState{Location{"s"}, "c", 11}, ATARegionState{until, 3}}});
+	// An unsaturated ATA state is incremented up to its own bound.
+	const auto w3 =
+	  get_canonical_word<std::string, std::string>(ta_configuration, {{until, 0.5}}, 5);
+	CHECK(w3
+	      == CanonicalABWord{{TARegionState{Location{"s"}, "c", 1}}, {ATARegionState{until, 1}}});
+	CHECK(get_nth_time_successor(w3, 1, 5)
+	      == CanonicalABWord{{ATARegionState{until, 2}}, {TARegionState{Location{"s"}, "c", 1}}});
+	CHECK(get_nth_time_successor(w3, 2, 5)
+	      == CanonicalABWord{{TARegionState{Location{"s"}, "c", 2}}, {ATARegionState{until, 3}}});
+}
+
 TEST_CASE("Canonical words with approximately equal fractional parts", "[canonical_word]")
 {
 	const logic::MTLFormula a{logic::AtomicProposition<std::string>{"a"}};
@@ -0,0 +1,234 @@
+/***************************************************************************
+ *  test_ta_minimization.cpp - Test the minimization of timed automata
+ *
+ *  Created:   Sun 18 Oct 14:41:37 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "automata/automata.h"
+#include "automata/ta.h"
+#include "automata/ta_minimization.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace {
+
+using TA         = automata::ta::TimedAutomaton<std::string, std::string>;
+using Transition = automata::ta::Transition<std::string, std::string>;
+using Location   = automata::ta::Location<std::string>;
+using automata::AtomicClockConstraintT;
+using automata::Time;
+using automata::ta::coalesce_guards;
+using automata::ta::minimize;
+using automata::ta::remove_unreachable_locations;
+
+TEST_CASE("Coalesce adjacent guards", "[ta][minimization]")
+{
+	TA ta{{"a", "b"}, Location{"l0"}, {Location{"l1"}}};
+	ta.add_clock("x");
+	ta.add_clock("y");
+	ta.add_transition(Transition{Location{"l0"},
+	                             "a",
+	                             Location{"l1"},
+	                             {{"x", AtomicClockConstraintT<std::less<Time>>(1)}}});
+	ta.add_transition(Transition{Location{"l0"},
+	                             "a",
+	                             Location{"l1"},
+	                             {{"x", AtomicClockConstraintT<std::equal_to<Time>>(1)}}});
+	ta.add_transition(Transition{Location{"l0"},
+	                             "a",
+	                             Location{"l1"},
+	                             {{"x", AtomicClockConstraintT<std::greater<Time>>(1)},
+	                              {"x", AtomicClockConstraintT<std::less<Time>>(2)}}});
+	// A different reset, thus cannot be merged.
+	ta.add_transition(Transition{Location{"l0"},
+	                             "a",
+	                             Location{"l1"},
+	                             {{"x", AtomicClockConstraintT<std::greater_equal<Time>>(2)}},
+	                             {"x"}});
+	// Separated by a gap of x = 1.
+	ta.add_transition(Transition{Location{"l1"},
+	                             "b",
+	                             Location{"l1"},
+	                             {{"x", AtomicClockConstraintT<std::less<Time>>(1)}}});
+	ta.add_transition(Transition{Location{"l1"},
+	                             "b",
+	                             Location{"l1"},
+	                             {{"x", AtomicClockConstraintT<std::greater<Time>>(1)}}});
+	// Different in two clocks.
+	ta.add_transition(Transition{Location{"l1"},
+	                             "a",
+	                             Location{"l0"},
+	                             {{"x", AtomicClockConstraintT<std::less<Time>>(1)},
+	                              {"y", AtomicClockConstraintT<std::less<Time>>(1)}}});
+	ta.add_transition(Transition{Location{"l1"},
+	                             "a",
+	                             Location{"l0"},
+	                             {{"x", AtomicClockConstraintT<std::greater_equal<Time>>(1)},
+	                              {"y", AtomicClockConstraintT<std::greater_equal<Time>>(1)}}});
+	// Subsumed by the previous transition.
+	ta.add_transition(Transition{Location{"l1"},
+	                             "a",
+	                             Location{"l0"},
+	                             {{"x", AtomicClockConstraintT<std::greater_equal<Time>>(2)},
+	                              {"y", AtomicClockConstraintT<std::equal_to<Time>>(3)}}});
+	// Never enabled.
+	ta.add_transition(Transition{Location{"l0"},
+	                             "b",
+	                             Location{"l0"},
+	                             {{"x", AtomicClockConstraintT<std::greater<Time>>(1)},
+	                              {"x", AtomicClockConstraintT<std::less<Time>>(1)}}});
+	const auto coalesced = coalesce_guards(ta);
+	CHECK(coalesced.get_locations() == ta.get_locations());
+	CHECK(coalesced.get_transitions()
+	      == std::multimap<Location, Transition>{
+	        {Location{"l0"},
+	         Transition{Location{"l0"},
+	                    "a",
+	                    Location{"l1"},
+	                    {{"x", AtomicClockConstraintT<std::less<Time>>(2)}}}},
+	        {Location{"l0"},
+	         Transition{Location{"l0"},
+	                    "a",
+	                    Location{"l1"},
+	                    {{"x", AtomicClockConstraintT<std::greater_equal<Time>>(2)}},
+	                    {"x"}}},
+	        {Location{"l1"},
+	         Transition{Location{"l1"},
+	                    "a",
+	                    Location{"l0"},
+	                    {{"x", AtomicClockConstraintT<std::less<Time>>(1)},
+	                     {"y", AtomicClockConstraintT<std::less<Time>>(1)}}}},
+	        {Location{"l1"},
+	         Transition{Location{"l1"},
+	                    "a",
+	                    Location{"l0"},
+	                    {{"x", AtomicClockConstraintT<std::greater_equal<Time>>(1)},
+	                     {"y", AtomicClockConstraintT<std::greater_equal<Time>>(1)}}}},
+	        {Location{"l1"},
+	         Transition{Location{"l1"},
+	                    "b",
+	                    Location{"l1"},
+	                    {{"x", AtomicClockConstraintT<std::less<Time>>(1)}}}},
+	        {Location{"l1"},
+	         Transition{Location{"l1"},
+	                    "b",
+	                    Location{"l1"},
+	                    {{"x", AtomicClockConstraintT<std::greater<Time>>(1)}}}}});
+}
+
+TEST_CASE("Remove unreachable locations", "[ta][minimization]")
+{
+	TA ta{{"a", "b"}, Location{"l0"}, {Location{"l1"}, Location{"l3"}}};
+	ta.add_locations({Location{"l2"}, Location{"l4"}});
+	ta.add_clock("x");
+	ta.add_transition(Transition{Location{"l0"}, "a", Location{"l1"}});
+	// The guard is unsatisfiable, so l2 and l3 are unreachable.
+	ta.add_transition(Transition{Location{"l0"},
+	                             "b",
+	                             Location{"l2"},
+	                             {{"x", AtomicClockConstraintT<std::less<Time>>(1)},
+	                              {"x", AtomicClockConstraintT<std::greater<Time>>(2)}}});
+	ta.add_transition(Transition{Location{"l2"}, "a", Location{"l3"}});
+	// l4 has no incoming transition.
+	ta.add_transition(Transition{Location{"l4"}, "a", Location{"l1"}});
+	const auto reduced = remove_unreachable_locations(ta);
+	CAPTURE(reduced);
+	CHECK(reduced.get_locations() == std::set{Location{"l0"}, Location{"l1"}});
+	CHECK(reduced.get_final_locations() == std::set{Location{"l1"}});
+	CHECK(reduced.get_initial_location() == Location{"l0"});
+	CHECK(reduced.get_clocks() == std::set<std::string>{"x"});
+	CHECK(reduced.get_transitions()
+	      == std::multimap<Location, Transition>{
+	        {Location{"l0"}, Transition{Location{"l0"}, "a", Location{"l1"}}}});
+	CHECK(reduced.accepts_word({{"a", 0}}));
+	CHECK(!reduced.accepts_word({{"b", 1}, {"a", 2}}));
+}
+
+TEST_CASE("Minimize a timed automaton by bisimulation", "[ta][minimization]")
+{
+	TA ta{{"a", "b", "c"}, Location{"l0"}, {Location{"l3"}, Location{"l4"}}};
+	ta.add_locations({Location{"l1"}, Location{"l2"}});
+	ta.add_clock("x");
+	ta.add_clock("y");
+	ta.add_transition(Transition{Location{"l0"},
+	                             "a",
+	                             Location{"l1"},
+	                             {{"x", AtomicClockConstraintT<std::less<Time>>(1)}}});
+	ta.add_transition(Transition{Location{"l0"},
+	                             "a",
+	                             Location{"l2"},
+	                             {{"x", AtomicClockConstraintT<std::greater_equal<Time>>(1)}}});
+	ta.add_transition(Transition{Location{"l1"},
+	                             "b",
+	                             Location{"l3"},
+	                             {{"y", AtomicClockConstraintT<std::greater<Time>>(1)}},
+	                             {"x"}});
+	ta.add_transition(Transition{Location{"l2"},
+	                             "b",
+	                             Location{"l4"},
+	                             {{"y", AtomicClockConstraintT<std::greater<Time>>(1)}},
+	                             {"x"}});
+	ta.add_transition(Transition{Location{"l3"},
+	                             "c",
+	                             Location{"l3"},
+	                             {{"x", AtomicClockConstraintT<std::less_equal<Time>>(2)}}});
+	ta.add_transition(Transition{Location{"l4"},
+	                             "c",
+	                             Location{"l4"},
+	                             {{"x", AtomicClockConstraintT<std::less_equal<Time>>(2)}}});
+	// l1 is not bisimilar to l2 if l2 can also read a.
+	const bool distinguish = GENERATE(false, true);
+	if (distinguish) {
+		ta.add_transition(Transition{Location{"l2"}, "a", Location{"l2"}});
+	}
+	const auto minimized = minimize(ta);
+	CAPTURE(minimized);
+	if (distinguish) {
+		CHECK(minimized.get_locations()
+		      == std::set{Location{"l0"}, Location{"l1"}, Location{"l2"}, Location{"l3"}});
+		CHECK(minimized.get_transitions().size() == 6);
+	} else {
+		CHECK(minimized.get_locations() == std::set{Location{"l0"}, Location{"l1"}, Location{"l3"}});
+		CHECK(minimized.get_final_locations() == std::set{Location{"l3"}});
+		CHECK(minimized.get_transitions()
+		      == std::multimap<Location, Transition>{
+		        {Location{"l0"}, Transition{Location{"l0"}, "a", Location{"l1"}}},
+		        {Location{"l1"},
+		         Transition{Location{"l1"},
+		                    "b",
+		                    Location{"l3"},
+		                    {{"y", AtomicClockConstraintT<std::greater<Time>>(1)}},
+		                    {"x"}}},
+		        {Location{"l3"},
+		         Transition{Location{"l3"},
+		                    "c",
+		                    Location{"l3"},
+		                    {{"x", AtomicClockConstraintT<std::less_equal<Time>>(2)}}}}});
+	}
+	CHECK(minimized.get_initial_location() == Location{"l0"});
+	for (const auto &word : std::vector<automata::TimedWord>{{{"a", 0}, {"b", 2}},
+	                                                         {{"a", 1}, {"b", 2}},
+	                                                         {{"a", 1}, {"b", 2}, {"c", 4}},
+	                                                         {{"a", 1}, {"b", 2}, {"c", 5}},
+	                                                         {{"a", 0}, {"b", 0.5}},
+	                                                         {{"a", 1}, {"a", 1}, {"b", 2}},
+	                                                         {{"a", 0}, {"c", 1}}}) {
+		CHECK(minimized.accepts_word(word) == ta.accepts_word(word));
+	}
+}
+
+} // namespace
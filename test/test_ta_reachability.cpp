@@ -0,0 +1,67 @@
+/***************************************************************************
+ *  test_ta_reachability.cpp - Test the reachability analysis of TAs
+ *
+ *  Created:   Sun 18 Oct 23:05:41 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "automata/ta.h"
+#include "automata/ta_reachability.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+using TA         = automata::ta::TimedAutomaton<std::string, std::string>;
+using Transition = automata::ta::Transition<std::string, std::string>;
+using Location   = automata::ta::Location<std::string>;
+using automata::AtomicClockConstraintT;
+using automata::Time;
+
+TEST_CASE("Compute the reachable and coreachable locations of a TA", "[ta][reachability]")
+{
+	// l0 -> l1 -> l2 (final), l1 -> l3, l0 -> l4 only with an unsatisfiable guard, l4 -> l2.
+	TA ta{{"a", "b"}, Location{"l0"}, {Location{"l2"}}};
+	ta.add_locations({Location{"l1"}, Location{"l3"}, Location{"l4"}, Location{"l5"}});
+	ta.add_clock("x");
+	ta.add_transition(Transition{Location{"l0"}, "a", Location{"l1"}});
+	ta.add_transition(Transition{Location{"l1"}, "a", Location{"l2"}});
+	ta.add_transition(Transition{Location{"l1"}, "b", Location{"l3"}});
+	ta.add_transition(Transition{Location{"l3"}, "b", Location{"l3"}});
+	const Transition unsatisfiable{Location{"l0"},
+	                               "b",
+	                               Location{"l4"},
+	                               {{"x", AtomicClockConstraintT<std::less<Time>>(1)},
+	                                {"x", AtomicClockConstraintT<std::greater<Time>>(2)}}};
+	ta.add_transition(unsatisfiable);
+	ta.add_transition(Transition{Location{"l4"}, "a", Location{"l2"}});
+	ta.add_transition(Transition{Location{"l5"}, "a", Location{"l2"}});
+
+	CHECK(!automata::ta::has_satisfiable_guard(unsatisfiable));
+	CHECK(automata::ta::has_satisfiable_guard(Transition{Location{"l0"}, "a", Location{"l1"}}));
+
+	CHECK(automata::ta::get_reachable_locations(ta)
+	      == std::set<Location>{Location{"l0"}, Location{"l1"}, Location{"l2"}, Location{"l3"}});
+	CHECK(automata::ta::get_reachable_locations(ta, false)
+	      == std::set<Location>{
+	        Location{"l0"}, Location{"l1"}, Location{"l2"}, Location{"l3"}, Location{"l4"}});
+	CHECK(automata::ta::get_coreachable_locations(ta, ta.get_final_locations())
+	      == std::set<Location>{
+	        Location{"l0"}, Location{"l1"}, Location{"l2"}, Location{"l4"}, Location{"l5"}});
+	CHECK(automata::ta::get_coreachable_locations(ta, {Location{"l3"}})
+	      == std::set<Location>{Location{"l0"}, Location{"l1"}, Location{"l3"}});
+}
+
+} // namespace
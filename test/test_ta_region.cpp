@@ -145,4 +145,35 @@ TEST_CASE("Get clock constraint from region", "[taRegion]")
 	      == std::vector<ClockConstraint>{});
 }
 
+TEST_CASE("Get region intervals from guards", "[taRegion]")
+{
+	using GuardT = std::multimap<std::string, ClockConstraint>;
+	const GuardT guard{{"x", AtomicClockConstraintT<std::greater<Time>>(1)},
+	                   {"x", AtomicClockConstraintT<std::less_equal<Time>>(3)},
+	                   {"y", AtomicClockConstraintT<std::equal_to<Time>>(2)},
+	                   {"z", AtomicClockConstraintT<std::greater_equal<Time>>(1)},
+	                   {"z", AtomicClockConstraintT<std::greater<Time>>(2)}};
+	const auto   intervals = get_region_intervals(guard);
+	CHECK(intervals
+	      == std::map<std::string, RegionInterval>{{"x", RegionInterval{3, 6}},
+	                                               {"y", RegionInterval{4, 4}},
+	                                               {"z", RegionInterval{5, std::nullopt}}});
+	CHECK(get_guard_from_region_intervals(intervals)
+	      == GuardT{{"x", AtomicClockConstraintT<std::greater<Time>>(1)},
+	                {"x", AtomicClockConstraintT<std::less_equal<Time>>(3)},
+	                {"y", AtomicClockConstraintT<std::equal_to<Time>>(2)},
+	                {"z", AtomicClockConstraintT<std::greater<Time>>(2)}});
+	CHECK(get_region_intervals({{"x", AtomicClockConstraintT<std::less<Time>>(2)}}).at("x")
+	      == RegionInterval{0, 3});
+	CHECK(
+	  is_empty(get_region_intervals({{"x", AtomicClockConstraintT<std::less<Time>>(0)}}).at("x")));
+	CHECK(is_empty(get_region_intervals({{"x", AtomicClockConstraintT<std::less<Time>>(2)},
+	                                     {"x", AtomicClockConstraintT<std::greater<Time>>(2)}})
+	                 .at("x")));
+	CHECK(!is_empty(RegionInterval{3, std::nullopt}));
+	CHECK_THROWS_AS(
+	  get_region_intervals({{"x", AtomicClockConstraintT<std::not_equal_to<Time>>(1)}}),
+	  std::invalid_argument);
+}
+
 } // namespace
@@ -0,0 +1,125 @@
+/***************************************************************************
+ *  test_ta_slicing.cpp - Test the cone-of-influence slicing of TAs
+ *
+ *  Created:   Sun 18 Oct 23:41:05 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "automata/automata.h"
+#include "automata/ta.h"
+#include "automata/ta_slicing.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+using TA         = automata::ta::TimedAutomaton<std::string, std::string>;
+using Transition = automata::ta::Transition<std::string, std::string>;
+using Location   = automata::ta::Location<std::string>;
+using automata::AtomicClockConstraintT;
+using automata::Time;
+
+TEST_CASE("Slice a timed automaton", "[ta][slicing]")
+{
+	TA ta{{"a", "b", "c", "d"}, Location{"l0"}, {Location{"l1"}}};
+	ta.add_locations({Location{"l2"}});
+	ta.add_clock("x");
+	ta.add_clock("y");
+	ta.add_clock("z");
+	ta.add_transition(Transition{Location{"l0"},
+	                             "a",
+	                             Location{"l1"},
+	                             {{"x", AtomicClockConstraintT<std::greater<Time>>(1)}},
+	                             {"y"}});
+	ta.add_transition(Transition{Location{"l1"}, "b", Location{"l0"}, {}, {"x", "y"}});
+	// l2 is unreachable, so c never occurs and z is never compared.
+	ta.add_transition(Transition{Location{"l2"},
+	                             "c",
+	                             Location{"l0"},
+	                             {{"z", AtomicClockConstraintT<std::less<Time>>(1)}}});
+
+	CHECK(automata::ta::get_constrained_clocks(ta) == std::set<std::string>{"x", "z"});
+	CHECK(automata::ta::get_enabled_actions(ta) == std::set<std::string>{"a", "b"});
+	CHECK(!automata::ta::is_inert(ta));
+
+	const auto sliced = automata::ta::slice(ta);
+	CAPTURE(sliced);
+	CHECK(sliced.get_locations() == std::set{Location{"l0"}, Location{"l1"}});
+	CHECK(sliced.get_clocks() == std::set<std::string>{"x"});
+	CHECK(sliced.get_alphabet() == std::set<std::string>{"a", "b"});
+	CHECK(sliced.get_transitions()
+	      == std::multimap<Location, Transition>{
+	        {Location{"l0"},
+	         Transition{Location{"l0"},
+	                    "a",
+	                    Location{"l1"},
+	                    {{"x", AtomicClockConstraintT<std::greater<Time>>(1)}}}},
+	        {Location{"l1"}, Transition{Location{"l1"}, "b", Location{"l0"}, {}, {"x"}}}});
+	CHECK(sliced.accepts_word({{"a", 2}}));
+	CHECK(!sliced.accepts_word({{"a", 1}}));
+	CHECK(sliced.accepts_word({{"a", 2}, {"b", 2}, {"a", 3.5}}));
+	CHECK(!sliced.accepts_word({{"a", 2}, {"b", 2}, {"a", 3}}));
+}
+
+TEST_CASE("Restrict the clocks of a timed automaton", "[ta][slicing]")
+{
+	TA ta{{"a"}, Location{"l0"}, {Location{"l0"}}};
+	ta.add_clock("x");
+	ta.add_clock("y");
+	ta.add_transition(Transition{Location{"l0"},
+	                             "a",
+	                             Location{"l0"},
+	                             {{"x", AtomicClockConstraintT<std::greater<Time>>(1)},
+	                              {"y", AtomicClockConstraintT<std::less<Time>>(2)}},
+	                             {"x", "y"}});
+	const auto only_y = automata::ta::restrict_clocks(ta, {"y"});
+	CHECK(only_y.get_clocks() == std::set<std::string>{"y"});
+	CHECK(only_y.get_transitions()
+	      == std::multimap<Location, Transition>{
+	        {Location{"l0"},
+	         Transition{Location{"l0"},
+	                    "a",
+	                    Location{"l0"},
+	                    {{"y", AtomicClockConstraintT<std::less<Time>>(2)}},
+	                    {"y"}}}});
+	// A TA needs at least one clock.
+	const auto no_clocks = automata::ta::restrict_clocks(ta, {});
+	CHECK(no_clocks.get_clocks().size() == 1);
+	CHECK(no_clocks.get_transitions()
+	      == std::multimap<Location, Transition>{
+	        {Location{"l0"}, Transition{Location{"l0"}, "a", Location{"l0"}}}});
+}
+
+TEST_CASE("Detect inert timed automata", "[ta][slicing]")
+{
+	TA ta{{"a"}, Location{"l0"}, {Location{"l0"}}};
+	ta.add_locations({Location{"l1"}});
+	ta.add_clock("x");
+	CHECK(automata::ta::is_inert(ta));
+	// The transition can never be taken.
+	ta.add_transition(Transition{Location{"l0"},
+	                             "a",
+	                             Location{"l1"},
+	                             {{"x", AtomicClockConstraintT<std::less<Time>>(1)},
+	                              {"x", AtomicClockConstraintT<std::greater<Time>>(1)}}});
+	CHECK(automata::ta::is_inert(ta));
+	ta.add_transition(Transition{Location{"l0"}, "a", Location{"l1"}});
+	CHECK(!automata::ta::is_inert(ta));
+	TA non_accepting{{"a"}, Location{"l0"}, {}};
+	non_accepting.add_clock("x");
+	CHECK(!automata::ta::is_inert(non_accepting));
+}
+
+} // namespace
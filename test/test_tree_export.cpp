@@ -0,0 +1,203 @@
+/***************************************************************************
+ *  test_tree_export.cpp - Test the binary export of the search tree
+ *
+ *  Created:   Mon 19 Oct 02:14:09 CEST 2026
+ *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ ****************************************************************************/
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.md file.
+ */
+
+#include "mtl/MTLFormula.h"
+#include "mtl_ata_translation/translator.h"
+#include "search/search.h"
+#include "search/tree_export.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <sstream>
+
+namespace {
+
+using TreeSearch   = search::TreeSearch<std::string, std::string>;
+using TATransition = automata::ta::Transition<std::string, std::string>;
+using TA           = automata::ta::TimedAutomaton<std::string, std::string>;
+using AP           = logic::AtomicProposition<std::string>;
+using Location     = automata::ta::Location<std::string>;
+using Writer       = search::TreeExportWriter<std::string, std::string>;
+using automata::AtomicClockConstraintT;
+using search::ExportedLabel;
+using search::ExportedNode;
+using search::NodeLabel;
+using utilities::arithmetic::BoundType;
+
+TA
+create_plant()
+{
+	TA ta{{"a", "b"}, Location{"l0"}, {Location{"l0"}, Location{"l1"}}};
+	ta.add_clock("x");
+	ta.add_transition(TATransition(Location{"l0"},
+	                               "a",
+	                               Location{"l0"},
+	                               {{"x", AtomicClockConstraintT<std::greater<automata::Time>>(1)}},
+	                               {"x"}));
+	ta.add_transition(TATransition(Location{"l0"},
+	                               "b",
+	                               Location{"l1"},
+	                               {{"x", AtomicClockConstraintT<std::less<automata::Time>>(1)}}));
+	return ta;
+}
+
+/** Read all records of an export. */
+std::pair<std::vector<ExportedNode>, std::vector<ExportedLabel>>
+read_export(std::istream &is)
+{
+	search::TreeExportReader   reader{is};
+	std::vector<ExportedNode>  nodes;
+	std::vector<ExportedLabel> labels;
+	while (const auto record = reader.next()) {
+		if (std::holds_alternative<ExportedNode>(*record)) {
+			nodes.push_back(std::get<ExportedNode>(*record));
+		} else {
+			labels.push_back(std::get<ExportedLabel>(*record));
+		}
+	}
+	return {nodes, labels};
+}
+
+TEST_CASE("Export a search tree after the search", "[search][export]")
+{
+	const auto                           ta = create_plant();
+	const logic::MTLFormula<std::string> a{AP("a")};
+	const logic::MTLFormula<std::string> b{AP("b")};
+	auto       ata = mtl_ata_translation::translate(a.until(b), {AP{"a"}, AP{"b"}});
+	TreeSearch search{&ta, &ata, {"a"}, {"b"}, 1};
+	search.build_tree(false);
+	search.label();
+
+	std::stringstream stream;
+	Writer            writer{stream};
+	writer.write_tree(*search.get_root());
+	CHECK(writer.get_num_nodes() == search.get_size());
+	// The labels did not change after the nodes were written.
+	for (const auto &node : *search.get_root()) {
+		CHECK(!writer.write_label(node));
+	}
+
+	const auto [nodes, labels] = read_export(stream);
+	CHECK(labels.empty());
+	REQUIRE(nodes.size() == search.get_size());
+	// The nodes are written in pre-order, so they match the pre-order traversal of the tree.
+	std::size_t i = 0;
+	for (const auto &node : *search.get_root()) {
+		CAPTURE(i);
+		const auto &exported = nodes[i];
+		CHECK(exported.id == i);
+		CHECK(exported.parent.has_value() == (node.parent != nullptr));
+		CHECK(exported.label == node.label);
+		CHECK(exported.state == node.state);
+		CHECK(exported.label_reason == node.label_reason);
+		CHECK(exported.words.size() == node.words.size());
+		CHECK(exported.incoming_actions.size() == node.incoming_actions.size());
+		CHECK(!exported.expansion_time);
+		++i;
+	}
+	// The words are interned by their printed form.
+	std::vector<std::string> root_words;
+	for (const auto &word : search.get_root()->words) {
+		std::stringstream str;
+		str << word;
+		root_words.push_back(str.str());
+	}
+	CHECK(nodes[0].words == root_words);
+}
+
+TEST_CASE("Stream a search tree during the search", "[search][export]")
+{
+	const auto                           ta = create_plant();
+	const logic::MTLFormula<std::string> a{AP("a")};
+	const logic::MTLFormula<std::string> b{AP("b")};
+	auto       ata = mtl_ata_translation::translate(a.until(b), {AP{"a"}, AP{"b"}});
+	TreeSearch search{&ta, &ata, {"a"}, {"b"}, 1, true, false};
+	std::stringstream stream;
+	Writer            writer{stream};
+	search.set_timed_expansion_callback([&writer](const auto *node, auto expansion_time) {
+		writer.write_node(*node, expansion_time);
+	});
+	search.build_tree(true);
+	std::size_t num_written_labels = 0;
+	for (const auto &node : *search.get_root()) {
+		num_written_labels += writer.write_label(node);
+	}
+	// Each label is only written once.
+	for (const auto &node : *search.get_root()) {
+		CHECK(!writer.write_label(node));
+	}
+
+	const auto [nodes, labels] = read_export(stream);
+	CHECK(nodes.size() == search.get_size());
+	CHECK(labels.size() == num_written_labels);
+	CHECK(labels.size() <= search.get_size());
+	std::map<std::uint64_t, ExportedNode> nodes_by_id;
+	for (const auto &node : nodes) {
+		CHECK(node.expansion_time.has_value());
+		CHECK(nodes_by_id.emplace(node.id, node).second);
+	}
+	std::size_t num_roots = 0;
+	for (const auto &[id, node] : nodes_by_id) {
+		if (node.parent) {
+			CHECK(nodes_by_id.count(*node.parent) == 1);
+		} else {
+			++num_roots;
+		}
+	}
+	CHECK(num_roots == 1);
+	// The label records only contain changed labels and result in the final labels of the tree.
+	for (const auto &label : labels) {
+		auto &node = nodes_by_id.at(label.id);
+		CHECK((label.label != node.label || label.label_reason != node.label_reason));
+		node.label        = label.label;
+		node.label_reason = label.label_reason;
+	}
+	for (const auto &[id, node] : nodes_by_id) {
+		if (!node.parent) {
+			CHECK(node.label == search.get_root()->label);
+		}
+	}
+}
+
+TEST_CASE("Read invalid tree exports", "[search][export]")
+{
+	std::stringstream not_an_export{"MTLSYN"};
+	CHECK_THROWS_AS(search::TreeExportReader{not_an_export}, std::invalid_argument);
+	std::stringstream stream;
+	Writer            writer{stream};
+	stream << "X";
+	search::TreeExportReader reader{stream};
+	CHECK_THROWS_AS(reader.next(), std::invalid_argument);
+	// A string whose size exceeds the export is rejected without allocating the size.
+	std::stringstream oversized;
+	Writer            oversized_writer{oversized};
+	oversized.put(search::details::tree_export_string_tag);
+	search::details::write_varint(oversized, 0);
+	search::details::write_varint(oversized, std::uint64_t{1} << 62);
+	oversized << "abc";
+	search::TreeExportReader oversized_reader{oversized};
+	CHECK_THROWS_AS(oversized_reader.next(), std::invalid_argument);
+	std::stringstream truncated;
+	search::details::write_varint(truncated, 300);
+	CHECK(search::details::read_varint(truncated) == 300);
+	truncated.str(std::string(1, '\x80'));
+	CHECK_THROWS_AS(search::details::read_varint(truncated), std::invalid_argument);
+}
+
+} // namespace